@@ -145,4 +145,10 @@ fi
 
 popd >/dev/null
 
+# Client-measured input-to-effect latency (t2d_test_client logs one final histogram summary per client)
+if grep -qh "input_to_effect final" "${LOG_DIR}"/client_*.log 2>/dev/null; then
+	echo "[load] Input-to-effect latency per client:"
+	grep -h "input_to_effect final" "${LOG_DIR}"/client_*.log | sed 's/.*input_to_effect final /  /'
+fi
+
 echo "[load] Logs in ${LOG_DIR}"
@@ -1,4 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
+#include "common/clock_sync.hpp"
+#include "common/compact_input.hpp"
 #include "common/framing.hpp"
 #include "common/logger.hpp"
 #include "game.pb.h"
@@ -8,6 +10,7 @@
 #include <coro/io_scheduler.hpp>
 #include <coro/net/tcp/client.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
@@ -72,6 +75,16 @@ static void log_delta_snapshot(const t2d::DeltaSnapshot &d)
     }
 }
 
+static void log_tick_events(const t2d::TickEvents &ev)
+{
+    for (const auto &d : ev.damage())
+        t2d::log::info("damage victim={} attacker={} hp_left={}", d.victim_id(), d.attacker_id(), d.remaining_hp());
+    for (const auto &td : ev.destroyed())
+        t2d::log::info("tank destroyed victim={} attacker={}", td.victim_id(), td.attacker_id());
+    for (const auto &pu : ev.pickups())
+        t2d::log::debug("ammo pickup box={} entity={} ammo={}", pu.box_id(), pu.entity_id(), pu.ammo());
+}
+
 std::atomic_bool g_shutdown{false};
 
 void handle_sig(int)
@@ -79,12 +92,9 @@ void handle_sig(int)
     g_shutdown.store(true);
 }
 
-coro::task<void> send_frame(coro::net::tcp::client &client, const t2d::ClientMessage &msg)
+coro::task<void> send_payload(coro::net::tcp::client &client, const std::string &payload)
 {
     co_await client.poll(coro::poll_op::write);
-    std::string payload;
-    if (!msg.SerializeToString(&payload))
-        co_return;
     uint32_t len = htonl(static_cast<uint32_t>(payload.size()));
     std::string frame;
     frame.resize(4 + payload.size());
@@ -103,6 +113,32 @@ coro::task<void> send_frame(coro::net::tcp::client &client, const t2d::ClientMes
     }
 }
 
+coro::task<void> send_frame(coro::net::tcp::client &client, const t2d::ClientMessage &msg)
+{
+    std::string payload;
+    if (!msg.SerializeToString(&payload))
+        co_return;
+    co_await send_payload(client, payload);
+}
+
+// Unwraps one frame payload (typed header with optional RLE / fragments, or legacy bare protobuf) into out.
+// Returns 1 = parsed, 0 = fragment buffered (wait for more), -1 = malformed.
+static int parse_server_payload(const std::string &payload, t2d::ServerMessage &out)
+{
+    static t2d::netutil::FrameDecoder decoder; // per-process (single connection prototype)
+    t2d::netutil::FrameType type{};
+    const char *body = nullptr;
+    size_t len = 0;
+    auto st = decoder.decode(payload.data(), payload.size(), type, body, len);
+    if (st == t2d::netutil::FrameStatus::Partial)
+        return 0;
+    if (st == t2d::netutil::FrameStatus::Error)
+        return -1;
+    if (type != t2d::netutil::FrameType::Legacy && type != t2d::netutil::FrameType::ServerMessage)
+        return 0; // unknown type from a newer server: skip
+    return out.ParseFromArray(body, (int)len) ? 1 : -1;
+}
+
 coro::task<bool> read_one(
     coro::net::tcp::client &client, t2d::ServerMessage &out, std::chrono::milliseconds /*time_left*/)
 {
@@ -120,9 +156,7 @@ coro::task<bool> read_one(
     std::string payload;
     if (!t2d::netutil::try_extract(state, payload))
         co_return false;
-    if (!out.ParseFromArray(payload.data(), (int)payload.size()))
-        co_return false;
-    co_return true;
+    co_return parse_server_payload(payload, out) == 1;
 }
 
 // Coroutine entry; first await binds to scheduler thread per project coroutine policy.
@@ -141,6 +175,8 @@ coro::task<void> run_client(std::shared_ptr<coro::io_scheduler> sched, std::stri
     auto *rq = auth.mutable_auth_request();
     rq->set_oauth_token("desktop_dummy");
     rq->set_client_version(T2D_VERSION);
+    rq->set_compact_input(true);
+    rq->set_frame_version(t2d::netutil::FRAME_VERSION);
     co_await send_frame(cli, auth);
     // Queue join
     t2d::ClientMessage q;
@@ -149,7 +185,15 @@ coro::task<void> run_client(std::shared_ptr<coro::io_scheduler> sched, std::stri
     bool in_match = false;
     uint64_t loop_iter = 0; // still used for synthetic movement phase progression
     std::string session_id;
+    bool compact_input = false; // server accepted compact binary input frames
+    std::string input_payload; // reused compact frame buffer
+    uint32_t frame_version = 0; // negotiated frame header version (0 = legacy frames only)
     uint32_t last_full_tick = 0;
+    uint32_t last_snapshot_tick = 0;
+    // Keyframe gap detection: a delta built on a base we do not hold (or going backwards) asks for a full snapshot.
+    bool keyframe_needed = false;
+    constexpr auto keyframe_request_interval = std::chrono::milliseconds(500);
+    auto last_keyframe_request = std::chrono::steady_clock::time_point{};
     // Time-based scheduling state
     constexpr auto heartbeat_interval = std::chrono::milliseconds(1000);
     constexpr auto input_interval = std::chrono::milliseconds(100); // previously every 5 * 20ms
@@ -157,6 +201,7 @@ coro::task<void> run_client(std::shared_ptr<coro::io_scheduler> sched, std::stri
     auto last_heartbeat = std::chrono::steady_clock::now();
     auto last_input = std::chrono::steady_clock::now();
     uint32_t client_tick_counter = 0;
+    t2d::netutil::ClockSync clock_sync; // heartbeat RTT / offset, reported back on the next heartbeat
     while (!g_shutdown.load()) {
         auto iter_start = std::chrono::steady_clock::now();
         // Heartbeat based on elapsed time
@@ -164,26 +209,56 @@ coro::task<void> run_client(std::shared_ptr<coro::io_scheduler> sched, std::stri
             last_heartbeat = iter_start;
             t2d::ClientMessage hb;
             auto *h = hb.mutable_heartbeat();
-            h->set_session_id(session_id);
+            if (!compact_input)
+                h->set_session_id(session_id); // connection is authenticated; only legacy servers want it
             h->set_time_ms((uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
                                std::chrono::steady_clock::now().time_since_epoch())
                                .count());
-            co_await send_frame(cli, hb);
+            h->set_rtt_us(clock_sync.report_rtt_us());
+            h->set_clock_offset_us(clock_sync.offset_us());
+            h->set_client_send_us(t2d::netutil::steady_us());
+            if (frame_version >= 1) {
+                auto body = hb.heartbeat().SerializeAsString();
+                co_await send_payload(cli, t2d::netutil::typed_payload(t2d::netutil::FrameType::Heartbeat, body));
+            } else {
+                co_await send_frame(cli, hb);
+            }
         }
         // Input (movement + fire pulse) every input_interval while in a match
         if (in_match && (iter_start - last_input >= input_interval)) {
             last_input = iter_start;
-            t2d::ClientMessage in;
-            auto *ic = in.mutable_input();
-            ic->set_session_id(session_id);
-            ic->set_client_tick(client_tick_counter++);
+            t2d::netutil::CompactInput ci;
+            ci.client_tick = client_tick_counter++;
             float phase = static_cast<float>(loop_iter % 360) * 3.14159f / 180.0f;
-            ic->set_move_dir(std::sin(phase));
-            ic->set_turn_dir(std::cos(phase));
-            ic->set_turret_turn(std::sin(phase * 0.5f));
+            ci.move_dir = std::sin(phase);
+            ci.turn_dir = std::cos(phase);
+            ci.turret_turn = std::sin(phase * 0.5f);
             // Fire every 30 input messages ~3s (matches old 150 * 20ms)
-            ic->set_fire((client_tick_counter % 30) == 0);
-            co_await send_frame(cli, in);
+            ci.fire = (client_tick_counter % 30) == 0;
+            if (compact_input) {
+                t2d::netutil::encode_compact_input(ci, input_payload);
+                co_await send_payload(cli, input_payload);
+            } else {
+                t2d::ClientMessage in;
+                auto *ic = in.mutable_input();
+                ic->set_session_id(session_id);
+                ic->set_client_tick(ci.client_tick);
+                ic->set_move_dir(ci.move_dir);
+                ic->set_turn_dir(ci.turn_dir);
+                ic->set_turret_turn(ci.turret_turn);
+                ic->set_fire(ci.fire);
+                co_await send_frame(cli, in);
+            }
+        }
+        if (in_match && keyframe_needed && iter_start - last_keyframe_request >= keyframe_request_interval) {
+            last_keyframe_request = iter_start;
+            keyframe_needed = false;
+            t2d::ClientMessage kr;
+            auto *k = kr.mutable_keyframe_request();
+            k->set_last_full_tick(last_full_tick);
+            k->set_last_server_tick(last_snapshot_tick);
+            co_await send_frame(cli, kr);
+            t2d::log::info("keyframe request last_full={} last_tick={}", last_full_tick, last_snapshot_tick);
         }
         // Remaining time budget for this iteration passed to read_one
         auto after_sends = std::chrono::steady_clock::now();
@@ -200,9 +275,15 @@ coro::task<void> run_client(std::shared_ptr<coro::io_scheduler> sched, std::stri
         if (got) {
             if (sm.has_auth_response()) {
                 t2d::log::info(
-                    "auth success={} session={}", sm.auth_response().success(), sm.auth_response().session_id());
+                    "auth success={} session={} compact_input={} frame_version={}",
+                    sm.auth_response().success(),
+                    sm.auth_response().session_id(),
+                    sm.auth_response().compact_input(),
+                    sm.auth_response().frame_version());
                 if (sm.auth_response().success()) {
                     session_id = sm.auth_response().session_id();
+                    compact_input = sm.auth_response().compact_input();
+                    frame_version = sm.auth_response().frame_version();
                 }
             } else if (sm.has_queue_status()) {
                 t2d::log::info(
@@ -227,9 +308,19 @@ coro::task<void> run_client(std::shared_ptr<coro::io_scheduler> sched, std::stri
                     iteration_budget.count());
             } else if (sm.has_snapshot()) {
                 last_full_tick = sm.snapshot().server_tick();
+                last_snapshot_tick = last_full_tick;
+                keyframe_needed = false;
                 log_full_snapshot(sm.snapshot());
+                log_tick_events(sm.snapshot().events());
             } else if (sm.has_delta_snapshot()) {
+                const auto &d = sm.delta_snapshot();
+                if (d.base_tick() != last_full_tick || d.server_tick() < last_snapshot_tick)
+                    keyframe_needed = true;
+                last_snapshot_tick = std::max(last_snapshot_tick, d.server_tick());
                 log_delta_snapshot(sm.delta_snapshot());
+                log_tick_events(sm.delta_snapshot().events());
+            } else if (sm.has_tick_events()) {
+                log_tick_events(sm.tick_events());
             } else if (sm.has_damage()) {
                 t2d::log::info(
                     "damage victim={} attacker={} hp_left={}",
@@ -243,9 +334,15 @@ coro::task<void> run_client(std::shared_ptr<coro::io_scheduler> sched, std::stri
                 for (const auto &ev : sm.kill_feed().events()) {
                     t2d::log::info("kill feed event victim={} attacker={}", ev.victim_id(), ev.attacker_id());
                 }
+            } else if (sm.has_heartbeat_resp()) {
+                const auto &hr = sm.heartbeat_resp();
+                if (clock_sync.add_sample(
+                        hr.client_send_us(), hr.server_recv_us(), hr.server_send_us(), t2d::netutil::steady_us()))
+                    t2d::log::debug("clock {}", clock_sync.summary());
             } else if (sm.has_match_end()) {
                 t2d::log::info(
                     "match end id={} winner_entity={}", sm.match_end().match_id(), sm.match_end().winner_entity_id());
+                t2d::log::info("clock {}", clock_sync.summary());
             }
         }
         // No local world summary (raw snapshots already logged)
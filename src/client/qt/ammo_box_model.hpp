@@ -2,6 +2,7 @@
 #pragma once
 #include "game.pb.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <QtCore/QAbstractListModel>
@@ -88,6 +89,26 @@ public:
         endResetModel();
     }
 
+    // Activation changes since the delta's base (upsert by box id).
+    void applyDelta(const t2d::DeltaSnapshot &d)
+    {
+        for (auto &b : d.ammo_boxes()) {
+            auto it = std::find_if(
+                rows_.begin(), rows_.end(), [&](const QtAmmoBoxRow &r) { return r.id == b.box_id(); });
+            if (it != rows_.end()) {
+                if (it->active == b.active())
+                    continue;
+                it->active = b.active();
+                auto idx = index((int)(it - rows_.begin()));
+                emit dataChanged(idx, idx, {ActiveRole});
+            } else {
+                beginInsertRows({}, (int)rows_.size(), (int)rows_.size());
+                rows_.push_back({b.box_id(), b.x(), b.y(), b.active()});
+                endInsertRows();
+            }
+        }
+    }
+
 private:
     std::vector<QtAmmoBoxRow> rows_;
 };
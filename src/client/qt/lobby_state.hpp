@@ -13,6 +13,7 @@ class LobbyState : public QObject
     Q_PROPERTY(uint32_t neededForMatch READ neededForMatch NOTIFY queueChanged)
     Q_PROPERTY(uint32_t lobbyCountdown READ lobbyCountdown NOTIFY queueChanged)
     Q_PROPERTY(uint32_t projectedBotFill READ projectedBotFill NOTIFY queueChanged)
+    Q_PROPERTY(uint32_t estimatedWait READ estimatedWait NOTIFY queueChanged)
 
 public:
     explicit LobbyState(QObject *parent = nullptr) : QObject(parent) {}
@@ -29,6 +30,8 @@ public:
 
     uint32_t projectedBotFill() const { return projectedBotFill_; }
 
+    uint32_t estimatedWait() const { return estimatedWait_; }
+
     void updateFromQueue(const t2d::QueueStatusUpdate &qs)
     {
         bool sc = false, qc = false, pc = false;
@@ -41,11 +44,13 @@ public:
             pc = true;
         }
         if (playersInQueue_ != qs.players_in_queue() || neededForMatch_ != qs.needed_for_match()
-            || lobbyCountdown_ != qs.lobby_countdown() || projectedBotFill_ != qs.projected_bot_fill()) {
+            || lobbyCountdown_ != qs.lobby_countdown() || projectedBotFill_ != qs.projected_bot_fill()
+            || estimatedWait_ != qs.estimated_wait_seconds()) {
             playersInQueue_ = qs.players_in_queue();
             neededForMatch_ = qs.needed_for_match();
             lobbyCountdown_ = qs.lobby_countdown();
             projectedBotFill_ = qs.projected_bot_fill();
+            estimatedWait_ = qs.estimated_wait_seconds();
             qc = true;
         }
         if (sc)
@@ -68,4 +73,5 @@ private:
     uint32_t neededForMatch_{0};
     uint32_t lobbyCountdown_{0};
     uint32_t projectedBotFill_{0};
+    uint32_t estimatedWait_{0};
 };
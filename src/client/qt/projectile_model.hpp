@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
+#include "common/projectile_extrapolation.hpp"
 #include "game.pb.h"
 
 #include <unordered_map>
@@ -16,6 +17,7 @@ struct QtProjectileRow
     float prev_y{};
     float vx{}; // authoritative velocity (from snapshot)
     float vy{};
+    t2d::proj::Ballistic sample; // last replicated sample; x/y are extrapolated from it every server tick
 };
 
 class ProjectileModel : public QAbstractListModel
@@ -36,6 +38,9 @@ public:
 
     Q_INVOKABLE int count() const { return (int)rows_.size(); }
 
+    // Seconds per server tick (from MatchStart.tick_rate); used to extrapolate ballistic samples.
+    void setTickDt(float dt) { tickDt_ = dt; }
+
     Q_INVOKABLE float interpX(int row, float alpha) const
     {
         if (row < 0 || (size_t)row >= rows_.size())
@@ -112,8 +117,14 @@ public:
     {
         std::vector<QtProjectileRow> newRows;
         newRows.reserve(snap.projectiles_size());
-        for (const auto &p : snap.projectiles())
-            newRows.push_back(QtProjectileRow{p.projectile_id(), p.x(), p.y(), p.x(), p.y(), p.vx(), p.vy()});
+        for (const auto &p : snap.projectiles()) {
+            QtProjectileRow row{p.projectile_id()};
+            setSample(row, p, snap.server_tick());
+            advance(row, snap.server_tick());
+            row.prev_x = row.x;
+            row.prev_y = row.y;
+            newRows.push_back(row);
+        }
         beginResetModel();
         rows_.swap(newRows);
         index_.clear();
@@ -123,6 +134,8 @@ public:
         endResetModel();
     }
 
+    // Deltas list only spawned / re-sampled projectiles (upsert by id); every other row keeps flying along its last
+    // sample.
     void applyDelta(const t2d::DeltaSnapshot &d)
     {
         std::vector<int> removeIdx;
@@ -146,44 +159,48 @@ public:
             for (int i = 0; i < (int)rows_.size(); ++i)
                 index_.emplace(rows_[i].id, i);
         }
-        std::vector<int> changed;
-        changed.reserve(d.projectiles_size());
+        const uint32_t tick = d.server_tick();
+        const int existing = (int)rows_.size();
         for (const auto &p : d.projectiles()) {
             auto it = index_.find(p.projectile_id());
             if (it != index_.end()) {
-                int i = it->second;
-                auto &row = rows_[i];
+                setSample(rows_[it->second], p, tick);
+            } else {
+                QtProjectileRow row{p.projectile_id()};
+                setSample(row, p, tick);
+                advance(row, tick);
                 row.prev_x = row.x;
                 row.prev_y = row.y;
-                row.x = p.x();
-                row.y = p.y();
-                row.vx = p.vx();
-                row.vy = p.vy();
-                changed.push_back(i);
-            } else {
                 beginInsertRows({}, (int)rows_.size(), (int)rows_.size());
-                rows_.push_back(QtProjectileRow{p.projectile_id(), p.x(), p.y(), p.x(), p.y(), p.vx(), p.vy()});
+                rows_.push_back(row);
                 endInsertRows();
                 index_.emplace(p.projectile_id(), (int)rows_.size() - 1);
             }
         }
-        if (!changed.empty()) {
-            std::sort(changed.begin(), changed.end());
-            int rs = changed.front();
-            int prev = rs;
-            for (size_t k = 1; k < changed.size(); ++k) {
-                int cur = changed[k];
-                if (cur != prev + 1) {
-                    emit dataChanged(index(rs), index(prev));
-                    rs = cur;
-                }
-                prev = cur;
-            }
-            emit dataChanged(index(rs), index(prev));
+        for (int i = 0; i < existing; ++i) {
+            auto &row = rows_[i];
+            row.prev_x = row.x;
+            row.prev_y = row.y;
+            advance(row, tick);
         }
+        if (existing > 0)
+            emit dataChanged(index(0), index(existing - 1));
     }
 
 private:
+    static void setSample(QtProjectileRow &row, const t2d::ProjectileState &p, uint32_t msgTick)
+    {
+        row.sample = {p.x(), p.y(), p.vx(), p.vy(), p.ref_tick() ? p.ref_tick() : msgTick};
+        row.vx = p.vx();
+        row.vy = p.vy();
+    }
+
+    void advance(QtProjectileRow &row, uint32_t tick) const
+    {
+        t2d::proj::extrapolate(row.sample, tick, tickDt_, row.x, row.y);
+    }
+
+    float tickDt_{1.f / 30.f};
     std::vector<QtProjectileRow> rows_;
     std::unordered_map<uint32_t, int> index_;
 };
@@ -1112,6 +1112,13 @@ Window {
                     statsLast.text = "Last: " + timingState.lastFrameMs.toFixed(2) + " ms";
                     statsMax.text = "Max: " + timingState.maxFrameMs.toFixed(2) + " ms";
                     statsLong.text = "Long: " + timingState.longFrameCount;
+                    statsInput.text = timingState.inputLatencySamples > 0
+                        ? "Input: p50 " + timingState.inputLatencyP50Ms.toFixed(0) + " / p99 "
+                          + timingState.inputLatencyP99Ms.toFixed(0) + " ms"
+                        : "Input: --";
+                    statsClock.text = timingState.rttMs > 0
+                        ? "RTT: " + timingState.rttMs.toFixed(1) + " ms (offset " + timingState.clockOffsetMs.toFixed(1) + ")"
+                        : "RTT: --";
                 }
             }
             Row {
@@ -1135,6 +1142,18 @@ Window {
                     font.pixelSize: 12
                     text: "Long: --"
                 }
+                Text {
+                    id: statsInput
+                    color: "#afc9d6"
+                    font.pixelSize: 12
+                    text: "Input: --"
+                }
+                Text {
+                    id: statsClock
+                    color: "#afc9d6"
+                    font.pixelSize: 12
+                    text: "RTT: --"
+                }
                 Button {
                     id: resetStatsBtn
                     text: "Reset"
@@ -1296,6 +1315,9 @@ Window {
                         case 2:
                             s = "Starting Match";
                             break;
+                        case 4:
+                            s = "Waiting for Server Capacity";
+                            break;
                         default:
                             s = "Lobby";
                             break;
@@ -1320,6 +1342,12 @@ Window {
                     font.pixelSize: 13
                     text: lobbyState ? ("Bots to add: " + lobbyState.projectedBotFill) : ""
                 }
+                Text {
+                    visible: lobbyState && lobbyState.state === 4 && lobbyState.estimatedWait > 0
+                    color: "#c7d4df"
+                    font.pixelSize: 14
+                    text: lobbyState ? ("Estimated wait: " + lobbyState.estimatedWait + "s") : ""
+                }
             }
         }
     } // end rootItem
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "ammo_box_model.hpp"
+#include "common/clock_sync.hpp"
+#include "common/compact_input.hpp"
 #include "common/framing.hpp"
 #include "common/logger.hpp"
 #include "crate_model.hpp"
@@ -15,6 +17,7 @@
 #include <coro/net/tcp/client.hpp>
 #include <unistd.h> // getpid for oauth token suffix
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -39,12 +42,9 @@ void handle_sig(int)
     g_shutdown.store(true);
 }
 
-coro::task<void> send_frame(coro::net::tcp::client &client, const t2d::ClientMessage &msg)
+coro::task<void> send_payload(coro::net::tcp::client &client, const std::string &payload)
 {
     co_await client.poll(coro::poll_op::write);
-    std::string payload;
-    if (!msg.SerializeToString(&payload))
-        co_return;
     uint32_t len = htonl(static_cast<uint32_t>(payload.size()));
     std::string frame;
     frame.resize(4 + payload.size());
@@ -63,6 +63,32 @@ coro::task<void> send_frame(coro::net::tcp::client &client, const t2d::ClientMes
     }
 }
 
+coro::task<void> send_frame(coro::net::tcp::client &client, const t2d::ClientMessage &msg)
+{
+    std::string payload;
+    if (!msg.SerializeToString(&payload))
+        co_return;
+    co_await send_payload(client, payload);
+}
+
+// Unwraps one frame payload (typed header with optional RLE / fragments, or legacy bare protobuf) into out.
+// Returns 1 = parsed, 0 = fragment buffered (wait for more), -1 = malformed.
+int parse_server_payload(const std::string &payload, t2d::ServerMessage &out)
+{
+    static t2d::netutil::FrameDecoder decoder; // per-process (single connection prototype)
+    t2d::netutil::FrameType type{};
+    const char *body = nullptr;
+    size_t len = 0;
+    auto st = decoder.decode(payload.data(), payload.size(), type, body, len);
+    if (st == t2d::netutil::FrameStatus::Partial)
+        return 0;
+    if (st == t2d::netutil::FrameStatus::Error)
+        return -1;
+    if (type != t2d::netutil::FrameType::Legacy && type != t2d::netutil::FrameType::ServerMessage)
+        return 0; // unknown type from a newer server: skip
+    return out.ParseFromArray(body, (int)len) ? 1 : -1;
+}
+
 // Attempts to extract one message within the provided time budget; returns
 //  1 = message parsed
 //  0 = need more data (no message yet)
@@ -74,9 +100,9 @@ coro::task<int> read_one(coro::net::tcp::client &client, t2d::ServerMessage &out
     {
         std::string payload;
         if (t2d::netutil::try_extract(state, payload)) {
-            if (out.ParseFromArray(payload.data(), (int)payload.size()))
-                co_return 1;
-            co_return -1;
+            int r = parse_server_payload(payload, out);
+            if (r != 0)
+                co_return r;
         }
     }
     if (time_left.count() <= 0) {
@@ -91,7 +117,7 @@ coro::task<int> read_one(coro::net::tcp::client &client, t2d::ServerMessage &out
     if (pstat == coro::poll_status::error || pstat == coro::poll_status::closed) {
         // Attempt final extraction before declaring closed
         std::string payload;
-        if (t2d::netutil::try_extract(state, payload) && out.ParseFromArray(payload.data(), (int)payload.size()))
+        if (t2d::netutil::try_extract(state, payload) && parse_server_payload(payload, out) == 1)
             co_return 1;
         co_return -1;
     }
@@ -99,7 +125,7 @@ coro::task<int> read_one(coro::net::tcp::client &client, t2d::ServerMessage &out
     auto [st, span] = client.recv(tmp);
     if (st == coro::net::recv_status::closed) {
         std::string payload;
-        if (t2d::netutil::try_extract(state, payload) && out.ParseFromArray(payload.data(), (int)payload.size()))
+        if (t2d::netutil::try_extract(state, payload) && parse_server_payload(payload, out) == 1)
             co_return 1;
         co_return -1;
     }
@@ -109,9 +135,7 @@ coro::task<int> read_one(coro::net::tcp::client &client, t2d::ServerMessage &out
     std::string payload;
     if (!t2d::netutil::try_extract(state, payload))
         co_return 0;
-    if (!out.ParseFromArray(payload.data(), (int)payload.size()))
-        co_return -1;
-    co_return 1;
+    co_return parse_server_payload(payload, out);
 }
 
 coro::task<void> run_network(
@@ -139,6 +163,8 @@ coro::task<void> run_network(
     auto *rq = auth.mutable_auth_request();
     rq->set_oauth_token(oauth_token);
     rq->set_client_version(T2D_VERSION);
+    rq->set_compact_input(true);
+    rq->set_frame_version(t2d::netutil::FRAME_VERSION);
     co_await send_frame(cli, auth);
     t2d::log::debug("auth_request sent token_len={}", oauth_token.size());
     t2d::ClientMessage q;
@@ -146,6 +172,9 @@ coro::task<void> run_network(
     co_await send_frame(cli, q);
     t2d::log::debug("queue_join sent");
     std::string session_id;
+    bool compactInput = false; // server accepted compact binary input frames
+    std::string inputPayload; // reused compact frame buffer
+    uint32_t frameVersion = 0; // negotiated frame header version (0 = legacy frames only)
     bool in_match = false;
     uint32_t myEntityId = 0; // authoritative from MatchStart
     // lobbyState now tracked via LobbyState object in QML
@@ -160,6 +189,12 @@ coro::task<void> run_network(
     auto last_heartbeat = std::chrono::steady_clock::now();
     auto last_input = std::chrono::steady_clock::now();
     uint32_t client_tick_counter = 0;
+    // Keyframe gap detection: deltas must build on the last full snapshot we applied; otherwise request a keyframe.
+    uint32_t lastFullTick = 0;
+    uint32_t lastSnapshotTick = 0;
+    bool keyframeNeeded = false;
+    constexpr auto keyframe_request_interval = std::chrono::milliseconds(500);
+    auto last_keyframe_request = std::chrono::steady_clock::time_point{};
     // Profiling (enable via env T2D_PROFILE=1). Aggregates over 5 second windows.
     const bool profiling_enabled = (std::getenv("T2D_PROFILE") != nullptr);
 
@@ -183,11 +218,23 @@ coro::task<void> run_network(
             last_heartbeat = iter_start;
             t2d::ClientMessage hb;
             auto *h = hb.mutable_heartbeat();
-            h->set_session_id(session_id);
+            if (!compactInput)
+                h->set_session_id(session_id); // connection is authenticated; only legacy servers want it
             h->set_time_ms((uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
                                std::chrono::steady_clock::now().time_since_epoch())
                                .count());
-            co_await send_frame(cli, hb);
+            uint32_t rttUs = 0;
+            int64_t offsetUs = 0;
+            timing->clockEstimate(rttUs, offsetUs);
+            h->set_rtt_us(rttUs);
+            h->set_clock_offset_us(offsetUs);
+            h->set_client_send_us(t2d::netutil::steady_us()); // t1 last, closest to the actual send
+            if (frameVersion >= 1) {
+                auto body = hb.heartbeat().SerializeAsString();
+                co_await send_payload(cli, t2d::netutil::typed_payload(t2d::netutil::FrameType::Heartbeat, body));
+            } else {
+                co_await send_frame(cli, hb);
+            }
             if (profiling_enabled)
                 ++prof.heartbeats;
             t2d::log::debug(
@@ -196,15 +243,13 @@ coro::task<void> run_network(
         // Input send based on elapsed time
         if (in_match && (iter_start - last_input >= input_interval)) {
             last_input = iter_start;
-            t2d::ClientMessage in;
-            auto *ic = in.mutable_input();
-            ic->set_session_id(session_id);
-            ic->set_client_tick(client_tick_counter++);
-            ic->set_move_dir(input->move());
-            ic->set_turn_dir(input->turn());
-            ic->set_turret_turn(input->turretTurn());
-            ic->set_fire(input->fire());
-            ic->set_brake(input->brake());
+            t2d::netutil::CompactInput ci;
+            ci.client_tick = client_tick_counter++;
+            ci.move_dir = input->move();
+            ci.turn_dir = input->turn();
+            ci.turret_turn = input->turretTurn();
+            ci.fire = input->fire();
+            ci.brake = input->brake();
             t2d::log::debug(
                 "send_input ctick={} move={} turn={} turret={} fire={} brake={}",
                 client_tick_counter - 1,
@@ -213,10 +258,35 @@ coro::task<void> run_network(
                 input->turretTurn(),
                 input->fire(),
                 input->brake());
-            co_await send_frame(cli, in);
+            timing->noteInputSent(ci.client_tick);
+            if (compactInput) {
+                t2d::netutil::encode_compact_input(ci, inputPayload);
+                co_await send_payload(cli, inputPayload);
+            } else {
+                t2d::ClientMessage in;
+                auto *ic = in.mutable_input();
+                ic->set_session_id(session_id);
+                ic->set_client_tick(ci.client_tick);
+                ic->set_move_dir(ci.move_dir);
+                ic->set_turn_dir(ci.turn_dir);
+                ic->set_turret_turn(ci.turret_turn);
+                ic->set_fire(ci.fire);
+                ic->set_brake(ci.brake);
+                co_await send_frame(cli, in);
+            }
             if (profiling_enabled)
                 ++prof.inputs;
         }
+        if (in_match && keyframeNeeded && iter_start - last_keyframe_request >= keyframe_request_interval) {
+            last_keyframe_request = iter_start;
+            keyframeNeeded = false;
+            t2d::ClientMessage kr;
+            auto *k = kr.mutable_keyframe_request();
+            k->set_last_full_tick(lastFullTick);
+            k->set_last_server_tick(lastSnapshotTick);
+            co_await send_frame(cli, kr);
+            t2d::log::info("keyframe request last_full={} last_tick={}", lastFullTick, lastSnapshotTick);
+        }
         // Remaining time budget after outbound sends
         auto after_sends = std::chrono::steady_clock::now();
         auto elapsed = after_sends - iter_start;
@@ -227,18 +297,29 @@ coro::task<void> run_network(
         if (time_left.count() > 0) {
             t2d::ServerMessage sm;
             int r = co_await read_one(cli, sm, time_left);
+            const uint64_t recvUs = t2d::netutil::steady_us(); // t4 for heartbeat responses
             if (r == 1) {
                 if (profiling_enabled)
                     ++prof.msgs;
                 if (sm.has_auth_response()) {
                     session_id = sm.auth_response().session_id();
-                    t2d::log::info("auth_response session_id={} (len={})", session_id, session_id.size());
+                    compactInput = sm.auth_response().compact_input();
+                    frameVersion = sm.auth_response().frame_version();
+                    t2d::log::info(
+                        "auth_response session_id={} (len={}) compact_input={} frame_version={}",
+                        session_id,
+                        session_id.size(),
+                        compactInput,
+                        frameVersion);
                 } else if (sm.has_match_start()) {
                     in_match = true;
                     timing->setMatchActive(true);
                     tickRate = sm.match_start().tick_rate();
                     if (tickRate > 0) {
                         timing->setTickIntervalMs((int)(1000 / tickRate));
+                        float tickDt = 1.f / (float)tickRate;
+                        QMetaObject::invokeMethod(
+                            projModel, [projModel, tickDt]() { projModel->setTickDt(tickDt); }, Qt::QueuedConnection);
                         iteration_budget = std::chrono::milliseconds(1000 / tickRate);
                     } else {
                         iteration_budget = std::chrono::milliseconds(20);
@@ -261,8 +342,12 @@ coro::task<void> run_network(
                     hardCapTicks = tickRate * secs;
                     matchStartServerTick = 0;
                     timing->setHardCap(matchStartServerTick, tickRate, hardCapTicks);
+                    lastFullTick = lastSnapshotTick = 0;
+                    keyframeNeeded = false;
                 } else if (sm.has_snapshot()) {
                     // Dispatch to UI thread to mutate models (Qt requirement)
+                    lastFullTick = lastSnapshotTick = sm.snapshot().server_tick();
+                    keyframeNeeded = false;
                     auto snap = std::make_shared<t2d::StateSnapshot>(sm.snapshot());
                     QMetaObject::invokeMethod(
                         tankModel,
@@ -272,29 +357,41 @@ coro::task<void> run_network(
                             projModel->applyFull(*snap);
                             ammoModel->applyFull(*snap);
                             crateModel->applyFull(*snap);
-                            timing->markServerTick();
+                            timing->markServerTick(snap->server_time_us());
                             timing->setServerTick(snap->server_tick());
+                            timing->noteInputEffect(snap->last_input_tick());
                         },
                         Qt::QueuedConnection);
                 } else if (sm.has_delta_snapshot()) {
+                    const auto &d = sm.delta_snapshot();
+                    if (d.base_tick() != lastFullTick || d.server_tick() < lastSnapshotTick)
+                        keyframeNeeded = true;
+                    lastSnapshotTick = std::max(lastSnapshotTick, d.server_tick());
                     auto delta = std::make_shared<t2d::DeltaSnapshot>(sm.delta_snapshot());
                     QMetaObject::invokeMethod(
                         tankModel,
-                        [tankModel, projModel, crateModel, timing, delta]()
+                        [tankModel, projModel, ammoModel, crateModel, timing, delta]()
                         {
                             tankModel->applyDelta(*delta);
                             projModel->applyDelta(*delta);
+                            ammoModel->applyDelta(*delta);
                             crateModel->applyDelta(*delta);
-                            timing->markServerTick();
+                            timing->markServerTick(delta->server_time_us());
                             timing->setServerTick(delta->server_tick());
+                            timing->noteInputEffect(delta->last_input_tick());
                         },
                         Qt::QueuedConnection);
+                } else if (sm.has_heartbeat_resp()) {
+                    const auto &hr = sm.heartbeat_resp();
+                    timing->noteHeartbeat(hr.client_send_us(), hr.server_recv_us(), hr.server_send_us(), recvUs);
                 } else if (sm.has_match_end()) {
                     t2d::log::info(
                         "match_end received winner_entity={} my_entity={} server_tick={}",
                         sm.match_end().winner_entity_id(),
                         myEntityId,
                         sm.match_end().server_tick());
+                    t2d::log::info("[latency] input_to_effect {}", timing->inputLatencySummary());
+                    t2d::log::info("[clock] {}", timing->clockSyncSummary());
                     timing->onMatchEnd(sm.match_end().winner_entity_id(), myEntityId);
                     in_match = false;
                     timing->setMatchActive(false);
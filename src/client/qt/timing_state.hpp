@@ -1,7 +1,11 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
+#include "common/clock_sync.hpp"
+#include "common/input_latency.hpp"
+
 #include <array>
 #include <chrono>
+#include <mutex>
 
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
@@ -22,6 +26,13 @@ class TimingState : public QObject
     Q_PROPERTY(double lastFrameMs READ lastFrameMs NOTIFY frameStatsChanged)
     Q_PROPERTY(double maxFrameMs READ maxFrameMs NOTIFY frameStatsChanged)
     Q_PROPERTY(qulonglong longFrameCount READ longFrameCount NOTIFY frameStatsChanged)
+    // Input-to-effect latency (input sent -> first applied snapshot acknowledging it via last_input_tick)
+    Q_PROPERTY(double inputLatencyP50Ms READ inputLatencyP50Ms NOTIFY inputLatencyChanged)
+    Q_PROPERTY(double inputLatencyP99Ms READ inputLatencyP99Ms NOTIFY inputLatencyChanged)
+    Q_PROPERTY(qulonglong inputLatencySamples READ inputLatencySamples NOTIFY inputLatencyChanged)
+    // Heartbeat clock sync (min-RTT filtered NTP-style estimate)
+    Q_PROPERTY(double rttMs READ rttMs NOTIFY clockSyncChanged)
+    Q_PROPERTY(double clockOffsetMs READ clockOffsetMs NOTIFY clockSyncChanged)
 
 public:
     explicit TimingState(QObject *parent = nullptr) : QObject(parent) {}
@@ -97,20 +108,34 @@ public:
         lastIntervalMs_ = (float)ms; // initialize window length
     }
 
-    // Called from network thread when a new authoritative tick (snapshot/delta) arrives.
-    void markServerTick()
+    // Called when a new authoritative tick (snapshot/delta) has been applied. serverTimeUs is the snapshot's
+    // server_time_us: once the heartbeat clock sync has a sample the tick is timed at its server start mapped onto the
+    // local clock plus the one-way delay (rtt / 2), i.e. when it would have arrived without queueing or jitter, so
+    // the interpolation windows follow the real server cadence. Without it (older server, no heartbeat answered yet)
+    // the arrival time is used.
+    void markServerTick(uint64_t serverTimeUs = 0)
     {
         auto now = std::chrono::steady_clock::now();
         std::scoped_lock lk(m_);
+        auto at = now;
+        if (serverTimeUs != 0 && clockSync_.valid()) {
+            auto localUs = clockSync_.to_local_us(serverTimeUs) + static_cast<uint64_t>(clockSync_.rtt_us() / 2);
+            std::chrono::steady_clock::time_point est{std::chrono::microseconds(localUs)};
+            // Never in the future; more than a second behind means the estimate is stale (e.g. server restart).
+            if (est <= now && now - est < std::chrono::seconds(1))
+                at = est;
+        }
+        if (havePrevTick_ && at < lastTick_)
+            at = lastTick_; // offset re-selected between two ticks: keep the sequence monotonic
         prevTick_ = lastTick_;
-        lastTick_ = now;
+        lastTick_ = at;
         // ring buffer push
         if (tickTimesSize_ < (int)tickTimes_.size()) {
-            tickTimes_[tickTimesSize_++] = now;
+            tickTimes_[tickTimesSize_++] = at;
         } else {
             for (int i = 1; i < tickTimesSize_; ++i)
                 tickTimes_[i - 1] = tickTimes_[i];
-            tickTimes_[tickTimesSize_ - 1] = now;
+            tickTimes_[tickTimesSize_ - 1] = at;
         }
         if (havePrevTick_) {
             float dt_ms = std::chrono::duration<float, std::milli>(lastTick_ - prevTick_).count();
@@ -202,8 +227,94 @@ public:
         emit frameStatsChanged();
     }
 
+    // Input-to-effect latency. The network thread records when each input left; the UI thread reports the
+    // last_input_tick of every snapshot right after applying it, so samples include the hop to the UI thread.
+    void noteInputSent(uint32_t clientTick)
+    {
+        std::scoped_lock lk(m_);
+        inputLatency_.on_input_sent(clientTick, std::chrono::steady_clock::now());
+    }
+
+    void noteInputEffect(uint32_t lastInputTick)
+    {
+        uint64_t samples = 0;
+        {
+            std::scoped_lock lk(m_);
+            if (inputLatency_.on_snapshot(lastInputTick, std::chrono::steady_clock::now()) < 0)
+                return;
+            samples = inputLatency_.count();
+        }
+        if (samples % 10 == 1) // throttle QML updates
+            emit inputLatencyChanged();
+    }
+
+    double inputLatencyP50Ms() const
+    {
+        std::scoped_lock lk(m_);
+        return inputLatency_.percentile_us(0.50) / 1000.0;
+    }
+
+    double inputLatencyP99Ms() const
+    {
+        std::scoped_lock lk(m_);
+        return inputLatency_.percentile_us(0.99) / 1000.0;
+    }
+
+    qulonglong inputLatencySamples() const
+    {
+        std::scoped_lock lk(m_);
+        return inputLatency_.count();
+    }
+
+    std::string inputLatencySummary() const
+    {
+        std::scoped_lock lk(m_);
+        return inputLatency_.summary();
+    }
+
+    // Heartbeat clock sync (network thread): the four timestamps of one exchange, see common/clock_sync.hpp.
+    void noteHeartbeat(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4)
+    {
+        {
+            std::scoped_lock lk(m_);
+            if (!clockSync_.add_sample(t1, t2, t3, t4))
+                return;
+        }
+        emit clockSyncChanged();
+    }
+
+    // Current filtered estimate for the next Heartbeat (rtt 0 = no exchange completed yet).
+    void clockEstimate(uint32_t &rttUs, int64_t &offsetUs) const
+    {
+        std::scoped_lock lk(m_);
+        rttUs = clockSync_.report_rtt_us();
+        offsetUs = clockSync_.offset_us();
+    }
+
+    double rttMs() const
+    {
+        std::scoped_lock lk(m_);
+        return clockSync_.rtt_us() / 1000.0;
+    }
+
+    double clockOffsetMs() const
+    {
+        std::scoped_lock lk(m_);
+        return clockSync_.offset_us() / 1000.0;
+    }
+
+    std::string clockSyncSummary() const
+    {
+        std::scoped_lock lk(m_);
+        return clockSync_.summary();
+    }
+
     void setHardCap(uint64_t serverTickAtStart, uint64_t tickRate, uint64_t fallbackTicks)
     {
+        {
+            std::scoped_lock lk(m_);
+            inputLatency_.reset_stats(); // histogram per match
+        }
         matchStartServerTick_ = serverTickAtStart;
         tickRate_ = tickRate;
         fallbackTicks_ = fallbackTicks;
@@ -321,6 +432,8 @@ signals:
     void frameTick();
     void targetFrameHzChanged();
     void frameStatsChanged();
+    void inputLatencyChanged();
+    void clockSyncChanged();
 
 private:
     mutable std::mutex m_;
@@ -350,7 +463,7 @@ private:
     int frameHz_{144};
     int frameIntervalMs_{7}; // 1000/144 ~= 6.94ms -> 7ms
     // snapshot buffering & pacing members
-    std::array<std::chrono::steady_clock::time_point, 8> tickTimes_{}; // arrival times
+    std::array<std::chrono::steady_clock::time_point, 8> tickTimes_{}; // de-jittered arrival times
     int tickTimesSize_{0};
     int playbackDelayTicks_{1}; // fixed delay (buffer one full tick)
     float stableIntervalMs_{50.f}; // frozen playback interval
@@ -372,6 +485,8 @@ private:
     double maxFrameDurationMs_{0.0};
     uint64_t longFrameCount_{0};
     double longFrameThresholdMs_{16.0}; // > ~2 frames at 144Hz (~13.9ms) treated as long
+    t2d::netutil::InputLatencyTracker inputLatency_; // guarded by m_
+    t2d::netutil::ClockSync clockSync_; // guarded by m_
 
     void updateRemaining()
     {
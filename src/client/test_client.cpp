@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
+#include "common/clock_sync.hpp"
 #include "common/framing.hpp"
+#include "common/input_latency.hpp"
 #include "common/logger.hpp"
 #include "game.pb.h"
 
@@ -37,11 +39,18 @@ static coro::task<void> send_frame(coro::net::tcp::client &client, const t2d::Cl
     }
 }
 
-static coro::task<bool> read_frame(coro::net::tcp::client &client, t2d::ServerMessage &out)
+// timeout 0 = wait for data (libcoro semantics); a timed-out poll reports "nothing ready".
+static coro::task<bool> read_frame(
+    coro::net::tcp::client &client, t2d::ServerMessage &out, std::chrono::milliseconds timeout = 0ms)
 {
     static t2d::netutil::FrameParseState state; // simple static for prototype
+    std::string payload;
+    // A previous chunk may already hold complete frames: hand them out before waiting on the socket.
+    if (t2d::netutil::try_extract(state, payload))
+        co_return out.ParseFromArray(payload.data(), (int)payload.size());
     // read available chunk
-    co_await client.poll(coro::poll_op::read);
+    if (co_await client.poll(coro::poll_op::read, timeout) == coro::poll_status::timeout)
+        co_return false;
     std::string tmp(1024, '\0');
     auto [st, span] = client.recv(tmp);
     if (st == coro::net::recv_status::closed)
@@ -51,7 +60,6 @@ static coro::task<bool> read_frame(coro::net::tcp::client &client, t2d::ServerMe
     if (st != coro::net::recv_status::ok)
         co_return false;
     state.buffer.insert(state.buffer.end(), span.begin(), span.end());
-    std::string payload;
     if (!t2d::netutil::try_extract(state, payload))
         co_return false;
     if (!out.ParseFromArray(payload.data(), (int)payload.size()))
@@ -111,6 +119,10 @@ static coro::task<void> client_flow(std::shared_ptr<coro::io_scheduler> schedule
     uint64_t client_tick = 0;
     auto active_start = std::chrono::steady_clock::now();
     auto next_hb = active_start;
+    // Input-to-effect: send time per client_tick vs the snapshot that first acknowledges it (last_input_tick).
+    t2d::netutil::InputLatencyTracker latency;
+    t2d::netutil::ClockSync clock_sync; // NTP-style heartbeat exchange, reported back on the next heartbeat
+    auto next_latency_log = active_start + 5s;
     while (std::chrono::steady_clock::now() - active_start < std::chrono::seconds(active_secs)) {
         t2d::ClientMessage in;
         auto *ic = in.mutable_input();
@@ -121,6 +133,7 @@ static coro::task<void> client_flow(std::shared_ptr<coro::io_scheduler> schedule
         ic->set_turret_turn(dir(rng));
         ic->set_fire((client_tick % 15) == 0); // periodic fire attempt
         ic->set_brake(false);
+        latency.on_input_sent(ic->client_tick(), std::chrono::steady_clock::now());
         co_await send_frame(cli, in);
         auto now = std::chrono::steady_clock::now();
         if (now >= next_hb) {
@@ -128,17 +141,38 @@ static coro::task<void> client_flow(std::shared_ptr<coro::io_scheduler> schedule
             auto *h = hb.mutable_heartbeat();
             h->set_session_id(session_id);
             h->set_time_ms((uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - active_start).count());
+            h->set_rtt_us(clock_sync.report_rtt_us());
+            h->set_clock_offset_us(clock_sync.offset_us());
+            h->set_client_send_us(t2d::netutil::steady_us());
             co_await send_frame(cli, hb);
             next_hb = now + 2s;
         }
-        // Opportunistically read any server frames (non-strict; best effort)
-        for (int i = 0; i < 2; ++i) {
+        // Opportunistically read any server frames (non-strict; best effort). Drain a bounded batch so snapshots do
+        // not queue up behind the 100ms input cadence and inflate the measured latency.
+        for (int i = 0; i < 64; ++i) {
             t2d::ServerMessage sm;
-            if (!co_await read_frame(cli, sm))
+            if (!co_await read_frame(cli, sm, 1ms))
                 break; // nothing ready
+            auto recv_at = std::chrono::steady_clock::now();
+            if (sm.has_snapshot())
+                latency.on_snapshot(sm.snapshot().last_input_tick(), recv_at);
+            else if (sm.has_delta_snapshot())
+                latency.on_snapshot(sm.delta_snapshot().last_input_tick(), recv_at);
+            else if (sm.has_heartbeat_resp()) {
+                const auto &hr = sm.heartbeat_resp();
+                clock_sync.add_sample(
+                    hr.client_send_us(), hr.server_recv_us(), hr.server_send_us(), t2d::netutil::steady_us(recv_at));
+            }
+        }
+        if (now >= next_latency_log) {
+            t2d::log::info("[latency] input_to_effect {}", latency.summary());
+            t2d::log::info("[clock] {}", clock_sync.summary());
+            next_latency_log = now + 5s;
         }
         co_await scheduler->yield_for(100ms);
     }
+    t2d::log::info("[latency] input_to_effect final {}", latency.summary());
+    t2d::log::info("[clock] final {}", clock_sync.summary());
     t2d::log::info("Active phase complete (secs={})", active_secs);
 }
 
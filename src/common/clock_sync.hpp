@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+// clock_sync.hpp - NTP-style clock offset / RTT estimation over the Heartbeat exchange. Each round trip yields four
+// timestamps: t1 client send, t2 server receive, t3 server send (server clock), t4 client receive (client clock).
+//   rtt    = (t4 - t1) - (t3 - t2)          network time, server processing excluded
+//   offset = ((t2 - t1) + (t3 - t4)) / 2    server clock - client clock, exact when both legs take equally long
+// Queueing delay inflates one leg and skews offset by up to rtt / 2, so like NTP's clock filter the estimator keeps
+// the last kWindow samples and trusts the one with the smallest RTT.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+namespace t2d::netutil {
+
+// Monotonic microseconds (steady_clock epoch) used for every timestamp of the exchange.
+inline uint64_t steady_us(std::chrono::steady_clock::time_point tp)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count());
+}
+
+inline uint64_t steady_us()
+{
+    return steady_us(std::chrono::steady_clock::now());
+}
+
+class ClockSync
+{
+public:
+    static constexpr size_t kWindow = 8; // samples considered by the min-RTT filter (8 heartbeats ~ 8s)
+
+    // Adds one exchange; returns false (sample dropped) when a timestamp is missing or the ordering is impossible
+    // (t4 before t1, server send before receive, processing longer than the whole round trip).
+    bool add_sample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4)
+    {
+        if (t1 == 0 || t2 == 0 || t3 == 0 || t4 == 0 || t4 < t1 || t3 < t2 || (t3 - t2) > (t4 - t1)) {
+            ++m_rejected;
+            return false;
+        }
+        Sample s;
+        s.rtt_us = static_cast<int64_t>((t4 - t1) - (t3 - t2));
+        s.offset_us = ((static_cast<int64_t>(t2) - static_cast<int64_t>(t1))
+                       + (static_cast<int64_t>(t3) - static_cast<int64_t>(t4)))
+            / 2;
+        m_samples[m_next] = s;
+        m_next = (m_next + 1) % kWindow;
+        m_size = std::min(m_size + 1, kWindow);
+        ++m_count;
+        select();
+        return true;
+    }
+
+    bool valid() const { return m_size > 0; }
+
+    // Filtered estimates (0 until the first sample).
+    int64_t rtt_us() const { return m_best.rtt_us; }
+
+    int64_t offset_us() const { return m_best.offset_us; }
+
+    // Value for Heartbeat.rtt_us, where 0 means "no exchange yet": a measured sub-microsecond RTT is reported as 1.
+    uint32_t report_rtt_us() const
+    {
+        if (m_size == 0)
+            return 0;
+        return static_cast<uint32_t>(std::clamp<int64_t>(m_best.rtt_us, 1, std::numeric_limits<uint32_t>::max()));
+    }
+
+    // RMS distance of the windowed offsets from the selected one (how far a single exchange could mislead).
+    int64_t jitter_us() const { return m_jitter_us; }
+
+    uint64_t samples() const { return m_count; }
+
+    uint64_t rejected() const { return m_rejected; }
+
+    // Server timestamp mapped onto the local clock (and back).
+    uint64_t to_local_us(uint64_t server_us) const
+    {
+        return static_cast<uint64_t>(static_cast<int64_t>(server_us) - m_best.offset_us);
+    }
+
+    uint64_t to_server_us(uint64_t local_us) const
+    {
+        return static_cast<uint64_t>(static_cast<int64_t>(local_us) + m_best.offset_us);
+    }
+
+    std::string summary() const
+    {
+        char buf[128];
+        std::snprintf(
+            buf,
+            sizeof(buf),
+            "n=%llu rejected=%llu rtt=%.2fms offset=%.2fms jitter=%.2fms",
+            static_cast<unsigned long long>(m_count),
+            static_cast<unsigned long long>(m_rejected),
+            m_best.rtt_us / 1000.0,
+            m_best.offset_us / 1000.0,
+            m_jitter_us / 1000.0);
+        return buf;
+    }
+
+    // New connection (possibly another server process): the old offset means nothing.
+    void reset() { *this = ClockSync{}; }
+
+private:
+    struct Sample
+    {
+        int64_t rtt_us{0};
+        int64_t offset_us{0};
+    };
+
+    void select()
+    {
+        const Sample *best = &m_samples[0];
+        for (size_t i = 1; i < m_size; ++i) {
+            if (m_samples[i].rtt_us < best->rtt_us)
+                best = &m_samples[i];
+        }
+        m_best = *best;
+        double acc = 0.0;
+        for (size_t i = 0; i < m_size; ++i) {
+            double d = static_cast<double>(m_samples[i].offset_us - m_best.offset_us);
+            acc += d * d;
+        }
+        m_jitter_us = static_cast<int64_t>(std::sqrt(acc / static_cast<double>(m_size)));
+    }
+
+    std::array<Sample, kWindow> m_samples{};
+    size_t m_next{0};
+    size_t m_size{0};
+    Sample m_best{};
+    int64_t m_jitter_us{0};
+    uint64_t m_count{0};
+    uint64_t m_rejected{0};
+};
+
+} // namespace t2d::netutil
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+// compact_input.hpp - negotiated binary encoding for the per-frame player input (replaces ClientMessage.input once
+// AuthResponse.compact_input is true). Travels as a FrameType::InputCompact frame (frame_header.hpp); body layout:
+//   [0] flags (bit0 fire, bit1 brake)
+//   [1] move_dir  int8 (-127..127 -> -1..1)
+//   [2] turn_dir  int8
+//   [3] turret_turn int8
+//   [4..] client_tick LEB128 varint (1..5 bytes)
+// 3 header + 5..9 body bytes versus ~40 for the protobuf InputCommand with its session_id string.
+#pragma once
+#include "common/frame_header.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace t2d::netutil {
+
+inline constexpr uint8_t COMPACT_FLAG_FIRE = 0x01;
+inline constexpr uint8_t COMPACT_FLAG_BRAKE = 0x02;
+inline constexpr size_t COMPACT_INPUT_MAX_BYTES = 9; // body
+
+struct CompactInput
+{
+    uint32_t client_tick{0};
+    float move_dir{0.f};
+    float turn_dir{0.f};
+    float turret_turn{0.f};
+    bool fire{false};
+    bool brake{false};
+};
+
+inline int8_t quantize_axis(float v)
+{
+    if (!(v == v)) // NaN
+        return 0;
+    return static_cast<int8_t>(std::lround(std::clamp(v, -1.f, 1.f) * 127.f));
+}
+
+inline float dequantize_axis(int8_t q)
+{
+    return std::max(-1.f, static_cast<float>(q) / 127.f);
+}
+
+// Replaces out with the complete frame payload (header + body, no length prefix).
+inline void encode_compact_input(const CompactInput &in, std::string &out)
+{
+    out.clear();
+    FrameHeader h;
+    h.type = FrameType::InputCompact;
+    append_frame_header(h, out);
+    uint8_t flags = (in.fire ? COMPACT_FLAG_FIRE : 0) | (in.brake ? COMPACT_FLAG_BRAKE : 0);
+    out.push_back(static_cast<char>(flags));
+    out.push_back(static_cast<char>(quantize_axis(in.move_dir)));
+    out.push_back(static_cast<char>(quantize_axis(in.turn_dir)));
+    out.push_back(static_cast<char>(quantize_axis(in.turret_turn)));
+    uint32_t t = in.client_tick;
+    while (t >= 0x80) {
+        out.push_back(static_cast<char>((t & 0x7F) | 0x80));
+        t >>= 7;
+    }
+    out.push_back(static_cast<char>(t));
+}
+
+// Decodes an InputCompact frame body. Returns false on a truncated / oversized body (caller treats it like a
+// protobuf parse failure).
+inline bool decode_compact_input(const char *data, size_t len, CompactInput &out)
+{
+    if (len < 5 || len > COMPACT_INPUT_MAX_BYTES)
+        return false;
+    const auto *p = reinterpret_cast<const uint8_t *>(data);
+    out.fire = (p[0] & COMPACT_FLAG_FIRE) != 0;
+    out.brake = (p[0] & COMPACT_FLAG_BRAKE) != 0;
+    out.move_dir = dequantize_axis(static_cast<int8_t>(p[1]));
+    out.turn_dir = dequantize_axis(static_cast<int8_t>(p[2]));
+    out.turret_turn = dequantize_axis(static_cast<int8_t>(p[3]));
+    uint32_t tick = 0;
+    int shift = 0;
+    for (size_t i = 4; i < len; ++i, shift += 7) {
+        tick |= static_cast<uint32_t>(p[i] & 0x7F) << shift;
+        if ((p[i] & 0x80) == 0) {
+            out.client_tick = tick;
+            return i + 1 == len;
+        }
+    }
+    return false; // varint ran past the payload
+}
+
+} // namespace t2d::netutil
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: Apache-2.0
+// frame_header.hpp - versioned frame header (negotiated via AuthRequest/AuthResponse.frame_version). Sits at the
+// start of the payload inside the 4-byte length prefix (framing.hpp):
+//   [0] 0x00 marker - protobuf messages never start with field number 0, so headered and legacy (bare protobuf)
+//       frames can share one stream and either side can tell them apart without negotiation state
+//   [1] version (high nibble, FRAME_VERSION) | flags (low nibble, FRAME_FLAG_*)
+//   [2] type (FrameType) - lets the receiver route without parsing the body
+//   [3] codec (FrameCodec), only when FRAME_FLAG_COMPRESSED
+//   [..] sequence number (LEB128 varint), only when FRAME_FLAG_SEQ
+//   body
+// A message larger than one frame may be split into fragments of the same type: every fragment but the last carries
+// FRAME_FLAG_MORE; compression applies per fragment.
+#pragma once
+#include "common/rle.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace t2d::netutil {
+
+inline constexpr uint8_t FRAME_MARKER = 0x00;
+inline constexpr uint8_t FRAME_VERSION = 1;
+inline constexpr uint8_t FRAME_FLAG_SEQ = 0x01;
+inline constexpr uint8_t FRAME_FLAG_MORE = 0x02; // more fragments follow
+inline constexpr uint8_t FRAME_FLAG_COMPRESSED = 0x04; // codec byte present, body encoded
+inline constexpr size_t FRAME_MAX_MESSAGE_BYTES = 10'000'000; // reassembly cap (matches try_extract)
+inline constexpr size_t FRAME_COMPRESS_MIN_BYTES = 1024; // server bodies offered to RLE (full snapshots)
+
+enum class FrameType : uint8_t
+{
+    Legacy = 0, // bare protobuf payload without header (ClientMessage / ServerMessage by direction)
+    ClientMessage = 1,
+    ServerMessage = 2,
+    InputCompact = 3, // compact_input.hpp body
+    Input = 4, // protobuf InputCommand body
+    Heartbeat = 5 // protobuf Heartbeat body
+};
+
+enum class FrameCodec : uint8_t
+{
+    Raw = 0,
+    Rle = 1 // common/rle.hpp
+};
+
+struct FrameHeader
+{
+    FrameType type{FrameType::Legacy};
+    uint8_t flags{0};
+    FrameCodec codec{FrameCodec::Raw};
+    uint32_t seq{0};
+};
+
+inline bool is_headered_payload(const char *data, size_t len)
+{
+    return len > 0 && static_cast<uint8_t>(data[0]) == FRAME_MARKER;
+}
+
+// Appends the header to out (flags SEQ / COMPRESSED are derived from h.flags; codec written when compressed).
+inline void append_frame_header(const FrameHeader &h, std::string &out)
+{
+    out.push_back(static_cast<char>(FRAME_MARKER));
+    out.push_back(static_cast<char>((FRAME_VERSION << 4) | (h.flags & 0x0F)));
+    out.push_back(static_cast<char>(h.type));
+    if (h.flags & FRAME_FLAG_COMPRESSED)
+        out.push_back(static_cast<char>(h.codec));
+    if (h.flags & FRAME_FLAG_SEQ) {
+        uint32_t s = h.seq;
+        while (s >= 0x80) {
+            out.push_back(static_cast<char>((s & 0x7F) | 0x80));
+            s >>= 7;
+        }
+        out.push_back(static_cast<char>(s));
+    }
+}
+
+// Parses the header; returns its size (body starts there) or 0 when malformed / unsupported version.
+inline size_t parse_frame_header(const char *data, size_t len, FrameHeader &h)
+{
+    const auto *p = reinterpret_cast<const uint8_t *>(data);
+    if (len < 3 || p[0] != FRAME_MARKER || (p[1] >> 4) != FRAME_VERSION)
+        return 0;
+    h.flags = p[1] & 0x0F;
+    h.type = static_cast<FrameType>(p[2]);
+    h.codec = FrameCodec::Raw;
+    h.seq = 0;
+    size_t pos = 3;
+    if (h.flags & FRAME_FLAG_COMPRESSED) {
+        if (pos >= len)
+            return 0;
+        h.codec = static_cast<FrameCodec>(p[pos++]);
+        if (h.codec != FrameCodec::Rle)
+            return 0;
+    }
+    if (h.flags & FRAME_FLAG_SEQ) {
+        uint32_t seq = 0;
+        for (int shift = 0;; shift += 7) {
+            if (pos >= len || shift > 28)
+                return 0;
+            uint8_t b = p[pos++];
+            seq |= static_cast<uint32_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+                break;
+        }
+        h.seq = seq;
+    }
+    return pos;
+}
+
+// Header + raw body without the length prefix (for senders that add the prefix themselves).
+inline std::string typed_payload(FrameType type, const std::string &body)
+{
+    FrameHeader h;
+    h.type = type;
+    std::string out;
+    out.reserve(3 + body.size());
+    append_frame_header(h, out);
+    out.append(body);
+    return out;
+}
+
+// Builds a complete length-prefixed frame: header + body. With try_compress the body is RLE-encoded when that
+// shrinks it (the flag is only set when it does, so small or incompressible bodies go out raw). flags may add
+// FRAME_FLAG_MORE for a leading fragment.
+inline std::string build_typed_frame(
+    FrameType type, const std::string &body, bool try_compress = false, uint8_t flags = 0)
+{
+    FrameHeader h;
+    h.type = type;
+    h.flags = flags & FRAME_FLAG_MORE;
+    std::string encoded;
+    const std::string *src = &body;
+    if (try_compress) {
+        encoded = t2d::compress::rle_compress(body);
+        if (encoded.size() < body.size()) {
+            h.flags |= FRAME_FLAG_COMPRESSED;
+            h.codec = FrameCodec::Rle;
+            src = &encoded;
+        }
+    }
+    std::string frame(4, '\0');
+    append_frame_header(h, frame);
+    frame.append(*src);
+    uint32_t len = static_cast<uint32_t>(frame.size() - 4);
+    frame[0] = static_cast<char>(len >> 24);
+    frame[1] = static_cast<char>(len >> 16);
+    frame[2] = static_cast<char>(len >> 8);
+    frame[3] = static_cast<char>(len);
+    return frame;
+}
+
+enum class FrameStatus
+{
+    Ready, // out_type/out_body hold a complete message
+    Partial, // fragment buffered, wait for the rest
+    Error // malformed header, unknown codec, corrupt body or fragment type mismatch
+};
+
+// Per-connection decoder: strips headers, decompresses and reassembles fragments. Legacy payloads pass through
+// with FrameType::Legacy. body points into the input payload or the internal buffer and stays valid until the next
+// call. max_bytes bounds both the decompressed size of a frame and a reassembled message.
+struct FrameDecoder
+{
+    std::string partial; // fragments received so far
+    std::string scratch; // decompression target
+    FrameType partial_type{FrameType::Legacy};
+    bool in_fragment{false};
+
+    FrameStatus decode(
+        const char *data,
+        size_t len,
+        FrameType &out_type,
+        const char *&body,
+        size_t &body_len,
+        size_t max_bytes = FRAME_MAX_MESSAGE_BYTES)
+    {
+        if (!is_headered_payload(data, len)) {
+            if (in_fragment)
+                return FrameStatus::Error;
+            out_type = FrameType::Legacy;
+            body = data;
+            body_len = len;
+            return FrameStatus::Ready;
+        }
+        FrameHeader h;
+        size_t hs = parse_frame_header(data, len, h);
+        if (hs == 0 || (in_fragment && h.type != partial_type))
+            return FrameStatus::Error;
+        const char *b = data + hs;
+        size_t bl = len - hs;
+        if (h.flags & FRAME_FLAG_COMPRESSED) {
+            if (!t2d::compress::rle_decompress(b, bl, scratch, max_bytes))
+                return FrameStatus::Error;
+            b = scratch.data();
+            bl = scratch.size();
+        }
+        if (!in_fragment && !(h.flags & FRAME_FLAG_MORE)) {
+            out_type = h.type;
+            body = b;
+            body_len = bl;
+            return FrameStatus::Ready;
+        }
+        if (partial.size() + bl > max_bytes)
+            return FrameStatus::Error;
+        if (!in_fragment) {
+            partial.clear();
+            partial_type = h.type;
+            in_fragment = true;
+        }
+        partial.append(b, bl);
+        if (h.flags & FRAME_FLAG_MORE)
+            return FrameStatus::Partial;
+        in_fragment = false;
+        out_type = partial_type;
+        body = partial.data();
+        body_len = partial.size();
+        return FrameStatus::Ready;
+    }
+};
+
+} // namespace t2d::netutil
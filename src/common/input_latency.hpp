@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+// input_latency.hpp - Client-side input-to-effect latency. Remembers when each client_tick left the client; when a
+// snapshot stamps last_input_tick (newest input the server applied before building it) the tracker records
+// now - sent_at once per acknowledged tick into a power-of-two histogram.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace t2d::netutil {
+
+class InputLatencyTracker
+{
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr size_t kWindow = 256; // in-flight ticks remembered (ring indexed by tick)
+    static constexpr int kBuckets = 14; // upper bounds 250us << i, last bucket = overflow (>1s)
+    static constexpr uint64_t kBaseUs = 250;
+
+    void on_input_sent(uint32_t tick, clock::time_point now)
+    {
+        auto &slot = m_sent[tick % kWindow];
+        slot.tick = tick;
+        slot.at = now;
+        slot.valid = true;
+    }
+
+    // Returns the latency sample in microseconds when last_input_tick acknowledges a tick sent from this client and
+    // not measured yet, otherwise -1 (0 = no input applied yet, repeated stamp, or tick older than the window).
+    int64_t on_snapshot(uint32_t last_input_tick, clock::time_point now)
+    {
+        if (last_input_tick == 0 || last_input_tick <= m_last_acked)
+            return -1;
+        const auto &slot = m_sent[last_input_tick % kWindow];
+        m_last_acked = last_input_tick;
+        if (!slot.valid || slot.tick != last_input_tick)
+            return -1;
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - slot.at).count();
+        if (us < 0)
+            us = 0;
+        record(static_cast<uint64_t>(us));
+        return us;
+    }
+
+    void record(uint64_t us)
+    {
+        int b = 0;
+        while (b < kBuckets - 1 && us >= (kBaseUs << b))
+            ++b;
+        ++m_hist[b];
+        ++m_count;
+        m_sum_us += us;
+        m_max_us = std::max(m_max_us, us);
+    }
+
+    uint64_t count() const { return m_count; }
+
+    uint64_t max_us() const { return m_max_us; }
+
+    uint64_t mean_us() const { return m_count ? m_sum_us / m_count : 0; }
+
+    // Upper bound of the bucket holding quantile q (0..1); max_us for the overflow bucket, 0 when empty.
+    uint64_t percentile_us(double q) const
+    {
+        if (m_count == 0)
+            return 0;
+        auto target = static_cast<uint64_t>(q * static_cast<double>(m_count) + 0.999999);
+        target = std::clamp<uint64_t>(target, 1, m_count);
+        uint64_t cumulative = 0;
+        for (int b = 0; b < kBuckets - 1; ++b) {
+            cumulative += m_hist[b];
+            if (cumulative >= target)
+                return std::min(kBaseUs << b, m_max_us);
+        }
+        return m_max_us;
+    }
+
+    std::string summary() const
+    {
+        char buf[160];
+        std::snprintf(
+            buf,
+            sizeof(buf),
+            "n=%llu mean=%.1fms p50<=%.1fms p90<=%.1fms p99<=%.1fms max=%.1fms",
+            static_cast<unsigned long long>(m_count),
+            mean_us() / 1000.0,
+            percentile_us(0.50) / 1000.0,
+            percentile_us(0.90) / 1000.0,
+            percentile_us(0.99) / 1000.0,
+            m_max_us / 1000.0);
+        return buf;
+    }
+
+    // Clears the histogram (e.g. per match); in-flight send times are kept.
+    void reset_stats()
+    {
+        m_hist.fill(0);
+        m_count = 0;
+        m_sum_us = 0;
+        m_max_us = 0;
+    }
+
+    // Forget everything (new connection / server restarted its tick numbering).
+    void reset()
+    {
+        reset_stats();
+        m_sent.fill({});
+        m_last_acked = 0;
+    }
+
+private:
+    struct Sent
+    {
+        uint32_t tick{0};
+        clock::time_point at{};
+        bool valid{false};
+    };
+    std::array<Sent, kWindow> m_sent{};
+    uint32_t m_last_acked{0};
+    std::array<uint64_t, kBuckets> m_hist{};
+    uint64_t m_count{0};
+    uint64_t m_sum_us{0};
+    uint64_t m_max_us{0};
+};
+
+} // namespace t2d::netutil
@@ -285,6 +285,12 @@ inline void init()
     detail::start();
 }
 
+// Background writer thread (the server names it and places it on its CPU set); not joinable before init().
+inline std::thread &writer_thread()
+{
+    return detail::g_thread;
+}
+
 inline void set_app_id(std::string id)
 {
     std::lock_guard lk(detail::g_io_mtx);
@@ -30,6 +30,17 @@ struct RuntimeCounters
     // Power-of-two buckets for tick & wait durations (base 250k ns) -> up to ~128ms.
     static constexpr int TICK_BUCKETS = 10;
     std::atomic<uint64_t> tick_hist[TICK_BUCKETS]{}; // bucket 0:<250k,1:<500k,...
+    // Per tick phase totals (input, physics, contacts, snapshot, events; see server/game/tick_phase.hpp). Hardware
+    // events (cycles, instructions, llc_misses, branch_misses, dtlb_load_misses; see server/game/tick_perf.hpp) only
+    // accumulate with perf_counters_enabled on threads where the PMU is reachable.
+    static constexpr int TICK_PHASES = 5;
+    static constexpr int TICK_PERF_EVENTS = 5;
+    std::atomic<uint64_t> tick_phase_ns[TICK_PHASES]{};
+    std::atomic<uint64_t> tick_phase_samples{0};
+    std::atomic<uint64_t> tick_phase_events[TICK_PHASES][TICK_PERF_EVENTS]{};
+    std::atomic<uint64_t> tick_phase_event_samples{0}; // ticks with hardware events
+    std::atomic<uint64_t> tick_perf_event_mask{0}; // bit per event opened on at least one thread
+    std::atomic<uint64_t> tick_perf_threads{0}; // simulation threads with an open counter group
     std::atomic<uint64_t> wait_duration_ns_accum{0};
     std::atomic<uint64_t> wait_samples{0};
     // Fine-grained wait histogram: 1ms linear buckets up to 50ms, then wider exponential-style buckets.
@@ -59,6 +70,13 @@ struct RuntimeCounters
     std::atomic<uint64_t> queue_depth{0};
     std::atomic<uint64_t> active_matches{0};
     std::atomic<uint64_t> bots_in_match{0};
+    std::atomic<uint64_t> bots_live{0}; // bot sessions handed out (queued or in a match)
+    std::atomic<uint64_t> bots_pooled{0}; // idle bot sessions waiting for reuse
+    std::atomic<uint64_t> matches_headless{0}; // matches left without a human recipient (headless_match_policy)
+    std::atomic<uint64_t> fast_forward_ticks{0}; // headless fast_forward ticks (kept out of the tick histogram)
+    std::atomic<uint64_t> fast_forward_tick_ns_total{0};
+    std::atomic<uint64_t> flight_recorder_breaches{0}; // ticks slower than flight_recorder_threshold_us
+    std::atomic<uint64_t> flight_recorder_dumps{0}; // flight records written (rate limited)
     std::atomic<uint64_t> connected_players{0};
     std::atomic<uint64_t> projectiles_active{0};
     std::atomic<uint64_t> auth_failures{0};
@@ -88,6 +106,81 @@ struct RuntimeCounters
     std::atomic<uint64_t> projectile_pool_requests{0};
     std::atomic<uint64_t> projectile_pool_hits{0};
     std::atomic<uint64_t> projectile_pool_misses{0};
+    // Per-tick event batches (TickEvents): entries batched and how each batch reached clients
+    std::atomic<uint64_t> tick_events_total{0};
+    std::atomic<uint64_t> tick_event_batches_piggybacked{0};
+    std::atomic<uint64_t> tick_event_batches_standalone{0};
+    // Fan-out messages serialized once for all recipients / frames sent from those shared encodings.
+    std::atomic<uint64_t> fanout_encodes{0};
+    std::atomic<uint64_t> fanout_frames{0};
+    // Staggered keyframes: full snapshots delivered (per client), on-demand ones and requests merged during cooldown
+    std::atomic<uint64_t> keyframes_sent{0};
+    std::atomic<uint64_t> keyframes_on_demand{0};
+    std::atomic<uint64_t> keyframe_requests_throttled{0};
+    // Bandwidth-budgeted deltas (snapshot_budget_bytes > 0): per-client frames, packed vs deferred entities,
+    // priority of what was sent (sum, x1000) and the highest priority left behind in the latest frame (x1000).
+    std::atomic<uint64_t> snapshot_budget_frames{0};
+    std::atomic<uint64_t> snapshot_budget_bytes{0};
+    std::atomic<uint64_t> snapshot_budget_entities_sent{0};
+    std::atomic<uint64_t> snapshot_budget_entities_deferred{0};
+    std::atomic<uint64_t> snapshot_budget_over_budget_frames{0}; // mandatory content alone exceeded the budget
+    std::atomic<uint64_t> snapshot_budget_priority_sent_milli{0};
+    std::atomic<uint64_t> snapshot_budget_priority_deferred_max_milli{0};
+    // Spawn-only projectile replication: projectile entries carried by deltas (spawns + re-samples) and re-samples
+    // caused by trajectory changes (ricochet, non-penetrating hit)
+    std::atomic<uint64_t> projectile_delta_entries{0};
+    std::atomic<uint64_t> projectile_resamples{0};
+    // Upstream player input: frames by encoding (compact binary vs protobuf InputCommand) and bytes incl. framing
+    std::atomic<uint64_t> input_frames_compact{0};
+    std::atomic<uint64_t> input_frames_proto{0};
+    std::atomic<uint64_t> input_bytes{0};
+    // Outbound frames sent RLE-compressed (frame header codec) and bytes saved by it
+    std::atomic<uint64_t> frames_compressed{0};
+    std::atomic<uint64_t> frame_compress_saved_bytes{0};
+    // Inbound flood protection: messages dropped by the per-connection token buckets (by class) and connections
+    // closed for sustained flooding or oversized input / heartbeat frames
+    std::atomic<uint64_t> inbound_throttled_input{0};
+    std::atomic<uint64_t> inbound_throttled_heartbeat{0};
+    std::atomic<uint64_t> inbound_throttled_control{0};
+    std::atomic<uint64_t> inbound_flood_disconnects{0};
+    // io_uring backend: submit syscalls, completions reaped, send SQEs issued, multishot recvs that ran out of
+    // provided buffers and send chains resumed after a short send (stay 0 with the default epoll backend)
+    std::atomic<uint64_t> net_uring_submits{0};
+    std::atomic<uint64_t> net_uring_cqes{0};
+    std::atomic<uint64_t> net_uring_send_sqes{0};
+    std::atomic<uint64_t> net_uring_recv_nobufs{0};
+    std::atomic<uint64_t> net_uring_short_sends{0};
+    // Coroutine frames of the per-connection send helpers served from the thread-local frame pool vs allocated
+    // (misses stop growing once every worker thread holds enough frames)
+    std::atomic<uint64_t> net_frame_pool_hits{0};
+    std::atomic<uint64_t> net_frame_pool_misses{0};
+    // TLS: completed / failed handshakes and how the record layer ended up (both directions in the kernel vs at
+    // least one direction on the userspace SSL_read / SSL_write fallback)
+    std::atomic<uint64_t> tls_handshakes{0};
+    std::atomic<uint64_t> tls_handshake_failures{0};
+    std::atomic<uint64_t> tls_ktls_offloaded{0};
+    std::atomic<uint64_t> tls_userspace{0};
+    // Input-to-effect latency on the server (microseconds; power-of-two buckets from 250us, last = overflow):
+    // input frame received -> applied by the match loop, and received -> first snapshot stamped with it
+    // (last_input_tick) drained for the socket.
+    static constexpr int INPUT_LATENCY_BUCKETS = 12;
+    static constexpr uint64_t INPUT_LATENCY_BASE_US = 250;
+    std::atomic<uint64_t> input_recv_to_apply_hist[INPUT_LATENCY_BUCKETS]{};
+    std::atomic<uint64_t> input_recv_to_apply_us_accum{0};
+    std::atomic<uint64_t> input_recv_to_apply_samples{0};
+    std::atomic<uint64_t> input_recv_to_send_hist[INPUT_LATENCY_BUCKETS]{};
+    std::atomic<uint64_t> input_recv_to_send_us_accum{0};
+    std::atomic<uint64_t> input_recv_to_send_samples{0};
+    // Outbound lanes: time a message waited in its session lane until drained for the socket (same buckets as the
+    // input latency), state messages replaced by newer state and event batches moved off replaced state messages.
+    std::atomic<uint64_t> outbound_control_queue_hist[INPUT_LATENCY_BUCKETS]{};
+    std::atomic<uint64_t> outbound_control_queue_us_accum{0};
+    std::atomic<uint64_t> outbound_control_queue_samples{0};
+    std::atomic<uint64_t> outbound_state_queue_hist[INPUT_LATENCY_BUCKETS]{};
+    std::atomic<uint64_t> outbound_state_queue_us_accum{0};
+    std::atomic<uint64_t> outbound_state_queue_samples{0};
+    std::atomic<uint64_t> outbound_state_superseded{0};
+    std::atomic<uint64_t> outbound_events_rescued{0};
     // Logging (profiling): lines per tick
     std::atomic<uint64_t> log_lines_total{0};
     std::atomic<uint64_t> log_lines_per_tick_accum{0};
@@ -163,6 +256,49 @@ inline uint64_t approx_tick_p99()
     return (base << (RuntimeCounters::TICK_BUCKETS - 1));
 }
 
+// --- Input-to-effect latency histograms ---
+inline void add_input_latency_sample(
+    std::atomic<uint64_t> *hist, std::atomic<uint64_t> &accum, std::atomic<uint64_t> &samples, uint64_t us)
+{
+    accum.fetch_add(us, std::memory_order_relaxed);
+    samples.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < RuntimeCounters::INPUT_LATENCY_BUCKETS - 1; ++i) {
+        if (us < (RuntimeCounters::INPUT_LATENCY_BASE_US << i)) {
+            hist[i].fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    hist[RuntimeCounters::INPUT_LATENCY_BUCKETS - 1].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void add_input_recv_to_apply(uint64_t us)
+{
+    auto &rt = runtime();
+    add_input_latency_sample(
+        rt.input_recv_to_apply_hist, rt.input_recv_to_apply_us_accum, rt.input_recv_to_apply_samples, us);
+}
+
+inline void add_input_recv_to_send(uint64_t us)
+{
+    auto &rt = runtime();
+    add_input_latency_sample(
+        rt.input_recv_to_send_hist, rt.input_recv_to_send_us_accum, rt.input_recv_to_send_samples, us);
+}
+
+inline void add_outbound_control_queue(uint64_t us)
+{
+    auto &rt = runtime();
+    add_input_latency_sample(
+        rt.outbound_control_queue_hist, rt.outbound_control_queue_us_accum, rt.outbound_control_queue_samples, us);
+}
+
+inline void add_outbound_state_queue(uint64_t us)
+{
+    auto &rt = runtime();
+    add_input_latency_sample(
+        rt.outbound_state_queue_hist, rt.outbound_state_queue_us_accum, rt.outbound_state_queue_samples, us);
+}
+
 // --- Off-CPU wait histogram ---
 inline void add_wait_duration(uint64_t ns)
 {
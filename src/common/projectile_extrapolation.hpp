@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// projectile_extrapolation.hpp - deterministic ballistic extrapolation shared by server (divergence check) and
+// clients (rendering). Projectiles have no damping and the world has no gravity, so between contacts a projectile
+// moves on a straight line at constant velocity; a reference sample (position + velocity at ref_tick) is enough to
+// reconstruct its position on any later tick.
+#pragma once
+#include <cstdint>
+
+namespace t2d::proj {
+
+struct Ballistic
+{
+    float x{0.f};
+    float y{0.f};
+    float vx{0.f};
+    float vy{0.f};
+    uint32_t ref_tick{0};
+};
+
+// Position at tick (ticks before ref_tick clamp to the reference sample).
+inline void extrapolate(const Ballistic &b, uint32_t tick, float tick_dt, float &x, float &y)
+{
+    float t = tick > b.ref_tick ? static_cast<float>(tick - b.ref_tick) * tick_dt : 0.f;
+    x = b.x + b.vx * t;
+    y = b.y + b.vy * t;
+}
+
+// True when the simulated state (x, y, vx, vy) at tick no longer matches the extrapolated reference: a ricochet,
+// non-penetrating hit or crate push changed the trajectory and clients need a fresh sample.
+inline bool diverged(
+    const Ballistic &b,
+    uint32_t tick,
+    float tick_dt,
+    float x,
+    float y,
+    float vx,
+    float vy,
+    float pos_tol,
+    float vel_tol)
+{
+    float dvx = vx - b.vx;
+    float dvy = vy - b.vy;
+    if (dvx * dvx + dvy * dvy > vel_tol * vel_tol)
+        return true;
+    float ex = 0.f;
+    float ey = 0.f;
+    extrapolate(b, tick, tick_dt, ex, ey);
+    float dx = x - ex;
+    float dy = y - ey;
+    return dx * dx + dy * dy > pos_tol * pos_tol;
+}
+
+} // namespace t2d::proj
@@ -1,27 +1,50 @@
 // SPDX-License-Identifier: Apache-2.0
 // rle.hpp - extremely simple run-length encoder for repetitive byte sequences (prototype level)
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace t2d::compress {
 
-inline std::string rle_compress(const std::string &in)
+// Appends the (run, byte) pairs of in[0, len) to out, even when they are longer than the input.
+inline void rle_compress_append(const char *in, size_t len, std::string &out)
 {
-    std::string out;
-    out.reserve(in.size());
     size_t i = 0;
-    while (i < in.size()) {
+    while (i < len) {
         unsigned char c = static_cast<unsigned char>(in[i]);
         size_t run = 1;
-        while (i + run < in.size() && in[i + run] == in[i] && run < 255)
+        while (i + run < len && in[i + run] == in[i] && run < 255)
             ++run;
         out.push_back(static_cast<char>(run));
         out.push_back(static_cast<char>(c));
         i += run;
     }
+}
+
+inline std::string rle_compress(const std::string &in)
+{
+    std::string out;
+    out.reserve(in.size());
+    rle_compress_append(in.data(), in.size(), out);
     if (out.size() >= in.size())
         return in; // no expansion allowed: fallback to original
     return out;
 }
 
+// Inverse of rle_compress for payloads known to be encoded (frame_header.hpp COMPRESSED flag). Returns false on a
+// malformed stream (odd length, zero run) or when the output would exceed max_out.
+inline bool rle_decompress(const char *in, size_t len, std::string &out, size_t max_out)
+{
+    out.clear();
+    if (len % 2 != 0)
+        return false;
+    for (size_t i = 0; i < len; i += 2) {
+        size_t run = static_cast<unsigned char>(in[i]);
+        if (run == 0 || out.size() + run > max_out)
+            return false;
+        out.append(run, in[i + 1]);
+    }
+    return true;
+}
+
 } // namespace t2d::compress
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// rot_angle.hpp - atan2-free orientation math on rotations kept as (cos, sin) pairs (Box2D b2Rot layout).
+// Per-entity hot loops (snapshot builders, bot AI, turret control) compare and encode orientations without calling
+// atan2: angles come from an octant reduction plus a minimax polynomial, relative orientation from dot / cross.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace t2d::math {
+
+inline constexpr float kPi = 3.14159265f;
+inline constexpr float kRadToDeg = 180.f / kPi;
+
+// atan(t) for t in [0, 1], max error ~2e-6 rad (1e-4 degrees).
+inline float atan_unit(float t)
+{
+    const float t2 = t * t;
+    return t
+        * (0.99997726f
+           + t2 * (-0.33262347f + t2 * (0.19354346f + t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+}
+
+// Angle of the vector (c, s) in radians, (-pi, pi] like std::atan2(s, c). The vector need not be unit length.
+inline float vec_rad(float c, float s)
+{
+    const float ac = std::fabs(c);
+    const float as = std::fabs(s);
+    const float hi = std::max(ac, as);
+    if (hi == 0.f)
+        return 0.f;
+    float a = atan_unit(std::min(ac, as) / hi); // first octant
+    if (as > ac)
+        a = 0.5f * kPi - a;
+    if (c < 0.f)
+        a = kPi - a;
+    return s < 0.f ? -a : a;
+}
+
+inline float vec_deg(float c, float s)
+{
+    return vec_rad(c, s) * kRadToDeg;
+}
+
+// Relative orientation of b seen from a (both (cos, sin) pairs): dot = cos(b - a), cross = sin(b - a). Signed angle
+// b - a in (-pi, pi] without wrap-around arithmetic.
+inline float rot_dot(float ac, float as, float bc, float bs)
+{
+    return ac * bc + as * bs;
+}
+
+inline float rot_cross(float ac, float as, float bc, float bs)
+{
+    return ac * bs - as * bc;
+}
+
+inline float rot_diff_rad(float ac, float as, float bc, float bs)
+{
+    return vec_rad(rot_dot(ac, as, bc, bs), rot_cross(ac, as, bc, bs));
+}
+
+// True when the direction (dx, dy) lies within the cone of half-angle acos(cos_half) around the heading (c, s).
+// Pure multiply-compare; (dx, dy) need not be normalized.
+inline bool within_cone(float c, float s, float dx, float dy, float cos_half)
+{
+    const float dot = c * dx + s * dy;
+    return dot > 0.f && dot * dot >= cos_half * cos_half * (dx * dx + dy * dy);
+}
+
+} // namespace t2d::math
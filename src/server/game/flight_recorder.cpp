@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/game/flight_recorder.hpp"
+
+#include "common/logger.hpp"
+#include "common/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace t2d::game {
+
+namespace {
+
+std::mutex g_cfg_mutex;
+FlightRecorderConfig g_cfg;
+// Dump budget shared by every match.
+std::atomic<int64_t> g_last_dump_ms{INT64_MIN};
+std::atomic<uint32_t> g_dumps{0};
+
+int64_t to_ms(std::chrono::steady_clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+}
+
+// One caller wins the slot when several matches breach at once.
+bool claim_dump(const FlightRecorderConfig &cfg, std::chrono::steady_clock::time_point now)
+{
+    const int64_t now_ms = to_ms(now);
+    int64_t last = g_last_dump_ms.load(std::memory_order_relaxed);
+    do {
+        if (last != INT64_MIN && now_ms - last < int64_t(cfg.min_interval_ms))
+            return false;
+    } while (!g_last_dump_ms.compare_exchange_weak(last, now_ms, std::memory_order_relaxed));
+    if (cfg.max_dumps > 0 && g_dumps.fetch_add(1, std::memory_order_relaxed) >= cfg.max_dumps)
+        return false;
+    return true;
+}
+
+void write_record(std::ostringstream &j, const TickRecord &r)
+{
+    j << "{\"tick\":" << r.tick << ",\"start_us\":" << r.start_us << ",\"total_ns\":" << r.total_ns;
+    for (size_t p = 0; p < kTickPhases; ++p)
+        j << ",\"" << tick_phase_name(static_cast<TickPhase>(p)) << "_ns\":" << r.phase_ns[p];
+    j << ",\"tanks_alive\":" << r.tanks_alive << ",\"projectiles\":" << r.projectiles
+      << ",\"moving_bodies\":" << r.moving_bodies << ",\"contacts\":" << r.contacts
+      << ",\"contact_begins\":" << r.contact_begins << ",\"allocations\":" << r.allocations
+      << ",\"allocated_bytes\":" << r.allocated_bytes << ",\"outbound_pending\":" << r.outbound_pending
+      << ",\"matchmaking_queue\":" << r.matchmaking_queue << ",\"governor_level\":" << r.governor_level
+      << ",\"snapshot\":" << (r.snapshot ? "true" : "false") << "}";
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(std::string match_id, uint32_t tick_rate, std::string config_json)
+    : m_cfg(flight_recorder_config()), m_match_id(std::move(match_id)), m_config_json(std::move(config_json))
+{
+    // Disabled recorders keep a single scratch slot so the match loop fills records unconditionally.
+    const uint64_t ticks = m_cfg.enabled ? uint64_t(m_cfg.history_ms) * std::max<uint32_t>(tick_rate, 1) / 1000 : 1;
+    m_ring.resize(std::max<uint64_t>(ticks, 1));
+}
+
+TickRecord &FlightRecorder::next()
+{
+    if (m_count > 0)
+        m_head = (m_head + 1) % m_ring.size();
+    m_count = std::min(m_count + 1, m_ring.size());
+    m_ring[m_head] = TickRecord{};
+    return m_ring[m_head];
+}
+
+std::optional<FlightDump> FlightRecorder::finish_tick(std::chrono::steady_clock::time_point now)
+{
+    if (!m_cfg.enabled || m_count == 0)
+        return std::nullopt;
+    const TickRecord &r = m_ring[m_head];
+    if (uint64_t(r.total_ns) <= uint64_t(m_cfg.threshold_us) * 1000)
+        return std::nullopt;
+    t2d::metrics::runtime().flight_recorder_breaches.fetch_add(1, std::memory_order_relaxed);
+    if (!claim_dump(m_cfg, now))
+        return std::nullopt;
+    t2d::metrics::runtime().flight_recorder_dumps.fetch_add(1, std::memory_order_relaxed);
+    FlightDump dump;
+    dump.path = (std::filesystem::path(m_cfg.dir) / ("flight_" + m_match_id + "_" + std::to_string(r.tick) + ".json"))
+                    .string();
+    dump.json = to_json(r);
+    return dump;
+}
+
+std::vector<TickRecord> FlightRecorder::history() const
+{
+    std::vector<TickRecord> out;
+    out.reserve(m_count);
+    const size_t first = (m_head + m_ring.size() + 1 - m_count) % m_ring.size();
+    for (size_t i = 0; i < m_count; ++i)
+        out.push_back(m_ring[(first + i) % m_ring.size()]);
+    return out;
+}
+
+std::string FlightRecorder::to_json(const TickRecord &trigger) const
+{
+    std::ostringstream j;
+    j << "{\"match_id\":\"" << m_match_id << "\",\"trigger_tick\":" << trigger.tick
+      << ",\"trigger_total_ns\":" << trigger.total_ns << ",\"threshold_us\":" << m_cfg.threshold_us
+      << ",\"config\":" << (m_config_json.empty() ? "{}" : m_config_json) << ",\"ticks\":[";
+    bool first = true;
+    for (const auto &r : history()) {
+        if (!first)
+            j << ",";
+        first = false;
+        j << "\n";
+        write_record(j, r);
+    }
+    j << "\n]}\n";
+    return j.str();
+}
+
+void configure_flight_recorder(const FlightRecorderConfig &cfg)
+{
+    std::lock_guard lk(g_cfg_mutex);
+    g_cfg = cfg;
+    g_cfg.history_ms = std::max<uint32_t>(cfg.history_ms, 1);
+    g_last_dump_ms.store(INT64_MIN, std::memory_order_relaxed);
+    g_dumps.store(0, std::memory_order_relaxed);
+}
+
+FlightRecorderConfig flight_recorder_config()
+{
+    std::lock_guard lk(g_cfg_mutex);
+    return g_cfg;
+}
+
+bool write_flight_dump(const FlightDump &dump)
+{
+    std::error_code ec;
+    const auto dir = std::filesystem::path(dump.path).parent_path();
+    if (!dir.empty())
+        std::filesystem::create_directories(dir, ec);
+    std::ofstream f(dump.path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        t2d::log::warn("[flight] cannot write {}", dump.path);
+        return false;
+    }
+    f << dump.json;
+    f.close();
+    if (!f) {
+        t2d::log::warn("[flight] write failed {}", dump.path);
+        return false;
+    }
+    t2d::log::info("[flight] slow tick recorded to {}", dump.path);
+    return true;
+}
+
+void write_flight_dump_async(FlightDump dump)
+{
+    std::thread([d = std::move(dump)] { write_flight_dump(d); }).detach();
+}
+
+} // namespace t2d::game
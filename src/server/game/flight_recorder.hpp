@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+// flight_recorder.hpp - always-on tick history per match. Every match keeps its last history_ms of tick records
+// (phase timings, entity and contact counts, allocation deltas, queue depths) in a ring preallocated at match start.
+// A tick slower than threshold_us turns the ring into a JSON file with the match id and configuration, written off the
+// tick thread. A slow tick in production then leaves a record of what the match was doing before and during it,
+// instead of one more sample in the tick histogram.
+//
+// Dumps are rate limited process-wide (min_interval_ms between two dumps, at most max_dumps per run), so a server
+// that is slow across the board writes a few files, not one per match per tick.
+#pragma once
+#include "server/game/tick_phase.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace t2d::game {
+
+struct FlightRecorderConfig
+{
+    bool enabled{true};
+    uint32_t threshold_us{20000}; // tick duration that triggers a dump
+    uint32_t history_ms{5000}; // ticks kept per match
+    uint32_t min_interval_ms{60000}; // between two dumps (any match)
+    uint32_t max_dumps{100}; // per process run, 0 = unlimited
+    std::string dir{"flight_records"};
+};
+
+struct TickRecord
+{
+    uint64_t tick{0};
+    int64_t start_us{0}; // steady clock, same clock as snapshot server_time_us
+    uint32_t total_ns{0};
+    std::array<uint32_t, kTickPhases> phase_ns{};
+    uint32_t tanks_alive{0};
+    uint32_t projectiles{0};
+    uint32_t moving_bodies{0}; // bodies Box2D moved in the step (awake)
+    uint32_t contacts{0}; // contacts (shape pairs with overlapping bounds, touching or not) after the step
+    uint32_t contact_begins{0}; // contacts that started touching in the step
+    uint32_t allocations{0}; // heap allocations during the tick (profiling builds count them; 0 otherwise)
+    uint64_t allocated_bytes{0};
+    uint32_t outbound_pending{0}; // messages queued for the match's humans at the end of the tick
+    uint32_t matchmaking_queue{0}; // players waiting in the matchmaking queue
+    uint32_t governor_level{0};
+    bool snapshot{false}; // snapshot tick
+};
+
+struct FlightDump
+{
+    std::string path;
+    std::string json;
+};
+
+// Not thread-safe; owned by the match loop.
+class FlightRecorder
+{
+public:
+    // config_json: JSON object describing the match setup, copied into every dump.
+    FlightRecorder(std::string match_id, uint32_t tick_rate, std::string config_json);
+
+    bool enabled() const { return m_cfg.enabled; }
+    size_t capacity() const { return m_ring.size(); }
+
+    // Cleared slot for the current tick; fill it while the tick runs, then call finish_tick.
+    TickRecord &next();
+    // Returns the dump to write when the tick just recorded took longer than threshold_us and the process-wide dump
+    // budget allows one.
+    std::optional<FlightDump> finish_tick(std::chrono::steady_clock::time_point now);
+
+    // Recorded ticks, oldest first.
+    std::vector<TickRecord> history() const;
+    std::string to_json(const TickRecord &trigger) const;
+
+private:
+    FlightRecorderConfig m_cfg;
+    std::string m_match_id;
+    std::string m_config_json;
+    std::vector<TickRecord> m_ring;
+    size_t m_head{0}; // slot of the current tick
+    size_t m_count{0};
+};
+
+// Process-wide settings and dump budget (call once at startup; also resets the budget).
+void configure_flight_recorder(const FlightRecorderConfig &cfg);
+FlightRecorderConfig flight_recorder_config();
+
+// Writes the dump (creating its directory); false on I/O failure.
+bool write_flight_dump(const FlightDump &dump);
+// Same on a detached thread, so the match does not wait for the disk right after a slow tick.
+void write_flight_dump_async(FlightDump dump);
+
+} // namespace t2d::game
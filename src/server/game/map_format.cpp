@@ -0,0 +1,366 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/game/map_format.hpp"
+
+#include "common/logger.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace t2d::map {
+
+namespace {
+
+bool fail(std::string *error, const char *reason)
+{
+    if (error)
+        *error = reason;
+    return false;
+}
+
+// Checks that [offset, offset + count * elem) lies inside the image and is 4-byte aligned.
+bool section_ok(uint32_t offset, uint64_t count, size_t elem, size_t size)
+{
+    if (offset % 4 != 0)
+        return false;
+    uint64_t end = static_cast<uint64_t>(offset) + count * static_cast<uint64_t>(elem);
+    return end <= size;
+}
+
+template <typename T>
+std::span<const T> section(const uint8_t *base, uint32_t offset, uint32_t count)
+{
+    return {reinterpret_cast<const T *>(base + offset), count};
+}
+
+bool is_wall(const MapSource &src, int tx, int ty)
+{
+    // Outside the grid counts as wall so the playable area is always closed by a boundary loop.
+    if (tx < 0 || ty < 0 || tx >= src.tiles_x || ty >= src.tiles_y)
+        return true;
+    return src.tiles[static_cast<size_t>(ty) * src.tiles_x + tx] != TILE_FLOOR;
+}
+
+struct GridEdge
+{
+    int x0, y0, x1, y1;
+};
+
+// Traces floor/wall boundaries into closed loops (floor on the right of travel direction) and drops collinear
+// vertices so every straight wall run becomes a single chain segment.
+std::vector<std::vector<std::pair<int, int>>> trace_loops(const MapSource &src)
+{
+    std::vector<GridEdge> edges;
+    for (int ty = 0; ty < src.tiles_y; ++ty) {
+        for (int tx = 0; tx < src.tiles_x; ++tx) {
+            if (is_wall(src, tx, ty))
+                continue;
+            if (is_wall(src, tx, ty - 1))
+                edges.push_back({tx + 1, ty, tx, ty});
+            if (is_wall(src, tx, ty + 1))
+                edges.push_back({tx, ty + 1, tx + 1, ty + 1});
+            if (is_wall(src, tx - 1, ty))
+                edges.push_back({tx, ty, tx, ty + 1});
+            if (is_wall(src, tx + 1, ty))
+                edges.push_back({tx + 1, ty + 1, tx + 1, ty});
+        }
+    }
+    auto key = [](int x, int y)
+    { return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y); };
+    std::unordered_map<uint64_t, std::vector<size_t>> outgoing;
+    outgoing.reserve(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+        outgoing[key(edges[i].x0, edges[i].y0)].push_back(i);
+    std::vector<bool> used(edges.size(), false);
+    std::vector<std::vector<std::pair<int, int>>> loops;
+    for (size_t start = 0; start < edges.size(); ++start) {
+        if (used[start])
+            continue;
+        std::vector<std::pair<int, int>> pts;
+        size_t cur = start;
+        while (!used[cur]) {
+            used[cur] = true;
+            const auto &e = edges[cur];
+            pts.emplace_back(e.x0, e.y0);
+            const auto &cands = outgoing[key(e.x1, e.y1)];
+            // Diagonal pinch points have two outgoing edges; prefer the left turn (around the wall tile) so each wall
+            // block closes into its own loop instead of one self-touching outline.
+            int dx = e.x1 - e.x0, dy = e.y1 - e.y0;
+            size_t next = SIZE_MAX;
+            int best = 2;
+            for (size_t c : cands) {
+                if (used[c])
+                    continue;
+                int ndx = edges[c].x1 - edges[c].x0, ndy = edges[c].y1 - edges[c].y0;
+                int cross = dx * ndy - dy * ndx; // >0 left, 0 straight, <0 right
+                int rank = cross > 0 ? 0 : (cross == 0 ? 1 : 2);
+                if (next == SIZE_MAX || rank < best) {
+                    next = c;
+                    best = rank;
+                }
+            }
+            if (next == SIZE_MAX)
+                break;
+            cur = next;
+        }
+        // Remove collinear vertices (including the wrap-around seam).
+        std::vector<std::pair<int, int>> merged;
+        const size_t n = pts.size();
+        for (size_t i = 0; i < n; ++i) {
+            auto &p = pts[(i + n - 1) % n];
+            auto &c = pts[i];
+            auto &q = pts[(i + 1) % n];
+            int cross = (c.first - p.first) * (q.second - c.second) - (c.second - p.second) * (q.first - c.first);
+            if (cross != 0)
+                merged.push_back(c);
+        }
+        if (merged.size() >= 4)
+            loops.push_back(std::move(merged));
+    }
+    return loops;
+}
+
+// Multi-source BFS (8-connected) from wall tiles and the map border; value = Chebyshev distance capped at 255.
+std::vector<uint8_t> compute_clearance(const MapSource &src)
+{
+    const int w = src.tiles_x, h = src.tiles_y;
+    std::vector<uint8_t> nav(static_cast<size_t>(w) * h, 255);
+    std::deque<int> q;
+    for (int ty = 0; ty < h; ++ty) {
+        for (int tx = 0; tx < w; ++tx) {
+            size_t i = static_cast<size_t>(ty) * w + tx;
+            if (is_wall(src, tx, ty)) {
+                nav[i] = 0;
+                q.push_back(static_cast<int>(i));
+            } else if (tx == 0 || ty == 0 || tx == w - 1 || ty == h - 1) {
+                nav[i] = 1;
+                q.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    while (!q.empty()) {
+        int i = q.front();
+        q.pop_front();
+        int tx = i % w, ty = i / w;
+        uint8_t nd = nav[i] == 255 ? 255 : static_cast<uint8_t>(nav[i] + 1);
+        for (int oy = -1; oy <= 1; ++oy) {
+            for (int ox = -1; ox <= 1; ++ox) {
+                int nx = tx + ox, ny = ty + oy;
+                if ((ox == 0 && oy == 0) || nx < 0 || ny < 0 || nx >= w || ny >= h)
+                    continue;
+                size_t j = static_cast<size_t>(ny) * w + nx;
+                if (nav[j] > nd) {
+                    nav[j] = nd;
+                    q.push_back(static_cast<int>(j));
+                }
+            }
+        }
+    }
+    return nav;
+}
+
+template <typename T>
+void append_pod(std::string &out, const T *data, size_t count)
+{
+    if (count == 0)
+        return;
+    const size_t at = out.size();
+    out.resize(at + sizeof(T) * count);
+    std::memcpy(out.data() + at, data, sizeof(T) * count);
+}
+
+void pad4(std::string &out)
+{
+    while (out.size() % 4 != 0)
+        out.push_back('\0');
+}
+
+} // namespace
+
+uint8_t MapView::clearance_at(float x, float y) const
+{
+    if (!header || nav.empty() || header->tile_size <= 0.f)
+        return 0;
+    float fx = (x + header->width * 0.5f) / header->tile_size;
+    float fy = (y + header->height * 0.5f) / header->tile_size;
+    if (fx < 0.f || fy < 0.f)
+        return 0;
+    auto tx = static_cast<uint32_t>(fx);
+    auto ty = static_cast<uint32_t>(fy);
+    if (tx >= header->tiles_x || ty >= header->tiles_y)
+        return 0;
+    return nav[static_cast<size_t>(ty) * header->tiles_x + tx];
+}
+
+bool parse_map(const void *data, size_t size, MapView &out, std::string *error)
+{
+    if (!data || size < sizeof(MapHeader))
+        return fail(error, "truncated header");
+    const auto *base = static_cast<const uint8_t *>(data);
+    if (reinterpret_cast<uintptr_t>(base) % alignof(MapHeader) != 0)
+        return fail(error, "misaligned image");
+    const auto *h = reinterpret_cast<const MapHeader *>(base);
+    if (h->magic != kMapMagic)
+        return fail(error, "bad magic");
+    if (h->version != kMapVersion)
+        return fail(error, "unsupported version");
+    if (h->file_size != size)
+        return fail(error, "size mismatch");
+    if (!(h->tile_size > 0.f) || h->tiles_x == 0 || h->tiles_y == 0)
+        return fail(error, "empty tile grid");
+    const uint64_t cells = static_cast<uint64_t>(h->tiles_x) * h->tiles_y;
+    if (!section_ok(h->tiles_offset, cells, 1, size) || !section_ok(h->nav_offset, cells, 1, size)
+        || !section_ok(h->chains_offset, h->chain_count, sizeof(ChainRecord), size)
+        || !section_ok(h->points_offset, h->point_count, sizeof(MapPoint), size)
+        || !section_ok(h->spawns_offset, h->spawn_count, sizeof(SpawnPoint), size)
+        || !section_ok(h->crates_offset, h->crate_count, sizeof(CratePlacement), size)
+        || !section_ok(h->ammo_offset, h->ammo_count, sizeof(AmmoPlacement), size))
+        return fail(error, "section out of bounds");
+    MapView v;
+    v.header = h;
+    v.tiles = section<uint8_t>(base, h->tiles_offset, static_cast<uint32_t>(cells));
+    v.chains = section<ChainRecord>(base, h->chains_offset, h->chain_count);
+    v.points = section<MapPoint>(base, h->points_offset, h->point_count);
+    v.spawns = section<SpawnPoint>(base, h->spawns_offset, h->spawn_count);
+    v.crates = section<CratePlacement>(base, h->crates_offset, h->crate_count);
+    v.ammo = section<AmmoPlacement>(base, h->ammo_offset, h->ammo_count);
+    v.nav = section<uint8_t>(base, h->nav_offset, static_cast<uint32_t>(cells));
+    for (const auto &c : v.chains) {
+        // Box2D requires at least 4 points for a loop chain.
+        if (c.point_count < 4 || static_cast<uint64_t>(c.first_point) + c.point_count > h->point_count)
+            return fail(error, "bad chain record");
+    }
+    out = v;
+    return true;
+}
+
+MappedMap::~MappedMap()
+{
+    if (m_base)
+        ::munmap(m_base, m_size);
+}
+
+std::shared_ptr<const MappedMap> MappedMap::open(const std::string &path, std::string *error)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        fail(error, "open failed");
+        return nullptr;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(MapHeader))) {
+        ::close(fd);
+        fail(error, "truncated header");
+        return nullptr;
+    }
+    const auto size = static_cast<size_t>(st.st_size);
+    // MAP_POPULATE pre-faults the (small) image so the first match does not take page faults on the tick path.
+    void *base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        fail(error, "mmap failed");
+        return nullptr;
+    }
+    std::shared_ptr<MappedMap> m(new MappedMap());
+    m->m_base = base;
+    m->m_size = size;
+    m->m_path = path;
+    if (!parse_map(base, size, m->m_view, error))
+        return nullptr; // destructor unmaps
+    return m;
+}
+
+std::shared_ptr<const MappedMap> load_shared_map(const std::string &path)
+{
+    static std::mutex mtx;
+    static std::unordered_map<std::string, std::weak_ptr<const MappedMap>> cache;
+    std::scoped_lock lk(mtx);
+    if (auto it = cache.find(path); it != cache.end()) {
+        if (auto sp = it->second.lock())
+            return sp;
+    }
+    std::string err;
+    auto m = MappedMap::open(path, &err);
+    if (!m) {
+        t2d::log::warn("[map] load failed path={} reason={}", path, err);
+        return nullptr;
+    }
+    const auto &v = m->view();
+    t2d::log::info(
+        "[map] loaded path={} bytes={} size={}x{} tiles={}x{} chains={} points={} spawns={} crates={} ammo={}",
+        path,
+        m->size_bytes(),
+        v.width(),
+        v.height(),
+        v.header->tiles_x,
+        v.header->tiles_y,
+        v.chains.size(),
+        v.points.size(),
+        v.spawns.size(),
+        v.crates.size(),
+        v.ammo.size());
+    cache[path] = m;
+    return m;
+}
+
+std::string compile_map(const MapSource &src)
+{
+    if (src.tiles_x == 0 || src.tiles_y == 0 || !(src.tile_size > 0.f)
+        || src.tiles.size() != static_cast<size_t>(src.tiles_x) * src.tiles_y)
+        return {};
+    MapHeader h{};
+    h.magic = kMapMagic;
+    h.version = kMapVersion;
+    h.tile_size = src.tile_size;
+    h.tiles_x = src.tiles_x;
+    h.tiles_y = src.tiles_y;
+    h.width = src.tile_size * static_cast<float>(src.tiles_x);
+    h.height = src.tile_size * static_cast<float>(src.tiles_y);
+    const float ox = -h.width * 0.5f;
+    const float oy = -h.height * 0.5f;
+    std::vector<ChainRecord> chains;
+    std::vector<MapPoint> points;
+    for (const auto &loop : trace_loops(src)) {
+        chains.push_back({static_cast<uint32_t>(points.size()), static_cast<uint32_t>(loop.size()), 1u});
+        for (auto [gx, gy] : loop) {
+            points.push_back(
+                {ox + static_cast<float>(gx) * src.tile_size, oy + static_cast<float>(gy) * src.tile_size});
+        }
+    }
+    auto nav = compute_clearance(src);
+    h.chain_count = static_cast<uint32_t>(chains.size());
+    h.point_count = static_cast<uint32_t>(points.size());
+    h.spawn_count = static_cast<uint32_t>(src.spawns.size());
+    h.crate_count = static_cast<uint32_t>(src.crates.size());
+    h.ammo_count = static_cast<uint32_t>(src.ammo.size());
+
+    std::string out(sizeof(MapHeader), '\0');
+    h.tiles_offset = static_cast<uint32_t>(out.size());
+    append_pod(out, src.tiles.data(), src.tiles.size());
+    pad4(out);
+    h.chains_offset = static_cast<uint32_t>(out.size());
+    append_pod(out, chains.data(), chains.size());
+    h.points_offset = static_cast<uint32_t>(out.size());
+    append_pod(out, points.data(), points.size());
+    h.spawns_offset = static_cast<uint32_t>(out.size());
+    append_pod(out, src.spawns.data(), src.spawns.size());
+    h.crates_offset = static_cast<uint32_t>(out.size());
+    append_pod(out, src.crates.data(), src.crates.size());
+    h.ammo_offset = static_cast<uint32_t>(out.size());
+    append_pod(out, src.ammo.data(), src.ammo.size());
+    h.nav_offset = static_cast<uint32_t>(out.size());
+    append_pod(out, nav.data(), nav.size());
+    pad4(out);
+    h.file_size = static_cast<uint32_t>(out.size());
+    std::memcpy(out.data(), &h, sizeof(h));
+    return out;
+}
+
+} // namespace t2d::map
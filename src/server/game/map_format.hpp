@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+// map_format.hpp - Static tile map binary format (mmap loaded, shared read-only across matches)
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace t2d::map {
+
+// On-disk layout (little-endian, every section 4-byte aligned):
+//   MapHeader | tiles[u8 tiles_x*tiles_y] | ChainRecord[] | MapPoint[] | SpawnPoint[] | CratePlacement[] |
+//   AmmoPlacement[] | nav[u8 tiles_x*tiles_y]
+// Tiles and nav cells are row-major with row 0 at the bottom (min Y). The map is centered at the origin, so tile
+// (tx, ty) covers x in [-width/2 + tx*tile_size, -width/2 + (tx+1)*tile_size) and likewise for y.
+// Chains are closed loops already merged from the tile grid by the compiler. Box2D chains are one-sided, so every
+// loop is wound with the walkable area on the RIGHT of the travel direction (outer boundary clockwise, obstacles
+// counter-clockwise); the server feeds them to b2CreateChain without any per-match processing.
+inline constexpr uint32_t kMapMagic = 0x4D443254u; // "T2DM"
+inline constexpr uint16_t kMapVersion = 1;
+
+enum TileKind : uint8_t
+{
+    TILE_FLOOR = 0,
+    TILE_WALL = 1
+};
+
+struct MapHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags; // reserved (0)
+    float width;
+    float height;
+    float tile_size;
+    uint16_t tiles_x;
+    uint16_t tiles_y;
+    uint32_t chain_count;
+    uint32_t point_count;
+    uint32_t spawn_count;
+    uint32_t crate_count;
+    uint32_t ammo_count;
+    uint32_t tiles_offset;
+    uint32_t chains_offset;
+    uint32_t points_offset;
+    uint32_t spawns_offset;
+    uint32_t crates_offset;
+    uint32_t ammo_offset;
+    uint32_t nav_offset;
+    uint32_t file_size;
+    uint32_t reserved;
+};
+
+struct ChainRecord
+{
+    uint32_t first_point;
+    uint32_t point_count;
+    uint32_t flags; // bit0 = loop (always set by the compiler)
+};
+
+struct MapPoint
+{
+    float x;
+    float y;
+};
+
+struct SpawnPoint
+{
+    float x;
+    float y;
+    float angle_deg;
+};
+
+struct CratePlacement
+{
+    float x;
+    float y;
+    float half_extent;
+};
+
+struct AmmoPlacement
+{
+    float x;
+    float y;
+    float radius;
+};
+
+static_assert(sizeof(MapHeader) == 80, "MapHeader layout is part of the file format");
+static_assert(sizeof(ChainRecord) == 12 && sizeof(MapPoint) == 8 && sizeof(SpawnPoint) == 12);
+static_assert(sizeof(CratePlacement) == 12 && sizeof(AmmoPlacement) == 12);
+
+// Non-owning typed view over a validated map image (points straight into the mapping; no copies).
+struct MapView
+{
+    const MapHeader *header{nullptr};
+    std::span<const uint8_t> tiles;
+    std::span<const ChainRecord> chains;
+    std::span<const MapPoint> points;
+    std::span<const SpawnPoint> spawns;
+    std::span<const CratePlacement> crates;
+    std::span<const AmmoPlacement> ammo;
+    // Precomputed clearance grid: 0 = blocked, N = Chebyshev distance (in cells) to the nearest wall, capped at 255.
+    std::span<const uint8_t> nav;
+
+    float width() const { return header->width; }
+
+    float height() const { return header->height; }
+
+    std::span<const MapPoint> chain_points(const ChainRecord &c) const
+    {
+        return points.subspan(c.first_point, c.point_count);
+    }
+
+    // World position -> nav clearance (0 when outside the map or blocked).
+    uint8_t clearance_at(float x, float y) const;
+};
+
+// Validates a raw image and fills `out`. Returns false (with reason in *error) on any structural problem.
+bool parse_map(const void *data, size_t size, MapView &out, std::string *error = nullptr);
+
+// Read-only memory mapping of a map file. Immutable after open(); safe to share across match coroutines.
+class MappedMap
+{
+public:
+    static std::shared_ptr<const MappedMap> open(const std::string &path, std::string *error = nullptr);
+    ~MappedMap();
+    MappedMap(const MappedMap &) = delete;
+    MappedMap &operator=(const MappedMap &) = delete;
+
+    const MapView &view() const { return m_view; }
+
+    const std::string &path() const { return m_path; }
+
+    size_t size_bytes() const { return m_size; }
+
+private:
+    MappedMap() = default;
+    void *m_base{nullptr};
+    size_t m_size{0};
+    std::string m_path;
+    MapView m_view;
+};
+
+// Process-wide cache keyed by path: every match using the same map shares one mapping. Entries are weak so a map
+// is unmapped once the last holder (matchmaker / running matches) releases it. Returns nullptr on load failure.
+std::shared_ptr<const MappedMap> load_shared_map(const std::string &path);
+
+// Authoring-side description consumed by compile_map (used by t2d_map_compile and tests).
+struct MapSource
+{
+    float tile_size{4.f};
+    uint16_t tiles_x{0};
+    uint16_t tiles_y{0};
+    std::vector<uint8_t> tiles; // row-major, row 0 = bottom
+    std::vector<SpawnPoint> spawns;
+    std::vector<CratePlacement> crates;
+    std::vector<AmmoPlacement> ammo;
+};
+
+// Merges wall tiles into chain loops, computes the nav clearance grid and serializes the binary image.
+// Returns an empty string if the source is malformed (tile vector size mismatch / empty grid).
+std::string compile_map(const MapSource &src);
+
+} // namespace t2d::map
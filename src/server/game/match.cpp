@@ -1,17 +1,21 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "server/game/match.hpp"
 
+#include "common/clock_sync.hpp"
 #include "common/log_rate_limit.hpp"
 #include "common/logger.hpp"
 #include "common/metrics.hpp"
+#include "common/rot_angle.hpp"
+#include "server/game/flight_recorder.hpp"
 #include "server/game/physics.hpp"
 #include "server/game/snapshot_compress.hpp"
+#include "server/game/tick_perf.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <random>
+#include <sstream>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace {
 
@@ -272,17 +276,14 @@ static void process_contacts(
                 tank.hp = 0;
             else
                 tank.hp -= damage_amount;
-            t2d::ServerMessage evmsg;
-            auto *d = evmsg.mutable_damage();
+            auto *d = ctx.tick_events.add_damage();
             d->set_victim_id(tank.entity_id);
             d->set_attacker_id(proj.owner);
             d->set_amount(damage_amount);
             d->set_remaining_hp(tank.hp);
-            for (auto &pl : ctx.players)
-                t2d::mm::instance().push_message(pl, evmsg);
             if (before > 0 && tank.hp == 0) {
                 if (!ctx.persist_destroyed_tanks) {
-                    ctx.removed_tanks_since_full.push_back(tank.entity_id);
+                    ctx.removed_tanks_since_full.push_back({tank.entity_id, static_cast<uint32_t>(ctx.server_tick)});
                     // Destroy physics bodies immediately so they no longer collide / cost simulation time
                     if (b2Body_IsValid(tank.hull)) {
                         t2d::phys::destroy_body(tank.hull);
@@ -304,12 +305,9 @@ static void process_contacts(
                     }
                 }
                 ctx.kill_feed_events.emplace_back(tank.entity_id, proj.owner);
-                t2d::ServerMessage tdmsg;
-                auto *td = tdmsg.mutable_destroyed();
+                auto *td = ctx.tick_events.add_destroyed();
                 td->set_victim_id(tank.entity_id);
                 td->set_attacker_id(proj.owner);
-                for (auto &pl : ctx.players)
-                    t2d::mm::instance().push_message(pl, tdmsg);
             }
         }
         auto body_it = projectile_bodies.find(proj_id);
@@ -320,7 +318,7 @@ static void process_contacts(
                 projectile_bodies.erase(body_it);
             }
         }
-        ctx.removed_projectiles_since_full.push_back(proj_id);
+        ctx.removed_projectiles_since_full.push_back({proj_id, static_cast<uint32_t>(ctx.server_tick)});
         ctx.projectile_indices.erase(pit_idx);
     }
     for (auto pid : to_destroy_projectiles) {
@@ -333,10 +331,295 @@ static void process_contacts(
         }
     }
 }
+
+// Registers a crate and tags its body with index + 1 so body move events map back to it (see sync_moved_crates).
+static void add_crate(t2d::game::MatchContext &ctx, b2BodyId body, float x, float y)
+{
+    b2Body_SetUserData(body, reinterpret_cast<void *>(static_cast<uintptr_t>(ctx.crates.size() + 1)));
+    ctx.crates.push_back({ctx.next_crate_id++, body, x, y});
+}
+
+// Mirrors the transforms of the crates Box2D moved in the last step. Move events only cover awake bodies (the last
+// one carries fellAsleep), so replication never reads back a sleeping crate.
+static void sync_moved_crates(t2d::game::MatchContext &ctx, b2WorldId world)
+{
+    const b2BodyEvents events = b2World_GetBodyEvents(world);
+    for (int i = 0; i < events.moveCount; ++i) {
+        const b2BodyMoveEvent &ev = events.moveEvents[i];
+        const auto tag = reinterpret_cast<uintptr_t>(ev.userData);
+        if (tag == 0 || tag > ctx.crates.size())
+            continue; // tanks, projectiles
+        auto &cr = ctx.crates[tag - 1];
+        cr.x = ev.transform.p.x;
+        cr.y = ev.transform.p.y;
+        cr.angle_deg = t2d::math::vec_deg(ev.transform.q.c, ev.transform.q.s);
+        cr.moved = true;
+    }
+}
+
+// Bots receive no snapshots, so they take no part in keyframe planning.
+static bool is_bot_slot(const t2d::game::MatchContext &ctx, size_t i)
+{
+    return i < ctx.players.size() && ctx.players[i]->is_bot;
+}
+
+// Oldest keyframe any client still builds on: state changed at or after it may not have reached every client yet.
+static uint32_t keyframe_horizon(const t2d::game::MatchContext &ctx)
+{
+    uint32_t horizon = static_cast<uint32_t>(ctx.server_tick);
+    for (size_t i = 0; i < ctx.client_keyframes.size(); ++i) {
+        if (!is_bot_slot(ctx, i))
+            horizon = std::min(horizon, ctx.client_keyframes[i].last_full_tick);
+    }
+    return horizon;
+}
+
+// Decides which clients receive a keyframe (full snapshot) on this snapshot tick: their staggered phase came up or
+// they asked for one (at most once per keyframe_request_cooldown_ticks). Returns {any_full, any_delta} over the human
+// clients; bots are never due.
+static std::pair<bool, bool> plan_keyframes(t2d::game::MatchContext &ctx)
+{
+    const uint32_t tick = static_cast<uint32_t>(ctx.server_tick);
+    const uint32_t interval = std::max<uint32_t>(1, ctx.full_snapshot_interval_ticks);
+    const size_t n = ctx.players.size();
+    if (ctx.client_keyframes.size() < n) {
+        // Everyone starts from the match-start baseline; offset the first periodic keyframe by player index so the
+        // phases spread evenly over the interval (all zero when staggering is disabled).
+        size_t first = ctx.client_keyframes.size();
+        ctx.client_keyframes.resize(n);
+        for (size_t i = first; i < n; ++i) {
+            uint32_t offset = ctx.keyframe_stagger ? static_cast<uint32_t>(i * interval / n) : 0;
+            ctx.client_keyframes[i].last_full_tick = ctx.last_full_snapshot_tick;
+            ctx.client_keyframes[i].next_full_tick = ctx.last_full_snapshot_tick + interval - offset;
+        }
+    }
+    auto &rt = t2d::metrics::runtime();
+    t2d::mm::instance().consume_keyframe_requests(ctx.players, ctx.keyframe_requests);
+    for (size_t i : ctx.keyframe_requests) {
+        auto &kf = ctx.client_keyframes[i];
+        if (kf.request_pending)
+            rt.keyframe_requests_throttled.fetch_add(1, std::memory_order_relaxed);
+        kf.request_pending = true;
+    }
+    bool any_full = false;
+    bool any_delta = false;
+    for (size_t i = 0; i < n; ++i) {
+        auto &kf = ctx.client_keyframes[i];
+        if (ctx.players[i]->is_bot) {
+            kf.due = false;
+            continue;
+        }
+        kf.due = tick >= kf.next_full_tick;
+        if (kf.request_pending
+            && (kf.last_request_tick == 0 || tick - kf.last_request_tick >= ctx.keyframe_request_cooldown_ticks)) {
+            kf.request_pending = false;
+            kf.last_request_tick = tick;
+            if (!kf.due)
+                rt.keyframes_on_demand.fetch_add(1, std::memory_order_relaxed);
+            kf.due = true;
+        }
+        any_full |= kf.due;
+        any_delta |= !kf.due;
+    }
+    return {any_full, any_delta};
+}
+
+// Keyframe recipients now build on this tick: advance their periodic phase, clear their priority accumulators and
+// drop removal records every client has already seen reflected in a keyframe.
+static void finish_keyframes(t2d::game::MatchContext &ctx)
+{
+    const uint32_t tick = static_cast<uint32_t>(ctx.server_tick);
+    const uint32_t interval = std::max<uint32_t>(1, ctx.full_snapshot_interval_ticks);
+    uint32_t horizon = tick;
+    for (size_t i = 0; i < ctx.client_keyframes.size(); ++i) {
+        auto &kf = ctx.client_keyframes[i];
+        if (kf.due) {
+            kf.last_full_tick = tick;
+            while (kf.next_full_tick <= tick)
+                kf.next_full_tick += interval;
+            if (i < ctx.client_priority.size())
+                ctx.client_priority[i].reset();
+            kf.due = false;
+        }
+        if (!is_bot_slot(ctx, i))
+            horizon = std::min(horizon, kf.last_full_tick);
+    }
+    auto seen = [horizon](const t2d::game::MatchContext::RemovedEntity &r) { return r.tick < horizon; };
+    std::erase_if(ctx.removed_projectiles_since_full, seen);
+    std::erase_if(ctx.removed_tanks_since_full, seen);
+    std::erase_if(ctx.removed_crates_since_full, seen);
+}
+
+// Writes the replicated ballistic sample (not the current position) so every client extrapolates the same
+// trajectory no matter which message carried it.
+static void write_projectile(t2d::ProjectileState *ps, const t2d::game::MatchContext::ProjectileSimple &p)
+{
+    ps->set_projectile_id(p.id);
+#if T2D_ENABLE_SNAPSHOT_QUANT
+    constexpr float POS_SCALE = 100.f;
+    ps->set_x(std::round(p.repl.x * POS_SCALE) / POS_SCALE);
+    ps->set_y(std::round(p.repl.y * POS_SCALE) / POS_SCALE);
+    ps->set_vx(p.repl.vx); // velocities left unquantized for now
+    ps->set_vy(p.repl.vy);
+#else
+    ps->set_x(p.repl.x);
+    ps->set_y(p.repl.y);
+    ps->set_vx(p.repl.vx);
+    ps->set_vy(p.repl.vy);
+#endif
+    ps->set_ref_tick(p.repl.ref_tick);
+}
+
+// Sends the shared delta to every client not receiving a keyframe this tick, grouped by the keyframe tick each
+// client builds on (base_tick differs per stagger phase).
+static void send_deltas_by_base(t2d::game::MatchContext &ctx, t2d::ServerMessage &sm)
+{
+    auto *delta = sm.mutable_delta_snapshot();
+    std::vector<std::shared_ptr<t2d::mm::Session>> group;
+    std::vector<uint8_t> sent(ctx.players.size(), 0);
+    for (size_t i = 0; i < ctx.players.size(); ++i) {
+        if (sent[i] || ctx.client_keyframes[i].due || ctx.players[i]->is_bot)
+            continue;
+        const uint32_t base = ctx.client_keyframes[i].last_full_tick;
+        group.clear();
+        for (size_t j = i; j < ctx.players.size(); ++j) {
+            const auto &kf = ctx.client_keyframes[j];
+            if (!sent[j] && !kf.due && kf.last_full_tick == base && !ctx.players[j]->is_bot) {
+                sent[j] = 1;
+                group.push_back(ctx.players[j]);
+            }
+        }
+        delta->set_base_tick(base);
+        t2d::mm::instance().push_message_all(group, sm);
+    }
+}
+
+// Encoded size of a repeated message entry inside its parent: field tag + length varint + payload.
+static uint32_t entry_bytes(const google::protobuf::MessageLite &m)
+{
+    size_t n = m.ByteSizeLong();
+    size_t len_bytes = 1;
+    for (size_t v = n >> 7; v != 0; v >>= 7)
+        ++len_bytes;
+    return static_cast<uint32_t>(1 + len_bytes + n);
+}
+
+// Budgeted fan-out: the shared delta holds every live entity (candidate table, see ctx.priority_items). Each human
+// client not taking a keyframe this tick receives the mandatory part (header, removals, tick events) plus the
+// entries its priority accumulator packs into the remaining budget; deferred entities keep accumulating and go out
+// in a later frame.
+static void send_budgeted_deltas(t2d::game::MatchContext &ctx, const t2d::DeltaSnapshot &shared)
+{
+    using t2d::game::ReplKind;
+    t2d::ServerMessage base;
+    auto *bd = base.mutable_delta_snapshot();
+    bd->set_server_tick(shared.server_tick());
+    bd->set_server_time_us(shared.server_time_us());
+    bd->set_base_tick(shared.base_tick());
+    *bd->mutable_removed_tanks() = shared.removed_tanks();
+    *bd->mutable_removed_projectiles() = shared.removed_projectiles();
+    *bd->mutable_removed_crates() = shared.removed_crates();
+    *bd->mutable_ammo_boxes() = shared.ammo_boxes();
+    if (shared.has_events())
+        *bd->mutable_events() = shared.events();
+    const uint32_t mandatory = static_cast<uint32_t>(base.ByteSizeLong());
+    const uint32_t budget = ctx.priority_tuning.budget_bytes;
+    const uint32_t room = budget > mandatory ? budget - mandatory : 0;
+    // Governor interest level shrinks the reference distance: far entities accumulate priority more slowly.
+    t2d::game::PriorityTuning tuning = ctx.priority_tuning;
+    tuning.ref_distance *= ctx.degradation.interest_distance_scale;
+    if (ctx.client_priority.size() != ctx.players.size())
+        ctx.client_priority.resize(ctx.players.size());
+    auto &rt = t2d::metrics::runtime();
+    float deferred_max = 0.f;
+    for (size_t pi = 0; pi < ctx.players.size(); ++pi) {
+        auto &pl = ctx.players[pi];
+        if (pl->is_bot || ctx.client_keyframes[pi].due)
+            continue;
+        // Viewer = the client's own tank (0,0 once it is gone: spectating the arena center).
+        float vx = 0.f, vy = 0.f;
+        const uint64_t own_key = t2d::game::repl_key(ReplKind::Tank, pl->tank_entity_id);
+        for (const auto &it : ctx.priority_items) {
+            if (it.key == own_key) {
+                vx = it.x;
+                vy = it.y;
+                break;
+            }
+        }
+        ctx.priority_selection.clear();
+        t2d::game::PackStats st;
+        ctx.client_priority[pi].select(ctx.priority_items, vx, vy, tuning, room, ctx.priority_selection, st);
+        t2d::ServerMessage csm = base;
+        auto *cd = csm.mutable_delta_snapshot();
+        cd->set_base_tick(ctx.client_keyframes[pi].last_full_tick);
+        for (auto idx : ctx.priority_selection) {
+            const auto &it = ctx.priority_items[idx];
+            switch (t2d::game::repl_kind(it.key)) {
+            case ReplKind::Tank:
+                *cd->add_tanks() = shared.tanks(static_cast<int>(it.slot));
+                break;
+            case ReplKind::Projectile:
+                *cd->add_projectiles() = shared.projectiles(static_cast<int>(it.slot));
+                break;
+            case ReplKind::Crate:
+                *cd->add_crates() = shared.crates(static_cast<int>(it.slot));
+                break;
+            }
+        }
+        const uint32_t frame_bytes = mandatory + st.bytes;
+        t2d::metrics::add_delta(frame_bytes);
+        rt.snapshot_budget_frames.fetch_add(1, std::memory_order_relaxed);
+        rt.snapshot_budget_bytes.fetch_add(frame_bytes, std::memory_order_relaxed);
+        rt.snapshot_budget_entities_sent.fetch_add(st.sent, std::memory_order_relaxed);
+        rt.snapshot_budget_entities_deferred.fetch_add(st.deferred, std::memory_order_relaxed);
+        rt.snapshot_budget_priority_sent_milli.fetch_add(
+            static_cast<uint64_t>(st.priority_sent_sum * 1000.f), std::memory_order_relaxed);
+        if (mandatory > budget)
+            rt.snapshot_budget_over_budget_frames.fetch_add(1, std::memory_order_relaxed);
+        deferred_max = std::max(deferred_max, st.priority_deferred_max);
+        t2d::mm::instance().push_message(pl, csm);
+    }
+    rt.snapshot_budget_priority_deferred_max_milli.store(
+        static_cast<uint64_t>(deferred_max * 1000.f), std::memory_order_relaxed);
+}
+
+// Match setup written into flight recorder dumps (JSON object).
+static std::string flight_config_json(const t2d::game::MatchContext &ctx)
+{
+    size_t bots = 0;
+    for (const auto &pl : ctx.players)
+        if (pl->is_bot)
+            ++bots;
+    std::ostringstream j;
+    j << "{\"tick_rate\":" << ctx.tick_rate << ",\"players\":" << ctx.players.size() << ",\"bots\":" << bots
+      << ",\"snapshot_interval_ticks\":" << ctx.snapshot_interval_ticks
+      << ",\"full_snapshot_interval_ticks\":" << ctx.full_snapshot_interval_ticks
+      << ",\"snapshot_budget_bytes\":" << ctx.priority_tuning.budget_bytes
+      << ",\"keyframe_stagger\":" << (ctx.keyframe_stagger ? "true" : "false")
+      << ",\"projectile_spawn_only\":" << (ctx.projectile_spawn_only ? "true" : "false")
+      << ",\"static_map\":" << (ctx.map ? "true" : "false") << ",\"map_width\":" << ctx.map_width
+      << ",\"map_height\":" << ctx.map_height << ",\"crates\":" << ctx.crates.size()
+      << ",\"ammo_boxes\":" << ctx.ammo_boxes.size() << ",\"test_mode\":" << (ctx.test_mode ? "true" : "false")
+      << ",\"governor_enabled\":" << (t2d::game::governor().enabled() ? "true" : "false") << "}";
+    return j.str();
+}
 } // anonymous namespace
 
 namespace t2d::game {
 
+bool parse_headless_policy(const std::string &name, HeadlessPolicy &out)
+{
+    if (name == "keep")
+        out = HeadlessPolicy::Keep;
+    else if (name == "end")
+        out = HeadlessPolicy::End;
+    else if (name == "fast_forward")
+        out = HeadlessPolicy::FastForward;
+    else
+        return false;
+    return true;
+}
+
 coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::shared_ptr<MatchContext> ctx)
 {
     co_await scheduler->schedule();
@@ -355,71 +638,96 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
         // Apply per-match fire cooldown configuration
         adv.fire_cooldown_max = ctx->fire_cooldown_sec;
     }
-    // Create static boundary walls (thin rectangles) around map if not already present.
-    // Map centered at origin: width extends +/- map_width/2 along X, height +/- map_height/2 along Y.
-    const float half_w = ctx->map_width * 0.5f;
-    const float half_h = ctx->map_height * 0.5f;
-    // Thickness of boundary walls
-    const float wall_thickness = 1.0f;
-    // Helper to create a static box
-    auto create_wall = [&](float cx, float cy, float hx, float hy)
-    {
-        b2BodyDef bd = b2DefaultBodyDef();
-        bd.type = b2_staticBody;
-        bd.position = {cx, cy};
-        b2BodyId body = b2CreateBody(phys_world.id, &bd);
-        b2ShapeDef sd = b2DefaultShapeDef();
-        sd.density = 0.0f;
-        // Treat walls as generic static colliders belonging to tank category but also colliding with crates
-        sd.filter.categoryBits = t2d::phys::CAT_BODY;
-        sd.filter.maskBits = t2d::phys::CAT_PROJECTILE | t2d::phys::CAT_BODY | t2d::phys::CAT_CRATE;
-        sd.enableContactEvents = false; // walls don't need events
-        b2Polygon poly = b2MakeBox(hx, hy);
-        b2CreatePolygonShape(body, &sd, &poly);
-    };
-    // Top & bottom
-    create_wall(0.f, half_h + wall_thickness * 0.5f, half_w + wall_thickness, wall_thickness * 0.5f);
-    create_wall(0.f, -half_h - wall_thickness * 0.5f, half_w + wall_thickness, wall_thickness * 0.5f);
-    // Left & right
-    create_wall(-half_w - wall_thickness * 0.5f, 0.f, wall_thickness * 0.5f, half_h + wall_thickness);
-    create_wall(half_w + wall_thickness * 0.5f, 0.f, wall_thickness * 0.5f, half_h + wall_thickness);
-    // Spawn grouped crates (clusters)
-    {
-        std::mt19937 rng(static_cast<uint32_t>(ctx->match_id.size() * 131u));
-        std::uniform_real_distribution<float> ux(-half_w * 0.6f, half_w * 0.6f);
-        std::uniform_real_distribution<float> uy(-half_h * 0.6f, half_h * 0.6f);
-        const int clusters = 3;
-        for (int c = 0; c < clusters; ++c) {
-            float cx = ux(rng);
-            float cy = uy(rng);
-            int count = 4 + (c % 3); // 4..6 crates per cluster
-            for (int k = 0; k < count; ++k) {
-                float ox = ((k % 3) - 1) * 2.5f + (k * 0.13f);
-                float oy = ((k / 3) - 0.5f) * 2.5f;
-                auto body = t2d::phys::create_crate(phys_world, cx + ox, cy + oy, 1.2f);
-                ctx->crates.push_back({ctx->next_crate_id++, body});
+    if (ctx->map) {
+        // Static map: geometry is pre-merged into chain loops and placements are fixed, so match start only walks
+        // the shared mapping (no per-match RNG / wall construction).
+        const auto &mv = ctx->map->view();
+        t2d::phys::create_map_geometry(phys_world, mv);
+        for (const auto &cp : mv.crates) {
+            auto body = t2d::phys::create_crate(phys_world, cp.x, cp.y, cp.half_extent);
+            add_crate(*ctx, body, cp.x, cp.y);
+        }
+        for (const auto &ap : mv.ammo) {
+            auto body = t2d::phys::create_ammo_box(phys_world, ap.x, ap.y, ap.radius);
+            ctx->ammo_boxes.push_back({ctx->next_ammo_box_id++, body, true, ap.x, ap.y});
+        }
+    } else {
+        // Create static boundary walls (thin rectangles) around map if not already present.
+        // Map centered at origin: width extends +/- map_width/2 along X, height +/- map_height/2 along Y.
+        const float half_w = ctx->map_width * 0.5f;
+        const float half_h = ctx->map_height * 0.5f;
+        // Thickness of boundary walls
+        const float wall_thickness = 1.0f;
+        // Helper to create a static box
+        auto create_wall = [&](float cx, float cy, float hx, float hy)
+        {
+            b2BodyDef bd = b2DefaultBodyDef();
+            bd.type = b2_staticBody;
+            bd.position = {cx, cy};
+            b2BodyId body = b2CreateBody(phys_world.id, &bd);
+            b2ShapeDef sd = b2DefaultShapeDef();
+            sd.density = 0.0f;
+            // Treat walls as generic static colliders belonging to tank category but also colliding with crates
+            sd.filter.categoryBits = t2d::phys::CAT_BODY;
+            sd.filter.maskBits = t2d::phys::CAT_PROJECTILE | t2d::phys::CAT_BODY | t2d::phys::CAT_CRATE;
+            sd.enableContactEvents = false; // walls don't need events
+            b2Polygon poly = b2MakeBox(hx, hy);
+            b2CreatePolygonShape(body, &sd, &poly);
+        };
+        // Top & bottom
+        create_wall(0.f, half_h + wall_thickness * 0.5f, half_w + wall_thickness, wall_thickness * 0.5f);
+        create_wall(0.f, -half_h - wall_thickness * 0.5f, half_w + wall_thickness, wall_thickness * 0.5f);
+        // Left & right
+        create_wall(-half_w - wall_thickness * 0.5f, 0.f, wall_thickness * 0.5f, half_h + wall_thickness);
+        create_wall(half_w + wall_thickness * 0.5f, 0.f, wall_thickness * 0.5f, half_h + wall_thickness);
+        // Spawn grouped crates (clusters)
+        {
+            std::mt19937 rng(static_cast<uint32_t>(ctx->match_id.size() * 131u));
+            std::uniform_real_distribution<float> ux(-half_w * 0.6f, half_w * 0.6f);
+            std::uniform_real_distribution<float> uy(-half_h * 0.6f, half_h * 0.6f);
+            const int clusters = 3;
+            for (int c = 0; c < clusters; ++c) {
+                float cx = ux(rng);
+                float cy = uy(rng);
+                int count = 4 + (c % 3); // 4..6 crates per cluster
+                for (int k = 0; k < count; ++k) {
+                    float ox = ((k % 3) - 1) * 2.5f + (k * 0.13f);
+                    float oy = ((k / 3) - 0.5f) * 2.5f;
+                    auto body = t2d::phys::create_crate(phys_world, cx + ox, cy + oy, 1.2f);
+                    add_crate(*ctx, body, cx + ox, cy + oy);
+                }
             }
         }
-    }
-    // Spawn ammo boxes randomly among crate clusters (avoid overlap by sampling near crates)
-    {
-        std::mt19937 rng(static_cast<uint32_t>(ctx->match_id.size() * 977u));
-        std::uniform_real_distribution<float> jitter(-1.5f, 1.5f);
-        int targetBoxes = 5;
-        for (int i = 0; i < targetBoxes && !ctx->crates.empty(); ++i) {
-            auto &cr = ctx->crates[i % ctx->crates.size()];
-            b2Vec2 pos = t2d::phys::get_body_position(cr.body);
-            float ax = pos.x + jitter(rng);
-            float ay = pos.y + jitter(rng);
-            auto body = t2d::phys::create_ammo_box(phys_world, ax, ay, 0.9f);
-            ctx->ammo_boxes.push_back({ctx->next_ammo_box_id++, body, true, ax, ay});
+        // Spawn ammo boxes randomly among crate clusters (avoid overlap by sampling near crates)
+        {
+            std::mt19937 rng(static_cast<uint32_t>(ctx->match_id.size() * 977u));
+            std::uniform_real_distribution<float> jitter(-1.5f, 1.5f);
+            int targetBoxes = 5;
+            for (int i = 0; i < targetBoxes && !ctx->crates.empty(); ++i) {
+                auto &cr = ctx->crates[i % ctx->crates.size()];
+                float ax = cr.x + jitter(rng);
+                float ay = cr.y + jitter(rng);
+                auto body = t2d::phys::create_ammo_box(phys_world, ax, ay, 0.9f);
+                ctx->ammo_boxes.push_back({ctx->next_ammo_box_id++, body, true, ax, ay});
+            }
         }
     }
     using clock = std::chrono::steady_clock;
+    FlightRecorder recorder(ctx->match_id, ctx->tick_rate, flight_config_json(*ctx));
+    TickPerfSampler phase_perf;
     // Precise tick interval in nanoseconds to avoid integer millisecond truncation (e.g. 33.333ms at 30Hz).
     auto tick_interval = std::chrono::nanoseconds((1'000'000'000ull + ctx->tick_rate / 2) / ctx->tick_rate);
     auto next = clock::now();
+    std::vector<size_t> disconnected; // scratch: player indices dropped by the session manager this tick
+    size_t human_count = 0;
+    for (const auto &pl : ctx->players)
+        if (!pl->is_bot)
+            ++human_count;
+    // Fast-forward runs at a capped multiple of the tick rate: its ticks are cheaper (1 sub-step, sparse AI), so a
+    // headless match keeps roughly the core share it had while a human was watching instead of spinning a core.
+    constexpr uint32_t kFastForwardSpeedup = 4;
     while (true) {
+        const bool fast_forward = ctx->headless && ctx->headless_policy == HeadlessPolicy::FastForward;
         auto now = clock::now();
         if (now < next) {
             auto wait_dur = next - now;
@@ -429,6 +737,24 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
             continue;
         }
         auto tick_start = now;
+        ctx->degradation = t2d::game::governor().current();
+        if (fast_forward)
+            ctx->degradation.ai_stride = std::max<uint32_t>(ctx->degradation.ai_stride, 4);
+        auto &rec = recorder.next();
+        rec.start_us = static_cast<int64_t>(t2d::netutil::steady_us(tick_start));
+        rec.governor_level = t2d::game::governor().level();
+        // Allocation counters only move in profiling builds (global operator new hook).
+        const uint64_t rec_allocs = t2d::metrics::runtime().allocations_total.load(std::memory_order_relaxed);
+        const uint64_t rec_alloc_bytes =
+            t2d::metrics::runtime().allocations_bytes_total.load(std::memory_order_relaxed);
+        auto phase_mark = tick_start;
+        phase_perf.begin();
+        const auto mark_phase = [&](TickPhase phase, clock::time_point t) {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t - phase_mark).count();
+            rec.phase_ns[static_cast<size_t>(phase)] = static_cast<uint32_t>(std::min<int64_t>(ns, UINT32_MAX));
+            phase_mark = t;
+            phase_perf.mark(phase);
+        };
         // Snapshot allocation counter at tick start (profiling builds only)
 #if T2D_PROFILING_ENABLED
         uint64_t alloc_before = t2d::metrics::runtime().allocations_total.load(std::memory_order_relaxed);
@@ -436,55 +762,82 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
         uint64_t dealloc_before = t2d::metrics::runtime().deallocations_total.load(std::memory_order_relaxed);
         uint64_t log_before = t2d::metrics::runtime().log_lines_total.load(std::memory_order_relaxed);
 #endif
-        next += tick_interval;
+        next += fast_forward ? tick_interval / kFastForwardSpeedup : tick_interval;
         ctx->server_tick++;
-        // Handle disconnects: identify players removed from session manager snapshot
+        // Handle disconnects: players the session manager dropped since the last tick (per player flag, so the
+        // cost does not grow with the number of sessions on the server)
         {
-            // Build a set of active session_ids from session manager
-            auto active_sessions = t2d::mm::instance().snapshot_all_sessions();
-            std::unordered_set<std::string> active_ids;
-            active_ids.reserve(active_sessions.size());
-            for (auto &sp : active_sessions) {
-                if (!sp->session_id.empty())
-                    active_ids.insert(sp->session_id);
-            }
-            for (size_t i = 0; i < ctx->players.size(); ++i) {
-                auto &sess = ctx->players[i];
-                if (sess->is_bot)
-                    continue; // bots persist until match end
-                if (!sess->session_id.empty() && active_ids.find(sess->session_id) == active_ids.end()) {
-                    // Session disconnected; mark tank dead (if not already) and queue removal if not yet recorded
-                    if (i < ctx->tanks.size()) {
-                        auto &tank = ctx->tanks[i];
-                        if (tank.hp > 0) {
-                            tank.hp = 0;
-                            if (!ctx->persist_destroyed_tanks) {
-                                ctx->removed_tanks_since_full.push_back(tank.entity_id);
-                                if (b2Body_IsValid(tank.hull)) {
-                                    t2d::phys::destroy_body(tank.hull);
-                                    tank.hull = b2_nullBodyId;
-                                }
-                                if (b2Body_IsValid(tank.turret)) {
-                                    t2d::phys::destroy_body(tank.turret);
-                                    tank.turret = b2_nullBodyId;
-                                }
-                                if (b2Joint_IsValid(tank.turret_joint)) {
-                                    b2DestroyJoint(tank.turret_joint);
-                                    tank.turret_joint = b2_nullJointId;
-                                }
-                            } else if (b2Joint_IsValid(tank.turret_joint)) {
-                                b2RevoluteJoint_EnableMotor(tank.turret_joint, false);
-                                b2RevoluteJoint_SetMotorSpeed(tank.turret_joint, 0.f);
+            t2d::mm::instance().find_disconnected(ctx->players, disconnected);
+            for (size_t i : disconnected) {
+                // Session disconnected; mark tank dead (if not already) and queue removal if not yet recorded
+                if (i < ctx->tanks.size()) {
+                    auto &tank = ctx->tanks[i];
+                    if (tank.hp > 0) {
+                        tank.hp = 0;
+                        if (!ctx->persist_destroyed_tanks) {
+                            ctx->removed_tanks_since_full.push_back(
+                                {tank.entity_id, static_cast<uint32_t>(ctx->server_tick)});
+                            if (b2Body_IsValid(tank.hull)) {
+                                t2d::phys::destroy_body(tank.hull);
+                                tank.hull = b2_nullBodyId;
+                            }
+                            if (b2Body_IsValid(tank.turret)) {
+                                t2d::phys::destroy_body(tank.turret);
+                                tank.turret = b2_nullBodyId;
                             }
-                            ctx->kill_feed_events.emplace_back(tank.entity_id, 0);
-                            t2d::ServerMessage tdmsg;
-                            auto *td = tdmsg.mutable_destroyed();
-                            td->set_victim_id(tank.entity_id);
-                            td->set_attacker_id(0); // environment / disconnect
-                            for (auto &pl : ctx->players)
-                                t2d::mm::instance().push_message(pl, tdmsg);
+                            if (b2Joint_IsValid(tank.turret_joint)) {
+                                b2DestroyJoint(tank.turret_joint);
+                                tank.turret_joint = b2_nullJointId;
+                            }
+                        } else if (b2Joint_IsValid(tank.turret_joint)) {
+                            b2RevoluteJoint_EnableMotor(tank.turret_joint, false);
+                            b2RevoluteJoint_SetMotorSpeed(tank.turret_joint, 0.f);
+                        }
+                        ctx->kill_feed_events.emplace_back(tank.entity_id, 0);
+                        auto *td = ctx->tick_events.add_destroyed();
+                        td->set_victim_id(tank.entity_id);
+                        td->set_attacker_id(0); // environment / disconnect
+                    }
+                }
+            }
+            // Headless: no human left to receive snapshots (the disconnect flag is never cleared, so this is final).
+            // Bot-only matches (auto test match, load tests) never had a recipient and are left alone.
+            size_t dropped_humans = 0;
+            for (size_t i : disconnected)
+                if (!ctx->players[i]->is_bot)
+                    ++dropped_humans;
+            if (!ctx->headless && ctx->headless_policy != HeadlessPolicy::Keep && human_count > 0
+                && dropped_humans == human_count) {
+                ctx->headless = true;
+                t2d::metrics::runtime().matches_headless.fetch_add(1, std::memory_order_relaxed);
+                t2d::log::info(
+                    "[match] headless id={} tick={} policy={}",
+                    ctx->match_id,
+                    ctx->server_tick,
+                    ctx->headless_policy == HeadlessPolicy::End ? "end" : "fast_forward");
+                if (ctx->headless_policy == HeadlessPolicy::End && !ctx->match_over) {
+                    // Result from the current state; nobody is left to receive MatchEnd, so the grace period is
+                    // skipped and the match exits at the end of this tick.
+                    uint32_t best_hp = 0;
+                    uint32_t best_id = 0;
+                    bool tie = false;
+                    for (const auto &t : ctx->tanks) {
+                        if (t.hp > best_hp) {
+                            best_hp = t.hp;
+                            best_id = t.entity_id;
+                            tie = false;
+                        } else if (t.hp > 0 && t.hp == best_hp) {
+                            tie = true;
                         }
                     }
+                    ctx->winner_entity = tie ? 0 : best_id;
+                    ctx->match_over = true;
+                    ctx->match_over_tick = static_cast<uint32_t>(ctx->server_tick);
+                    ctx->post_end_grace_ticks = 0;
+                    ctx->match_end_sent = true;
+                    t2d::log::info("[match] over (headless) id={} winner_entity={}", ctx->match_id, ctx->winner_entity);
+                } else if (ctx->headless_policy == HeadlessPolicy::End) {
+                    ctx->post_end_grace_ticks = 0; // already decided: skip the rest of the grace streaming
                 }
             }
         }
@@ -498,7 +851,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
             if (adv.hp == 0)
                 continue; // dead
             auto &sess = ctx->players[i];
-            auto input = t2d::mm::instance().get_input_copy(sess);
+            auto input = t2d::mm::instance().apply_input(sess);
             // One-shot per tick diagnostic when a human player's input is non-zero (temporary instrumentation)
             if (!sess->is_bot
                 && (std::fabs(input.move_dir) > 0.01f || std::fabs(input.turn_dir) > 0.01f
@@ -517,6 +870,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
             }
             // Basic bot AI: if bot, synthesize movement & periodic fire
             if (sess->is_bot) {
+                const uint32_t ai_stride = ctx->degradation.ai_stride;
                 if (ctx->disable_bot_ai) {
                     // Force idle inputs
                     input.move_dir = 0.f;
@@ -525,12 +879,14 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     input.fire = false;
                     t2d::mm::Session::InputState upd_idle = input;
                     t2d::mm::instance().set_bot_input(sess, upd_idle);
+                } else if (ai_stride > 1 && (ctx->server_tick + i) % ai_stride != 0) {
+                    // Governor AI LOD: bots re-plan on their own phase of every ai_stride ticks and keep their last
+                    // steering in between; shots are only taken on planning ticks.
+                    input.fire = false;
                 } else {
                     // Acquire current tank transform
                     b2Transform myHull = b2Body_GetTransform(adv.hull);
                     b2Transform myTurret = b2Body_GetTransform(adv.turret);
-                    float myHullRad = std::atan2(myHull.q.s, myHull.q.c);
-                    float myTurretRad = std::atan2(myTurret.q.s, myTurret.q.c);
                     // Bot AI: wandering + target acquisition + LOS-aware firing.
                     // 1. Target selection (cache per tick minimal for prototype)
                     int target_index = -1;
@@ -554,24 +910,18 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                             target_index = (int)j;
                         }
                     }
-                    float desired_rad = myHullRad;
-                    float last_align_err = 9999.f;
+                    bool aligned = false;
                     // 2. Movement: wander if no target; pursue/strafe if target
                     if (target_index >= 0) {
                         const auto &tt = ctx->tanks[target_index];
                         b2Transform ttHull = b2Body_GetTransform(tt.hull);
                         float dx = ttHull.p.x - myHull.p.x;
                         float dy = ttHull.p.y - myHull.p.y;
-                        desired_rad = std::atan2(dy, dx);
-                        float base_turn = desired_rad - myHullRad;
-                        // Normalize to [-pi, pi] using fmod to avoid potential long while loops
-                        {
-                            float two_pi = 2.f * (float)M_PI;
-                            base_turn = std::fmod(base_turn + (float)M_PI, two_pi);
-                            if (base_turn < 0.f)
-                                base_turn += two_pi;
-                            base_turn -= (float)M_PI;
-                        }
+                        // Errors relative to the hull / turret headings from dot and cross with the target
+                        // direction: already in (-pi, pi], no atan2 of absolute angles and no wrap-around.
+                        const float base_turn = t2d::math::vec_rad(
+                            t2d::math::rot_dot(myHull.q.c, myHull.q.s, dx, dy),
+                            t2d::math::rot_cross(myHull.q.c, myHull.q.s, dx, dy));
                         input.turn_dir = std::clamp(base_turn * 180.f / 120.f / (float)M_PI, -1.f, 1.f);
                         float dist2 = dx * dx + dy * dy;
                         if (dist2 > 900.f) { // far
@@ -583,16 +933,11 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                             input.move_dir = ((ctx->server_tick / 30) % 2) == 0 ? 0.4f : -0.2f;
                         }
                         // Turret aim independent for faster tracking
-                        float tdiff = desired_rad - myTurretRad;
-                        // Normalize to [-pi, pi] using fmod (single pass)
-                        {
-                            float two_pi = 2.f * (float)M_PI;
-                            tdiff = std::fmod(tdiff + (float)M_PI, two_pi);
-                            if (tdiff < 0.f)
-                                tdiff += two_pi;
-                            tdiff -= (float)M_PI;
-                        }
-                        last_align_err = std::fabs(tdiff) * 180.f / (float)M_PI;
+                        const float tdiff = t2d::math::vec_rad(
+                            t2d::math::rot_dot(myTurret.q.c, myTurret.q.s, dx, dy),
+                            t2d::math::rot_cross(myTurret.q.c, myTurret.q.s, dx, dy));
+                        constexpr float kFireConeCos = 0.98480775f; // cos(10 deg): stricter alignment for smarter shots
+                        aligned = t2d::math::within_cone(myTurret.q.c, myTurret.q.s, dx, dy, kFireConeCos);
                         input.turret_turn = std::clamp(tdiff * 180.f / (60.f * (float)M_PI), -1.f, 1.f);
                     } else {
                         // Wander: slow rotation + occasional forward bursts
@@ -603,9 +948,10 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     // 3. Firing logic: only when turret roughly aligned AND predicted lead not required (simple LOS).
                     if (!ctx->disable_bot_fire) {
                         uint32_t interval = ctx->bot_fire_interval_ticks == 0 ? 1 : ctx->bot_fire_interval_ticks;
-                        bool cadence = (ctx->server_tick % interval) == 0;
+                        // Window of ai_stride ticks so every bot phase meets the cadence (== 0 at full AI rate).
+                        bool cadence = (ctx->server_tick % interval) < ai_stride;
                         if (cadence && target_index >= 0) {
-                            input.fire = (last_align_err < 10.f); // stricter alignment for smarter shots
+                            input.fire = aligned;
                         } else {
                             input.fire = false;
                         }
@@ -633,16 +979,12 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
 
             // Turret aim: always call update_turret_aim (it internally enforces disabled turret state)
             {
-                b2Transform xt = b2Body_GetTransform(adv.turret);
-                float current = std::atan2(xt.q.s, xt.q.c);
-                float desired = current;
-                if (std::fabs(input.turret_turn) > 0.0001f) {
-                    desired =
-                        current + input.turret_turn * t2d::game::turret_turn_speed_deg() * dt * float(M_PI / 180.0);
-                }
                 t2d::phys::TurretAimInput aim{};
-                aim.target_angle_world = desired; // when disabled, update_turret_aim will early return & enforce motor
-                                                  // off
+                // Relative to the current heading, so the turret rotation never goes through an angle. When disabled,
+                // update_turret_aim will early return & enforce motor off.
+                aim.relative_turn = std::fabs(input.turret_turn) > 0.0001f
+                    ? input.turret_turn * t2d::game::turret_turn_speed_deg() * dt * float(M_PI / 180.0)
+                    : 0.f;
                 t2d::phys::update_turret_aim(aim, adv);
             }
             if (input.fire && adv.ammo > 0) {
@@ -686,6 +1028,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     slot.owner = adv.entity_id;
                     slot.initial_speed = ctx->projectile_speed;
                     slot.age = 0.f;
+                    slot.repl_dirty = true; // sampled after this tick's step (body velocity incl. inherited)
                     ctx->projectile_indices.push_back(slot_index);
                     if (ctx->projectile_indices.size() > ctx->projectile_pool_hwm)
                         ctx->projectile_pool_hwm = static_cast<uint32_t>(ctx->projectile_indices.size());
@@ -737,6 +1080,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
             if (adv.fire_cooldown_cur > 0.f)
                 adv.fire_cooldown_cur = std::max(0.f, adv.fire_cooldown_cur - dt);
         }
+        mark_phase(TickPhase::Input, clock::now());
         // Capture pre-step projectile state (position + velocity) for penetration logic before physics integration
         for (auto si : ctx->projectile_indices) {
             if (si >= ctx->projectiles_storage.size())
@@ -759,7 +1103,12 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
             }
         }
         // Physics step (tanks + projectiles + crates) then process contacts (which will use pre-step projectile data)
-        t2d::phys::step(phys_world, dt);
+        t2d::phys::step(phys_world, dt, ctx->headless ? 1 : 4);
+        sync_moved_crates(*ctx, phys_world.id);
+        mark_phase(TickPhase::Physics, clock::now());
+        rec.moving_bodies = static_cast<uint32_t>(b2World_GetBodyEvents(phys_world.id).moveCount);
+        rec.contact_begins = static_cast<uint32_t>(b2World_GetContactEvents(phys_world.id).beginCount);
+        rec.contacts = static_cast<uint32_t>(b2World_GetCounters(phys_world.id).contactCount);
         // Post-first-step velocity trace: log velocity after first physics integration step (age==0 before increment)
         for (auto si : ctx->projectile_indices) {
             if (si >= ctx->projectiles_storage.size())
@@ -803,6 +1152,11 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                         adv.ammo = std::min<uint16_t>(adv.ammo + 5, (uint16_t)ctx->max_ammo);
                     }
                     ab.active = false;
+                    ab.changed_tick = static_cast<uint32_t>(ctx->server_tick);
+                    auto *pu = ctx->tick_events.add_pickups();
+                    pu->set_box_id(ab.id);
+                    pu->set_entity_id(adv.entity_id);
+                    pu->set_ammo(adv.ammo);
                     // Convert body to non-interactive
                     if (b2Body_IsValid(ab.body)) {
                         t2d::phys::destroy_body(ab.body);
@@ -824,11 +1178,35 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 auto pos = t2d::phys::get_body_position(it->second);
                 p.x = pos.x;
                 p.y = pos.y;
+                if (b2Body_IsValid(it->second)) {
+                    b2Vec2 v = b2Body_GetLinearVelocity(it->second);
+                    p.vx = v.x;
+                    p.vy = v.y;
+                }
             } else {
                 p.x += p.vx * dt;
                 p.y += p.vy * dt;
             }
             p.age += dt;
+            // Re-sample the replicated trajectory on spawn or when Box2D bent it (ricochet / blocked hit); clients
+            // extrapolate the sample until the next one arrives.
+            const uint32_t tick = static_cast<uint32_t>(ctx->server_tick);
+            if (p.repl_dirty
+                || t2d::proj::diverged(
+                    p.repl,
+                    tick,
+                    dt,
+                    p.x,
+                    p.y,
+                    p.vx,
+                    p.vy,
+                    ctx->projectile_resend_pos_tolerance * ctx->degradation.projectile_tolerance_scale,
+                    ctx->projectile_resend_vel_tolerance * ctx->degradation.projectile_tolerance_scale)) {
+                if (!p.repl_dirty)
+                    t2d::metrics::runtime().projectile_resamples.fetch_add(1, std::memory_order_relaxed);
+                p.repl = {p.x, p.y, p.vx, p.vy, tick};
+                p.repl_dirty = true;
+            }
         }
         // Simple bounds cull for projectiles (world prototype area +/-100)
         {
@@ -852,7 +1230,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                             t2d::phys::destroy_body(body_it->second);
                             projectile_bodies.erase(body_it);
                         }
-                        ctx->removed_projectiles_since_full.push_back(pid);
+                        ctx->removed_projectiles_since_full.push_back({pid, static_cast<uint32_t>(ctx->server_tick)});
                         ctx->projectile_free_indices.push_back(si);
                     }
                     ctx->projectile_indices.erase(ctx->projectile_indices.begin() + *it);
@@ -860,9 +1238,27 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
             }
         }
         // (Contact processing already performed earlier this tick)
-        if (ctx->snapshot_interval_ticks > 0 && ctx->server_tick % ctx->snapshot_interval_ticks == 0) {
-            bool send_full = (ctx->server_tick - ctx->last_full_snapshot_tick >= ctx->full_snapshot_interval_ticks);
-            if (send_full) {
+        mark_phase(TickPhase::Contacts, clock::now());
+        // Headless matches encode nothing: no snapshots, event batches or kill feed.
+        const bool has_tick_events = !ctx->headless
+            && (ctx->tick_events.damage_size() > 0 || ctx->tick_events.destroyed_size() > 0
+                || ctx->tick_events.pickups_size() > 0);
+        const bool snapshot_tick = !ctx->headless && ctx->snapshot_interval_ticks > 0
+            && ctx->server_tick % (ctx->snapshot_interval_ticks * ctx->degradation.snapshot_interval_mult) == 0;
+        if (has_tick_events) {
+            ctx->tick_events.set_server_tick(static_cast<uint32_t>(ctx->server_tick));
+            auto &rt = t2d::metrics::runtime();
+            rt.tick_events_total.fetch_add(
+                ctx->tick_events.damage_size() + ctx->tick_events.destroyed_size() + ctx->tick_events.pickups_size(),
+                std::memory_order_relaxed);
+            (snapshot_tick ? rt.tick_event_batches_piggybacked : rt.tick_event_batches_standalone)
+                .fetch_add(1, std::memory_order_relaxed);
+        }
+        if (snapshot_tick) {
+            // Per-client keyframes: due clients get the full snapshot, everyone else this tick's delta. When both are
+            // built the delta pass owns the sent-state caches (it runs after the full snapshot).
+            const auto [any_full, any_delta] = plan_keyframes(*ctx);
+            if (any_full) {
                 auto snap_start = std::chrono::steady_clock::now();
 #if T2D_PROFILING_ENABLED
                 // Phase timing instrumentation (tanks, ammo, crates, projectiles, serialize)
@@ -872,13 +1268,17 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 t2d::ServerMessage sm;
                 auto *snap = sm.mutable_snapshot();
                 snap->set_server_tick(static_cast<uint32_t>(ctx->server_tick));
+                snap->set_server_time_us(t2d::netutil::steady_us(tick_start)); // client interpolation clock
                 // Static map dimensions (unchanged during match) sent with each full snapshot
                 snap->set_map_width(ctx->map_width);
                 snap->set_map_height(ctx->map_height);
                 ctx->last_full_snapshot_tick = static_cast<uint32_t>(ctx->server_tick);
                 // Rebuild cache from physics state
-                ctx->last_sent_tanks.clear();
-                ctx->last_sent_tanks.resize(ctx->tanks.size());
+                const bool rebuild_cache = !any_delta;
+                if (rebuild_cache) {
+                    ctx->last_sent_tanks.clear();
+                    ctx->last_sent_tanks.resize(ctx->tanks.size());
+                }
                 for (size_t ti = 0; ti < ctx->tanks.size(); ++ti) {
                     auto &adv = ctx->tanks[ti];
                     if (adv.hp == 0 && !ctx->persist_destroyed_tanks)
@@ -888,8 +1288,8 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     auto pos = t2d::phys::get_body_position(adv.hull);
                     b2Transform xh = b2Body_GetTransform(adv.hull);
                     b2Transform xt = b2Body_GetTransform(adv.turret);
-                    float hull_rad = std::atan2(xh.q.s, xh.q.c) * 180.f / 3.14159265f;
-                    float tur_rad = std::atan2(xt.q.s, xt.q.c) * 180.f / 3.14159265f;
+                    float hull_rad = t2d::math::vec_deg(xh.q.c, xh.q.s);
+                    float tur_rad = t2d::math::vec_deg(xt.q.c, xt.q.s);
 #if T2D_ENABLE_SNAPSHOT_QUANT
                     // Quantize positions & angles into integer buckets stored still as float (prototype keeps proto
                     // schema unchanged)
@@ -906,15 +1306,17 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     ts->set_turret_angle(tur_rad);
 #endif
                     // update cache
-                    auto &cache = ctx->last_sent_tanks[ti];
-                    cache.entity_id = adv.entity_id;
-                    cache.x = pos.x;
-                    cache.y = pos.y;
-                    cache.hull_angle = hull_rad;
-                    cache.turret_angle = tur_rad;
-                    cache.hp = adv.hp;
-                    cache.ammo = adv.ammo;
-                    cache.alive = adv.hp > 0;
+                    if (rebuild_cache) {
+                        auto &cache = ctx->last_sent_tanks[ti];
+                        cache.entity_id = adv.entity_id;
+                        cache.x = pos.x;
+                        cache.y = pos.y;
+                        cache.hull_angle = hull_rad;
+                        cache.turret_angle = tur_rad;
+                        cache.hp = adv.hp;
+                        cache.ammo = adv.ammo;
+                        cache.alive = adv.hp > 0;
+                    }
                     ts->set_hp(adv.hp);
                     ts->set_ammo(adv.ammo);
                     ts->set_track_left_broken(adv.left_track_broken);
@@ -951,31 +1353,31 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     phase_prev = now;
                 }
 #endif
-                // Crates (position + angle)
+                // Crates (position + angle, mirrored after the physics step)
                 for (auto &cr : ctx->crates) {
                     if (!b2Body_IsValid(cr.body))
                         continue;
-                    b2Transform xf = b2Body_GetTransform(cr.body);
                     auto *cs = snap->add_crates();
                     cs->set_crate_id(cr.id);
-                    cs->set_x(xf.p.x);
-                    cs->set_y(xf.p.y);
-                    float ang_deg = std::atan2(xf.q.s, xf.q.c) * 180.f / 3.14159265f;
-                    cs->set_angle(ang_deg);
+                    cs->set_x(cr.x);
+                    cs->set_y(cr.y);
+                    cs->set_angle(cr.angle_deg);
                     // update crate cache
+                    if (!rebuild_cache)
+                        continue;
                     bool found = false;
                     for (auto &cc : ctx->last_sent_crates) {
                         if (cc.id == cr.id) {
-                            cc.x = xf.p.x;
-                            cc.y = xf.p.y;
-                            cc.angle = ang_deg;
+                            cc.x = cr.x;
+                            cc.y = cr.y;
+                            cc.angle = cr.angle_deg;
                             cc.alive = true;
                             found = true;
                             break;
                         }
                     }
                     if (!found) {
-                        ctx->last_sent_crates.push_back({cr.id, xf.p.x, xf.p.y, ang_deg, true});
+                        ctx->last_sent_crates.push_back({cr.id, cr.x, cr.y, cr.angle_deg, true});
                     }
                 }
 #if T2D_PROFILING_ENABLED
@@ -990,20 +1392,9 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     if (si >= ctx->projectiles_storage.size())
                         continue;
                     auto &p = ctx->projectiles_storage[si];
-                    auto *ps = snap->add_projectiles();
-                    ps->set_projectile_id(p.id);
-#if T2D_ENABLE_SNAPSHOT_QUANT
-                    constexpr float POS_SCALE = 100.f;
-                    ps->set_x(std::round(p.x * POS_SCALE) / POS_SCALE);
-                    ps->set_y(std::round(p.y * POS_SCALE) / POS_SCALE);
-                    ps->set_vx(p.vx); // velocities left unquantized for now
-                    ps->set_vy(p.vy);
-#else
-                    ps->set_x(p.x);
-                    ps->set_y(p.y);
-                    ps->set_vx(p.vx);
-                    ps->set_vy(p.vy);
-#endif
+                    write_projectile(snap->add_projectiles(), p);
+                    if (rebuild_cache)
+                        p.repl_dirty = false; // keyframe carried the sample to everyone
                 }
 #if T2D_PROFILING_ENABLED
                 {
@@ -1013,6 +1404,12 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     phase_prev = now;
                 }
 #endif
+                if (has_tick_events) {
+                    if (any_delta)
+                        *snap->mutable_events() = ctx->tick_events; // delta recipients need the batch too
+                    else
+                        snap->mutable_events()->Swap(&ctx->tick_events);
+                }
                 // Approx size: serialize into reusable scratch buffer (size() after serialize provides byte count)
                 {
 #if T2D_PROFILING_ENABLED
@@ -1045,15 +1442,22 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 // Compression placeholder: RLE + optional zlib (only metrics currently recorded by rle_try/zlib_try)
                 // Future: send compressed variant conditionally to clients advertising support.
 #endif
-                for (auto &pl : ctx->players)
-                    t2d::mm::instance().push_message(pl, sm);
+                std::vector<std::shared_ptr<t2d::mm::Session>> keyframe_recipients;
+                for (size_t pi = 0; pi < ctx->players.size(); ++pi) {
+                    if (ctx->client_keyframes[pi].due && !ctx->players[pi]->is_bot)
+                        keyframe_recipients.push_back(ctx->players[pi]);
+                }
+                t2d::metrics::runtime().keyframes_sent.fetch_add(
+                    keyframe_recipients.size(), std::memory_order_relaxed);
+                t2d::mm::instance().push_message_all(keyframe_recipients, sm);
 #if T2D_PROFILING_ENABLED
                 auto snap_dur =
                     std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - snap_start)
                         .count();
                 t2d::metrics::add_snapshot_full_build_time((uint64_t)snap_dur);
 #endif
-            } else {
+            }
+            if (any_delta) {
                 // delta snapshot
                 auto snap_start = std::chrono::steady_clock::now();
 #if T2D_PROFILING_ENABLED
@@ -1063,7 +1467,12 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 t2d::ServerMessage sm;
                 auto *delta = sm.mutable_delta_snapshot();
                 delta->set_server_tick(static_cast<uint32_t>(ctx->server_tick));
-                delta->set_base_tick(ctx->last_full_snapshot_tick);
+                delta->set_server_time_us(t2d::netutil::steady_us(tick_start));
+                delta->set_base_tick(ctx->last_full_snapshot_tick); // overwritten per recipient group
+                // Budgeted mode: list every live entity and let each client's accumulator pick (see
+                // send_budgeted_deltas); `changed` then only marks the entry dirty.
+                const bool budgeted = ctx->priority_tuning.budget_bytes > 0;
+                ctx->priority_items.clear();
                 // compare tanks
                 if (ctx->last_sent_tanks.size() != ctx->tanks.size())
                     ctx->last_sent_tanks.resize(ctx->tanks.size());
@@ -1081,12 +1490,19 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     auto pos = t2d::phys::get_body_position(adv.hull);
                     b2Transform xh = b2Body_GetTransform(adv.hull);
                     b2Transform xt = b2Body_GetTransform(adv.turret);
-                    float hull_deg = std::atan2(xh.q.s, xh.q.c) * 180.f / 3.14159265f;
-                    float tur_deg = std::atan2(xt.q.s, xt.q.c) * 180.f / 3.14159265f;
+                    float hull_deg = t2d::math::vec_deg(xh.q.c, xh.q.s);
+                    float tur_deg = t2d::math::vec_deg(xt.q.c, xt.q.s);
                     bool changed = std::fabs(pos.x - prev.x) > 0.0001f || std::fabs(pos.y - prev.y) > 0.0001f
                         || std::fabs(hull_deg - prev.hull_angle) > 0.01f
                         || std::fabs(tur_deg - prev.turret_angle) > 0.01f || adv.hp != prev.hp || adv.ammo != prev.ammo;
-                    if (changed) {
+                    float change_mag = 0.f;
+                    if (budgeted && changed) {
+                        // Movement in world units, rotation per 30 deg, damage weighs like a long move.
+                        change_mag = std::hypot(pos.x - prev.x, pos.y - prev.y)
+                            + (std::fabs(hull_deg - prev.hull_angle) + std::fabs(tur_deg - prev.turret_angle)) / 30.f
+                            + (adv.hp != prev.hp ? 4.f : 0.f);
+                    }
+                    if (changed || budgeted) {
                         auto *ts = delta->add_tanks();
                         ts->set_entity_id(adv.entity_id);
 #if T2D_ENABLE_SNAPSHOT_QUANT
@@ -1107,6 +1523,18 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                         ts->set_track_left_broken(adv.left_track_broken);
                         ts->set_track_right_broken(adv.right_track_broken);
                         ts->set_turret_disabled(adv.turret_disabled);
+                        if (budgeted) {
+                            ctx->priority_items.push_back(
+                                {t2d::game::repl_key(t2d::game::ReplKind::Tank, adv.entity_id),
+                                 pos.x,
+                                 pos.y,
+                                 change_mag,
+                                 entry_bytes(*ts),
+                                 static_cast<uint32_t>(delta->tanks_size() - 1),
+                                 changed});
+                        }
+                    }
+                    if (changed) {
                         prev.x = pos.x;
                         prev.y = pos.y;
                         prev.hull_angle = hull_deg;
@@ -1124,32 +1552,36 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     phase_prev_delta = now;
                 }
 #endif
-                for (auto id : ctx->removed_tanks_since_full)
-                    delta->add_removed_tanks(id);
-                // new projectiles since base: naive include all with id > 0 created after base tick (simplify: send all
-                // projectiles whose id greater than count at last full snapshot) For prototype, just send all
-                // projectiles (client would de-dup by id)
+                for (const auto &r : ctx->removed_tanks_since_full)
+                    delta->add_removed_tanks(r.id);
+                // Spawn-only replication: a projectile is listed when spawned or re-sampled after a trajectory change
+                // (clients upsert by id and extrapolate the rest). Budgeted deltas list every live projectile so
+                // deferred samples stay pending in the accumulators; legacy mode resends all of them every delta.
                 for (auto si : ctx->projectile_indices) {
                     if (si >= ctx->projectiles_storage.size())
                         continue;
                     auto &p = ctx->projectiles_storage[si];
+                    const bool dirty = p.repl_dirty || !ctx->projectile_spawn_only;
+                    p.repl_dirty = false;
+                    if (!dirty && !budgeted)
+                        continue;
                     auto *ps = delta->add_projectiles();
-                    ps->set_projectile_id(p.id);
-#if T2D_ENABLE_SNAPSHOT_QUANT
-                    constexpr float POS_SCALE = 100.f;
-                    ps->set_x(std::round(p.x * POS_SCALE) / POS_SCALE);
-                    ps->set_y(std::round(p.y * POS_SCALE) / POS_SCALE);
-                    ps->set_vx(p.vx);
-                    ps->set_vy(p.vy);
-#else
-                    ps->set_x(p.x);
-                    ps->set_y(p.y);
-                    ps->set_vx(p.vx);
-                    ps->set_vy(p.vy);
-#endif
+                    write_projectile(ps, p);
+                    if (dirty)
+                        t2d::metrics::runtime().projectile_delta_entries.fetch_add(1, std::memory_order_relaxed);
+                    if (budgeted) {
+                        ctx->priority_items.push_back(
+                            {t2d::game::repl_key(t2d::game::ReplKind::Projectile, p.id),
+                             p.x,
+                             p.y,
+                             0.f,
+                             entry_bytes(*ps),
+                             static_cast<uint32_t>(delta->projectiles_size() - 1),
+                             dirty});
+                    }
                 }
-                for (auto id : ctx->removed_projectiles_since_full)
-                    delta->add_removed_projectiles(id);
+                for (const auto &r : ctx->removed_projectiles_since_full)
+                    delta->add_removed_projectiles(r.id);
 #if T2D_PROFILING_ENABLED
                 {
                     auto now = std::chrono::steady_clock::now();
@@ -1158,14 +1590,19 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     phase_prev_delta = now;
                 }
 #endif
-                // Crate deltas
+                // Crate deltas: only crates Box2D moved since the last pass are compared (cached transforms, see
+                // sync_moved_crates). Budgeted mode also keeps listing a resting crate while its last change may
+                // still be pending for a client, since accumulators drop entries that leave the candidate table.
+                const uint32_t horizon = keyframe_horizon(*ctx);
                 if (ctx->last_sent_crates.size() < ctx->crates.size())
                     ctx->last_sent_crates.resize(ctx->crates.size());
                 for (auto &cr : ctx->crates) {
+                    const bool moved = cr.moved;
+                    cr.moved = false;
+                    if (!moved && !(budgeted && cr.changed_tick != 0 && cr.changed_tick >= horizon))
+                        continue; // asleep or at rest since it was last delivered
                     if (!b2Body_IsValid(cr.body))
                         continue; // destroyed crates will handled by removed list
-                    b2Transform xf = b2Body_GetTransform(cr.body);
-                    float ang_deg = std::atan2(xf.q.s, xf.q.c) * 180.f / 3.14159265f;
                     // find cache entry
                     auto it = std::find_if(
                         ctx->last_sent_crates.begin(),
@@ -1175,28 +1612,67 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                         // new crate (unexpected after match start, but allow)
                         auto *cs = delta->add_crates();
                         cs->set_crate_id(cr.id);
-                        cs->set_x(xf.p.x);
-                        cs->set_y(xf.p.y);
-                        cs->set_angle(ang_deg);
-                        ctx->last_sent_crates.push_back({cr.id, xf.p.x, xf.p.y, ang_deg, true});
+                        cs->set_x(cr.x);
+                        cs->set_y(cr.y);
+                        cs->set_angle(cr.angle_deg);
+                        ctx->last_sent_crates.push_back({cr.id, cr.x, cr.y, cr.angle_deg, true});
+                        cr.changed_tick = static_cast<uint32_t>(ctx->server_tick);
+                        if (budgeted) {
+                            ctx->priority_items.push_back(
+                                {t2d::game::repl_key(t2d::game::ReplKind::Crate, cr.id),
+                                 cr.x,
+                                 cr.y,
+                                 1.f,
+                                 entry_bytes(*cs),
+                                 static_cast<uint32_t>(delta->crates_size() - 1),
+                                 true});
+                        }
                     } else {
-                        bool changed = std::fabs(it->x - xf.p.x) > 0.01f || std::fabs(it->y - xf.p.y) > 0.01f
-                            || std::fabs(it->angle - ang_deg) > 0.5f; // angle threshold 0.5 deg
-                        if (changed) {
+                        const float pos_eps = ctx->degradation.crate_pos_eps;
+                        bool changed = std::fabs(it->x - cr.x) > pos_eps || std::fabs(it->y - cr.y) > pos_eps
+                            || std::fabs(it->angle - cr.angle_deg) > ctx->degradation.crate_angle_eps_deg;
+                        if (changed || budgeted) {
                             auto *cs = delta->add_crates();
                             cs->set_crate_id(cr.id);
-                            cs->set_x(xf.p.x);
-                            cs->set_y(xf.p.y);
-                            cs->set_angle(ang_deg);
-                            it->x = xf.p.x;
-                            it->y = xf.p.y;
-                            it->angle = ang_deg;
+                            cs->set_x(cr.x);
+                            cs->set_y(cr.y);
+                            cs->set_angle(cr.angle_deg);
+                            if (budgeted) {
+                                float change_mag = changed
+                                    ? std::hypot(cr.x - it->x, cr.y - it->y)
+                                        + std::fabs(cr.angle_deg - it->angle) / 30.f
+                                    : 0.f;
+                                ctx->priority_items.push_back(
+                                    {t2d::game::repl_key(t2d::game::ReplKind::Crate, cr.id),
+                                     cr.x,
+                                     cr.y,
+                                     change_mag,
+                                     entry_bytes(*cs),
+                                     static_cast<uint32_t>(delta->crates_size() - 1),
+                                     changed});
+                            }
+                        }
+                        if (changed) {
+                            it->x = cr.x;
+                            it->y = cr.y;
+                            it->angle = cr.angle_deg;
                             it->alive = true;
+                            cr.changed_tick = static_cast<uint32_t>(ctx->server_tick);
                         }
                     }
                 }
-                for (auto cid : ctx->removed_crates_since_full)
-                    delta->add_removed_crates(cid);
+                for (const auto &r : ctx->removed_crates_since_full)
+                    delta->add_removed_crates(r.id);
+                // Ammo box (de)activations the oldest base may not reflect yet; few boxes, so no budget accounting.
+                for (const auto &ab : ctx->ammo_boxes) {
+                    if (ab.changed_tick == 0 || ab.changed_tick < horizon)
+                        continue;
+                    auto *bx = delta->add_ammo_boxes();
+                    bx->set_box_id(ab.id);
+                    bx->set_x(ab.x);
+                    bx->set_y(ab.y);
+                    bx->set_active(ab.active);
+                }
 #if T2D_PROFILING_ENABLED
                 {
                     auto now = std::chrono::steady_clock::now();
@@ -1205,7 +1681,8 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     phase_prev_delta = now;
                 }
 #endif
-                // Deltas for ammo boxes omitted (they are static until picked up; appear only in full snapshots)
+                if (has_tick_events)
+                    delta->mutable_events()->Swap(&ctx->tick_events);
                 {
 #if T2D_PROFILING_ENABLED
                     bool reused = !ctx->snapshot_scratch.empty();
@@ -1214,7 +1691,8 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     if (!sm.SerializeToString(&ctx->snapshot_scratch)) {
                         // skip metrics if failure
                     } else {
-                        t2d::metrics::add_delta(ctx->snapshot_scratch.size());
+                        if (!budgeted) // budgeted frames are recorded per client in send_budgeted_deltas
+                            t2d::metrics::add_delta(ctx->snapshot_scratch.size());
 #if T2D_PROFILING_ENABLED
                         t2d::metrics::add_snapshot_scratch_usage(reused);
                         t2d::metrics::add_snapshot_delta_entity_counts(
@@ -1233,8 +1711,10 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
 #if T2D_ENABLE_SNAPSHOT_QUANT
                 // As above, compression logic lives in snapshot_compress.* (not applied to wire in prototype)
 #endif
-                for (auto &pl : ctx->players)
-                    t2d::mm::instance().push_message(pl, sm);
+                if (budgeted)
+                    send_budgeted_deltas(*ctx, *delta);
+                else
+                    send_deltas_by_base(*ctx, sm);
 #if T2D_PROFILING_ENABLED
                 auto snap_dur =
                     std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - snap_start)
@@ -1242,15 +1722,21 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 t2d::metrics::add_snapshot_delta_build_time((uint64_t)snap_dur);
 #endif
             }
-            if (send_full) {
-                // Clear removed lists after full snapshot baseline
-                ctx->removed_projectiles_since_full.clear();
-                ctx->removed_tanks_since_full.clear();
-                ctx->removed_crates_since_full.clear();
-            }
+            finish_keyframes(*ctx);
         }
+        mark_phase(TickPhase::Snapshot, clock::now());
+        rec.snapshot = snapshot_tick;
+        // Ticks without a snapshot still deliver their events promptly as one standalone batch message.
+        if (has_tick_events && !snapshot_tick) {
+            t2d::ServerMessage evmsg;
+            evmsg.mutable_tick_events()->Swap(&ctx->tick_events);
+            t2d::mm::instance().push_message_all(ctx->players, evmsg);
+        }
+        ctx->tick_events.Clear();
         // Emit aggregated KillFeedUpdate if any events occurred this tick
-        if (!ctx->kill_feed_events.empty()) {
+        if (ctx->headless) {
+            ctx->kill_feed_events.clear();
+        } else if (!ctx->kill_feed_events.empty()) {
             t2d::ServerMessage kfmsg;
             auto *kf = kfmsg.mutable_kill_feed();
             for (auto &e : ctx->kill_feed_events) {
@@ -1258,8 +1744,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 ev->set_victim_id(e.first);
                 ev->set_attacker_id(e.second);
             }
-            for (auto &pl : ctx->players)
-                t2d::mm::instance().push_message(pl, kfmsg);
+            t2d::mm::instance().push_message_all(ctx->players, kfmsg);
             ctx->kill_feed_events.clear();
         }
         // Victory condition: only one (or zero) alive tank remains OR time limit reached.
@@ -1293,8 +1778,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 me->set_match_id(ctx->match_id);
                 me->set_winner_entity_id(ctx->winner_entity);
                 me->set_server_tick(static_cast<uint32_t>(ctx->server_tick));
-                for (auto &pl : ctx->players)
-                    t2d::mm::instance().push_message(pl, endmsg);
+                t2d::mm::instance().push_message_all(ctx->players, endmsg);
                 ctx->match_end_sent = true;
                 t2d::log::info("[match] over id={} winner_entity={}", ctx->match_id, ctx->winner_entity);
             }
@@ -1318,8 +1802,7 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                 me->set_match_id(ctx->match_id);
                 me->set_winner_entity_id(ctx->winner_entity);
                 me->set_server_tick(static_cast<uint32_t>(ctx->server_tick));
-                for (auto &pl : ctx->players)
-                    t2d::mm::instance().push_message(pl, endmsg);
+                t2d::mm::instance().push_message_all(ctx->players, endmsg);
                 ctx->match_end_sent = true;
                 t2d::log::info("[match] over (hard cap) id={} winner_entity={}", ctx->match_id, ctx->winner_entity);
             }
@@ -1338,12 +1821,53 @@ coro::task<void> run_match(std::shared_ptr<coro::io_scheduler> scheduler, std::s
                     ++bots;
             if (bots > 0)
                 t2d::metrics::runtime().bots_in_match.fetch_sub(bots, std::memory_order_relaxed);
+            // Bots go back to the pool for the next bot fill (they never entered the session registry).
+            t2d::mm::instance().release_bots(ctx->players);
+            t2d::mm::admission().finish(ctx->admission_load, clock::now());
             co_return;
         }
         // Record runtime metrics
         t2d::metrics::runtime().projectiles_active.store(ctx->projectile_indices.size(), std::memory_order_relaxed);
-        auto tick_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - tick_start).count();
-        t2d::metrics::add_tick_duration(static_cast<uint64_t>(tick_ns));
+        const auto tick_end = clock::now();
+        auto tick_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tick_end - tick_start).count();
+        if (fast_forward) {
+            // Reduced-fidelity ticks would drag down the governor p95 and the admission cost model; count them apart.
+            t2d::metrics::runtime().fast_forward_ticks.fetch_add(1, std::memory_order_relaxed);
+            t2d::metrics::runtime().fast_forward_tick_ns_total.fetch_add(
+                static_cast<uint64_t>(tick_ns), std::memory_order_relaxed
+            );
+        } else {
+            t2d::metrics::add_tick_duration(static_cast<uint64_t>(tick_ns));
+            t2d::game::governor().record_tick(static_cast<uint64_t>(tick_ns), tick_end);
+            if (ctx->admission_load)
+                ctx->admission_load->record_tick(static_cast<uint64_t>(tick_ns));
+        }
+        mark_phase(TickPhase::Events, tick_end);
+        phase_perf.commit(rec.phase_ns); // per-phase totals for /metrics and the profiling summary
+        // Flight recorder: close this tick's record; a tick over the threshold dumps the history off this thread.
+        rec.tick = ctx->server_tick;
+        rec.total_ns = static_cast<uint32_t>(std::min<int64_t>(tick_ns, UINT32_MAX));
+        for (const auto &t : ctx->tanks)
+            rec.tanks_alive += t.hp > 0 ? 1 : 0;
+        rec.projectiles = static_cast<uint32_t>(ctx->projectile_indices.size());
+        rec.allocations = static_cast<uint32_t>(
+            t2d::metrics::runtime().allocations_total.load(std::memory_order_relaxed) - rec_allocs);
+        rec.allocated_bytes =
+            t2d::metrics::runtime().allocations_bytes_total.load(std::memory_order_relaxed) - rec_alloc_bytes;
+        rec.matchmaking_queue =
+            static_cast<uint32_t>(t2d::metrics::runtime().queue_depth.load(std::memory_order_relaxed));
+        if (recorder.enabled()) {
+            rec.outbound_pending = static_cast<uint32_t>(t2d::mm::instance().outbound_pending(ctx->players));
+            if (auto dump = recorder.finish_tick(tick_end)) {
+                t2d::log::warn(
+                    "[match] slow tick id={} tick={} took {} us, writing flight record {}",
+                    ctx->match_id,
+                    ctx->server_tick,
+                    tick_ns / 1000,
+                    dump->path);
+                write_flight_dump_async(std::move(*dump));
+            }
+        }
 #if T2D_PROFILING_ENABLED
         uint64_t alloc_after = t2d::metrics::runtime().allocations_total.load(std::memory_order_relaxed);
         uint64_t alloc_bytes_after = t2d::metrics::runtime().allocations_bytes_total.load(std::memory_order_relaxed);
@@ -1,8 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
+#include "common/projectile_extrapolation.hpp"
 #include "game.pb.h"
+#include "server/game/map_format.hpp"
+#include "server/game/overload_governor.hpp"
 #include "server/game/physics.hpp"
+#include "server/game/snapshot_budget.hpp"
+#include "server/matchmaking/admission.hpp"
 #include "server/matchmaking/session_manager.hpp"
+#include "server/runtime/huge_pages.hpp"
 
 #include <coro/coro.hpp>
 #include <coro/io_scheduler.hpp>
@@ -14,14 +20,26 @@
 
 namespace t2d::game {
 
+// What a match does once no human can receive its output (every human disconnected; dead humans still connected
+// keep spectating). Snapshots, tick events and kill feed stop in both End and FastForward.
+enum class HeadlessPolicy : uint8_t
+{
+    Keep, // legacy: simulate and encode until the match ends on its own
+    End, // end now; winner = the alive tank with the most hp (draw on a tie)
+    FastForward, // play the rest at 4x the tick rate and reduced fidelity (1 physics sub-step, bot AI every 4th tick)
+};
+
+bool parse_headless_policy(const std::string &name, HeadlessPolicy &out);
+
 struct MatchContext
 {
     std::string match_id;
     uint32_t tick_rate{30};
     uint32_t initial_player_count{0};
     std::vector<std::shared_ptr<t2d::mm::Session>> players;
-    // Physics tanks (authoritative). Index aligned with players.
-    std::vector<t2d::phys::TankWithTurret> tanks;
+    // Physics tanks (authoritative). Index aligned with players. The arrays walked every tick are HotVectors: on huge
+    // pages when huge_pages is configured (see server/runtime/huge_pages.hpp).
+    t2d::runtime::HotVector<t2d::phys::TankWithTurret> tanks;
     // Shared physics world (created at match start)
     std::unique_ptr<t2d::phys::World> physics_world;
     uint64_t server_tick{0};
@@ -44,6 +62,9 @@ struct MatchContext
     // Map dimensions (authoritative bounds) and static wall bodies created at match start.
     float map_width{300.f};
     float map_height{200.f};
+    // Optional static map (shared read-only mapping). When set, walls/crates/ammo come from the map instead of the
+    // inline boundary walls and seeded random clusters.
+    std::shared_ptr<const t2d::map::MappedMap> map;
 
     // Cached last sent snapshot state (angles/positions/ammo/hp) for delta generation.
     struct SentTankCache
@@ -58,7 +79,7 @@ struct MatchContext
         bool alive{false};
     };
 
-    std::vector<SentTankCache> last_sent_tanks;
+    t2d::runtime::HotVector<SentTankCache> last_sent_tanks;
 
     struct ProjectileSimple
     {
@@ -75,16 +96,25 @@ struct MatchContext
         uint32_t owner;
         float initial_speed{0.f};
         float age{0.f}; // seconds since spawn
+        // Replicated ballistic sample (what clients extrapolate from); re-taken when the trajectory changes.
+        t2d::proj::Ballistic repl;
+        bool repl_dirty{false}; // sample not yet carried by a delta (spawn or trajectory change)
     };
 
     float projectile_max_lifetime_sec{5.0f}; // lifespan cap after spawn
+    // Spawn-only projectile replication: deltas carry a projectile only when spawned or when Box2D changed its
+    // trajectory beyond the tolerances below; clients extrapolate in between. false = resend every projectile in
+    // every delta (legacy).
+    bool projectile_spawn_only{true};
+    float projectile_resend_pos_tolerance{0.05f}; // world units
+    float projectile_resend_vel_tolerance{0.05f}; // units / second
 
     // Active projectile slots referenced by index into projectiles_storage (no per-tick copy)
-    std::vector<uint32_t> projectile_indices;
+    t2d::runtime::HotVector<uint32_t> projectile_indices;
     uint32_t next_projectile_id{1};
     // Projectile object pool (freelist indices into projectiles_storage)
-    std::vector<ProjectileSimple> projectiles_storage; // stable capacity, entries reused
-    std::vector<uint32_t> projectile_free_indices; // indices in storage available for reuse
+    t2d::runtime::HotVector<ProjectileSimple> projectiles_storage; // stable capacity, entries reused
+    t2d::runtime::HotVector<uint32_t> projectile_free_indices; // indices in storage available for reuse
     uint32_t projectile_pool_hwm{0}; // high-water mark (for future heuristics)
 
     // Crates (movable obstacles) represented only by physics bodies; snapshot not yet serialized (visual client side
@@ -93,6 +123,12 @@ struct MatchContext
     {
         uint32_t id;
         b2BodyId body;
+        // Transform mirrored from Box2D body move events after each step: sleeping crates are never read back.
+        float x{0};
+        float y{0};
+        float angle_deg{0};
+        bool moved{false}; // moved since the last delta pass
+        uint32_t changed_tick{0}; // last delta pass that marked it dirty (budgeted mode keeps it listed until seen)
     };
 
     std::vector<CrateInfo> crates;
@@ -108,7 +144,16 @@ struct MatchContext
     };
 
     std::vector<SentCrateCache> last_sent_crates; // cached for delta comparison
-    std::vector<uint32_t> removed_crates_since_full;
+
+    // Removal record stamped with its tick. Kept until every client holds a keyframe built after it (see
+    // client_keyframes); resending an older removal is harmless because entity ids are never reused.
+    struct RemovedEntity
+    {
+        uint32_t id;
+        uint32_t tick;
+    };
+
+    std::vector<RemovedEntity> removed_crates_since_full;
 
     struct AmmoBoxInfo
     {
@@ -117,13 +162,14 @@ struct MatchContext
         bool active;
         float x;
         float y;
+        uint32_t changed_tick{0}; // tick of the last activation / deactivation (0 = match start state)
     };
 
     std::vector<AmmoBoxInfo> ammo_boxes; // mirrored to snapshot
     uint32_t next_ammo_box_id{1};
-    // Removed entities since last full snapshot (for delta)
-    std::vector<uint32_t> removed_projectiles_since_full;
-    std::vector<uint32_t> removed_tanks_since_full; // future (on disconnect / destroy)
+    // Removed entities since the oldest keyframe any client still builds on (for delta)
+    std::vector<RemovedEntity> removed_projectiles_since_full;
+    std::vector<RemovedEntity> removed_tanks_since_full; // future (on disconnect / destroy)
     // Simple per-tank reload timers (seconds until next ammo +1); 0 = ready to accumulate
     std::vector<float> reload_timers;
     uint32_t max_ammo{10};
@@ -136,6 +182,37 @@ struct MatchContext
     uint32_t post_end_grace_ticks{0}; // set to tick_rate when match ends (== 1s grace)
     // Aggregated kill feed events for batching per tick (victim, attacker)
     std::vector<std::pair<uint32_t, uint32_t>> kill_feed_events;
+    // Damage / destroy / pickup events of the current tick. Assembled once, then swapped into this tick's snapshot
+    // (or a standalone TickEvents message when no snapshot is due) and cleared.
+    t2d::TickEvents tick_events;
+    // Staggered keyframes: every client gets its full snapshot on its own phase of full_snapshot_interval_ticks
+    // (spread by player index) or on demand after a KeyframeRequest (rate limited), so full snapshots never go to
+    // all clients on the same tick. Deltas carry the recipient's own keyframe tick as base_tick. Index aligned with
+    // players; initialised on the first snapshot tick.
+    struct ClientKeyframeState
+    {
+        uint32_t last_full_tick{0}; // match-start baseline is tick 0
+        uint32_t next_full_tick{0}; // next periodic keyframe (phase preserved across on-demand keyframes)
+        uint32_t last_request_tick{0};
+        bool request_pending{false}; // asked during cooldown; served once it expires
+        bool due{false}; // receives a full snapshot on the current snapshot tick
+    };
+
+    bool keyframe_stagger{true}; // false = legacy synchronized full snapshots
+    uint32_t keyframe_request_cooldown_ticks{15};
+    std::vector<ClientKeyframeState> client_keyframes;
+    std::vector<size_t> keyframe_requests; // scratch: players that asked for a keyframe since the last snapshot tick
+    // Bandwidth-budgeted deltas (priority_tuning.budget_bytes > 0). The shared delta pass then lists every live
+    // entity (dirty or not) and records one PriorityItem per entry; each human client gets its own delta packed by
+    // its accumulator (index aligned with players). Full snapshots reset all accumulators.
+    PriorityTuning priority_tuning;
+    std::vector<PriorityAccumulator> client_priority;
+    t2d::runtime::HotVector<PriorityItem> priority_items;
+    std::vector<uint32_t> priority_selection; // scratch
+    // Overload governor profile, sampled at the start of every tick (see overload_governor.hpp).
+    Degradation degradation;
+    // Admission control registration (matchmaker); tick costs train the match cost model when the match ends.
+    std::shared_ptr<t2d::mm::MatchLoad> admission_load;
     // Reusable scratch buffer for snapshot serialization size estimation (SerializeToString target)
     // Grows on demand, never shrinks during match lifetime. Profiling builds record reuse metric.
     std::string snapshot_scratch;
@@ -144,6 +221,8 @@ struct MatchContext
     // Damage thresholds (copied from match config)
     uint32_t track_break_hits{1};
     uint32_t turret_disable_front_hits{2};
+    HeadlessPolicy headless_policy{HeadlessPolicy::End};
+    bool headless{false}; // set once no human recipient is left (never cleared: a dropped session cannot rejoin)
 };
 
 inline float movement_speed()
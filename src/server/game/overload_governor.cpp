@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/game/overload_governor.hpp"
+
+#include <algorithm>
+
+namespace t2d::game {
+
+namespace {
+
+constexpr std::array<Degradation, OverloadGovernor::kLevels> kProfiles{{
+    {1, 1, 1.f, 1.f, 0.01f, 0.5f},
+    {2, 1, 1.f, 1.f, 0.01f, 0.5f},
+    {2, 3, 1.f, 1.f, 0.01f, 0.5f},
+    {2, 3, 0.5f, 4.f, 0.01f, 0.5f},
+    {2, 3, 0.5f, 4.f, 0.05f, 2.f},
+}};
+
+constexpr std::array<const char *, OverloadGovernor::kLevels> kNames{
+    "normal", "snapshots", "ai_lod", "interest", "precision"};
+
+int64_t to_ns(std::chrono::steady_clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+} // namespace
+
+const Degradation &OverloadGovernor::degradation(uint32_t level)
+{
+    return kProfiles[std::min<uint32_t>(level, kLevels - 1)];
+}
+
+const char *OverloadGovernor::level_name(uint32_t level)
+{
+    return level < kLevels ? kNames[level] : "?";
+}
+
+void OverloadGovernor::configure(const GovernorConfig &cfg, std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard lk(m_mutex);
+    m_cfg = cfg;
+    m_cfg.max_level = std::min<uint32_t>(cfg.max_level, kLevels - 1);
+    m_cfg.window_ms = std::max<uint32_t>(cfg.window_ms, 1);
+    m_bucket_ns = std::max<uint64_t>(uint64_t(cfg.tick_budget_us) * 1000 / 32, 1);
+    for (auto &b : m_hist)
+        b.store(0, std::memory_order_relaxed);
+    m_level.store(0, std::memory_order_relaxed);
+    m_max_level.store(m_cfg.max_level, std::memory_order_relaxed);
+    m_calm_windows = 0;
+    m_last_p95_us = 0;
+    m_escalations = 0;
+    m_recoveries = 0;
+    m_time_at_level_ns.fill(0);
+    m_level_since = now;
+    m_window_end_ns.store(to_ns(now) + int64_t(m_cfg.window_ms) * 1'000'000, std::memory_order_relaxed);
+    m_enabled.store(cfg.enabled, std::memory_order_release);
+}
+
+void OverloadGovernor::record_tick(uint64_t tick_ns, std::chrono::steady_clock::time_point now)
+{
+    if (!m_enabled.load(std::memory_order_acquire))
+        return;
+    const size_t bucket = std::min<uint64_t>(tick_ns / m_bucket_ns, kBuckets - 1);
+    m_hist[bucket].fetch_add(1, std::memory_order_relaxed);
+    const int64_t now_ns = to_ns(now);
+    int64_t due = m_window_end_ns.load(std::memory_order_relaxed);
+    if (now_ns < due)
+        return;
+    // Claim the window; matches losing the race just keep ticking.
+    if (!m_window_end_ns.compare_exchange_strong(
+            due, now_ns + int64_t(m_cfg.window_ms) * 1'000'000, std::memory_order_acq_rel))
+        return;
+    std::lock_guard lk(m_mutex);
+    evaluate_locked(now);
+}
+
+uint32_t OverloadGovernor::evaluate(std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard lk(m_mutex);
+    m_window_end_ns.store(to_ns(now) + int64_t(m_cfg.window_ms) * 1'000'000, std::memory_order_relaxed);
+    return evaluate_locked(now);
+}
+
+uint32_t OverloadGovernor::evaluate_locked(std::chrono::steady_clock::time_point now)
+{
+    std::array<uint64_t, kBuckets> counts{};
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        counts[i] = m_hist[i].exchange(0, std::memory_order_relaxed);
+        total += counts[i];
+    }
+    uint32_t level = m_level.load(std::memory_order_relaxed);
+    if (!m_cfg.enabled || total < m_cfg.min_samples)
+        return level;
+
+    // p95 as the upper edge of the bucket holding it (overflow reads as 2x budget): errs towards degrading.
+    const uint64_t rank = (total * 95 + 99) / 100;
+    uint64_t seen = 0;
+    size_t p95_bucket = kBuckets - 1;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            p95_bucket = i;
+            break;
+        }
+    }
+    const uint64_t p95_ns = (p95_bucket + 1) * m_bucket_ns;
+    m_last_p95_us = p95_ns / 1000;
+    const uint64_t budget_ns = uint64_t(m_cfg.tick_budget_us) * 1000;
+
+    uint32_t next = level;
+    if (p95_ns * 100 > budget_ns * m_cfg.escalate_pct) {
+        m_calm_windows = 0;
+        if (level < m_cfg.max_level)
+            next = level + 1;
+    } else if (p95_ns * 100 < budget_ns * m_cfg.recover_pct) {
+        if (++m_calm_windows >= m_cfg.recover_windows && level > 0) {
+            next = level - 1;
+            m_calm_windows = 0;
+        }
+    } else {
+        m_calm_windows = 0; // inside the hysteresis band: hold
+    }
+    if (next != level) {
+        m_time_at_level_ns[level] += uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                  now - m_level_since)
+                                                  .count());
+        m_level_since = now;
+        (next > level ? m_escalations : m_recoveries) += 1;
+        m_level.store(next, std::memory_order_relaxed);
+    }
+    return next;
+}
+
+OverloadGovernor::Stats OverloadGovernor::stats(std::chrono::steady_clock::time_point now) const
+{
+    std::lock_guard lk(m_mutex);
+    Stats st;
+    st.level = m_level.load(std::memory_order_relaxed);
+    st.last_p95_us = m_last_p95_us;
+    st.escalations = m_escalations;
+    st.recoveries = m_recoveries;
+    for (size_t i = 0; i < kLevels; ++i)
+        st.time_at_level_ms[i] = m_time_at_level_ns[i] / 1'000'000;
+    if (now > m_level_since)
+        st.time_at_level_ms[st.level]
+            += uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(now - m_level_since).count());
+    return st;
+}
+
+OverloadGovernor &governor()
+{
+    static OverloadGovernor g;
+    return g;
+}
+
+} // namespace t2d::game
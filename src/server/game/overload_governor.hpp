@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// overload_governor.hpp - process-wide tick budget governor. Every match records its tick cost; once per window the
+// governor compares the window's p95 with the tick budget (the SLA in docs/performance_plan.md) and moves one
+// degradation level up (p95 above escalate_pct of the budget) or, after recover_windows calm windows in a row, one
+// level down. Matches read the current level at the start of each tick, so an overload costs some fidelity for
+// everyone instead of overrunning ticks (rubber-banding) for everyone.
+//
+// Levels are cumulative:
+//   0 normal
+//   1 snapshots  - delta snapshot interval doubled
+//   2 ai lod     - bots re-plan every 3rd tick, holding their last steering in between
+//   3 interest   - budgeted deltas: priority ref distance halved (far entities age slower); projectile resend
+//                  tolerances x4
+//   4 precision  - crate delta thresholds 0.05 units / 2 degrees (from 0.01 / 0.5)
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace t2d::game {
+
+struct GovernorConfig
+{
+    bool enabled{false};
+    uint32_t tick_budget_us{5000}; // S2 SLA: p99 tick < 5 ms
+    uint32_t escalate_pct{80}; // window p95 above this share of the budget -> one level up
+    uint32_t recover_pct{50}; // window p95 below this share -> counts as a calm window
+    uint32_t window_ms{1000};
+    uint32_t recover_windows{3}; // calm windows in a row before one level down
+    uint32_t max_level{4};
+    uint32_t min_samples{30}; // windows with fewer ticks keep the level (idle server, startup)
+};
+
+struct Degradation
+{
+    uint32_t snapshot_interval_mult{1};
+    uint32_t ai_stride{1};
+    float interest_distance_scale{1.f};
+    float projectile_tolerance_scale{1.f};
+    float crate_pos_eps{0.01f}; // world units
+    float crate_angle_eps_deg{0.5f};
+};
+
+class OverloadGovernor
+{
+public:
+    static constexpr uint32_t kLevels = 5;
+    static constexpr size_t kBuckets = 64; // budget / 32 wide: covers 2x the budget, last bucket = overflow
+
+    static const Degradation &degradation(uint32_t level);
+    static const char *level_name(uint32_t level);
+
+    // Clears all state (levels, windows, time accounting).
+    void configure(const GovernorConfig &cfg, std::chrono::steady_clock::time_point now);
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Called by every match at the end of its tick; evaluates the window when it is due (one caller wins).
+    void record_tick(uint64_t tick_ns, std::chrono::steady_clock::time_point now);
+    // Closes the current window now (tests, shutdown). Returns the level afterwards.
+    uint32_t evaluate(std::chrono::steady_clock::time_point now);
+
+    uint32_t level() const { return m_level.load(std::memory_order_relaxed); }
+    uint32_t max_level() const { return m_max_level.load(std::memory_order_relaxed); }
+    const Degradation &current() const { return degradation(level()); }
+
+    struct Stats
+    {
+        uint32_t level{0};
+        uint64_t last_p95_us{0};
+        uint64_t escalations{0};
+        uint64_t recoveries{0};
+        std::array<uint64_t, kLevels> time_at_level_ms{}; // including the running stretch of the current level
+    };
+    Stats stats(std::chrono::steady_clock::time_point now) const;
+
+private:
+    uint32_t evaluate_locked(std::chrono::steady_clock::time_point now);
+
+    GovernorConfig m_cfg;
+    std::atomic_bool m_enabled{false};
+    std::atomic<uint32_t> m_level{0};
+    std::atomic<uint32_t> m_max_level{0}; // configured (clamped) max_level, for readers outside the mutex
+    std::atomic<int64_t> m_window_end_ns{0}; // steady_clock epoch ns of the next evaluation
+    std::array<std::atomic<uint64_t>, kBuckets> m_hist{};
+    uint64_t m_bucket_ns{1};
+
+    mutable std::mutex m_mutex; // evaluation + stats below
+    uint32_t m_calm_windows{0};
+    uint64_t m_last_p95_us{0};
+    uint64_t m_escalations{0};
+    uint64_t m_recoveries{0};
+    std::array<uint64_t, kLevels> m_time_at_level_ns{};
+    std::chrono::steady_clock::time_point m_level_since{};
+};
+
+// Process-wide instance read by the match loop (configured from main).
+OverloadGovernor &governor();
+
+} // namespace t2d::game
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "server/game/physics.hpp"
 
+#include "common/rot_angle.hpp"
+#include "server/runtime/huge_pages.hpp"
+
 #include <algorithm>
 #include <cmath>
 
@@ -191,21 +194,20 @@ void update_turret_aim(const TurretAimInput &aim, TankWithTurret &tank)
         return;
     }
 
-    if (!aim.target_angle_world || !b2Joint_IsValid(tank.turret_joint)) {
+    if ((!aim.target_angle_world && !aim.relative_turn) || !b2Joint_IsValid(tank.turret_joint)) {
         return;
     }
 
-    float target = *aim.target_angle_world;
-    // Current turret world angle
-    b2Transform t_tur = b2Body_GetTransform(tank.turret);
-    float current = std::atan2(t_tur.q.s, t_tur.q.c);
-    // Shortest arc difference in radians (-pi, pi]
-    float diff = target - current;
-    const float two_pi = 2.f * (float)M_PI;
-    diff = std::fmod(diff + (float)M_PI, two_pi);
-    if (diff < 0.f)
-        diff += two_pi;
-    diff -= (float)M_PI;
+    // Shortest arc difference in radians (-pi, pi]: a world target is compared with the turret rotation through
+    // dot / cross, so neither side is converted to an angle.
+    float diff = 0.f;
+    if (aim.target_angle_world) {
+        const b2Rot current = b2Body_GetRotation(tank.turret);
+        const b2Rot target = b2MakeRot(*aim.target_angle_world);
+        diff = t2d::math::rot_diff_rad(current.c, current.s, target.c, target.s);
+    } else {
+        diff = *aim.relative_turn;
+    }
 
     // Parameters (radians)
     constexpr float kMaxSpeedDeg = 180.f; // desired max turret speed deg/s
@@ -250,21 +252,20 @@ uint32_t fire_projectile_if_ready(
     // Base projectile velocity along barrel forward plus inherited velocity
     b2Vec2 proj_v{tf.forward.x * speed + inherit_v.x, tf.forward.y * speed + inherit_v.y};
     uint32_t pid = next_projectile_id;
-    // Orient projectile to barrel forward direction (angle of turret forward vector)
-    float barrel_angle = std::atan2(tf.forward.y, tf.forward.x);
-    create_projectile(world, muzzle.x, muzzle.y, proj_v.x, proj_v.y, density, barrel_angle);
+    // Orient projectile to barrel forward direction (the turret forward vector is its rotation)
+    create_projectile(world, muzzle.x, muzzle.y, proj_v.x, proj_v.y, density, b2Rot{tf.forward.x, tf.forward.y});
     tank.fire_cooldown_cur = tank.fire_cooldown_max;
     tank.ammo--;
     return pid;
 }
 
-b2BodyId create_projectile(World &w, float x, float y, float vx, float vy, float density, float angle_rad)
+b2BodyId create_projectile(World &w, float x, float y, float vx, float vy, float density, b2Rot rotation)
 {
     b2BodyDef bd = b2DefaultBodyDef();
     bd.type = b2_dynamicBody;
     bd.position = {x, y};
     bd.isBullet = true;
-    bd.rotation = b2MakeRot(angle_rad);
+    bd.rotation = rotation;
     b2BodyId body = b2CreateBody(w.id, &bd);
     b2ShapeDef sd = b2DefaultShapeDef();
     sd.density = density;
@@ -318,14 +319,40 @@ b2BodyId create_ammo_box(World &w, float x, float y, float radius)
     return body;
 }
 
+b2BodyId create_map_geometry(World &w, const t2d::map::MapView &map)
+{
+    b2BodyDef bd = b2DefaultBodyDef();
+    bd.type = b2_staticBody;
+    b2BodyId body = b2CreateBody(w.id, &bd);
+    // Same filter as the legacy boundary walls: static collider for tanks, projectiles and crates.
+    b2Filter filter = b2DefaultFilter();
+    filter.categoryBits = CAT_BODY;
+    filter.maskBits = CAT_PROJECTILE | CAT_BODY | CAT_CRATE;
+    std::vector<b2Vec2> pts;
+    for (const auto &c : map.chains) {
+        auto src = map.chain_points(c);
+        pts.clear();
+        pts.reserve(src.size());
+        for (const auto &p : src)
+            pts.push_back({p.x, p.y});
+        b2ChainDef cd = b2DefaultChainDef();
+        cd.points = pts.data();
+        cd.count = static_cast<int>(pts.size());
+        cd.isLoop = (c.flags & 1u) != 0;
+        cd.filter = filter;
+        b2CreateChain(body, &cd);
+    }
+    return body;
+}
+
 b2Vec2 get_body_position(b2BodyId id)
 {
     return b2Body_GetPosition(id);
 }
 
-void step(World &w, float dt)
+void step(World &w, float dt, int sub_steps)
 {
-    b2World_Step(w.id, dt, 4);
+    b2World_Step(w.id, dt, sub_steps);
 }
 
 void destroy_body(b2BodyId id)
@@ -335,4 +362,20 @@ void destroy_body(b2BodyId id)
     }
 }
 
+static void *huge_page_alloc(unsigned int size, int alignment)
+{
+    return t2d::runtime::HugePageHeap::instance().allocate(size, static_cast<size_t>(alignment));
+}
+
+static void huge_page_free(void *mem)
+{
+    t2d::runtime::HugePageHeap::instance().deallocate(mem);
+}
+
+void use_huge_page_heap()
+{
+    if (t2d::runtime::HugePageHeap::instance().enabled())
+        b2SetAllocator(huge_page_alloc, huge_page_free);
+}
+
 } // namespace t2d::phys
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
 // physics.hpp - Tank physics (hull + turret) and projectile integration
 #pragma once
+#include "server/game/map_format.hpp"
+
 #include <box2d/box2d.h>
 
 #include <algorithm>
@@ -65,6 +67,9 @@ struct TankDriveInput
 struct TurretAimInput
 {
     std::optional<float> target_angle_world; // radians
+    // Turn relative to the current turret heading (radians, counter-clockwise positive) when no world target is
+    // given; callers steering by input axes never convert the turret rotation to an angle.
+    std::optional<float> relative_turn;
 };
 
 struct BodyFrame
@@ -84,11 +89,17 @@ uint32_t fire_projectile_if_ready(
     TankWithTurret &tank, World &world, float speed, float density, float forward_offset, uint32_t next_projectile_id);
 
 // Projectile / object creation (moved out-of-line to reduce header churn)
-b2BodyId create_projectile(World &w, float x, float y, float vx, float vy, float density, float angle_rad);
+b2BodyId create_projectile(World &w, float x, float y, float vx, float vy, float density, b2Rot rotation);
 b2BodyId create_crate(World &w, float x, float y, float halfExtent);
 b2BodyId create_ammo_box(World &w, float x, float y, float radius);
+// Builds all static map geometry as ONE static body carrying the pre-merged chain loops from the map image.
+b2BodyId create_map_geometry(World &w, const t2d::map::MapView &map);
 b2Vec2 get_body_position(b2BodyId id);
-void step(World &w, float dt);
+void step(World &w, float dt, int sub_steps = 4);
 void destroy_body(b2BodyId id);
 
+// Routes Box2D's internal allocations (bodies, shapes, contacts, broadphase, solver stacks) through the huge page
+// heap (server/runtime/huge_pages.hpp). Must run before the first world is created; no-op while the heap is off.
+void use_huge_page_heap();
+
 } // namespace t2d::phys
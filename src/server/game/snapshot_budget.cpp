@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/game/snapshot_budget.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace t2d::game {
+
+void PriorityAccumulator::select(
+    std::span<const PriorityItem> items,
+    float viewer_x,
+    float viewer_y,
+    const PriorityTuning &tuning,
+    uint32_t budget_bytes,
+    std::vector<uint32_t> &out,
+    PackStats &stats)
+{
+    ++m_frame;
+    m_candidates.clear();
+    const float ref = tuning.ref_distance > 0.f ? tuning.ref_distance : 1.f;
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        const auto &it = items[i];
+        auto found = m_entries.find(it.key);
+        if (found == m_entries.end()) {
+            if (!it.dirty)
+                continue; // client already has the latest state
+            found = m_entries.emplace(it.key, Entry{}).first;
+        }
+        auto &e = found->second;
+        float dx = it.x - viewer_x;
+        float dy = it.y - viewer_y;
+        float dist = std::sqrt(dx * dx + dy * dy);
+        e.priority += (1.f + tuning.change_weight * it.change) / (1.f + dist / ref);
+        e.seen_frame = m_frame;
+        m_candidates.push_back({e.priority, i});
+    }
+    // Entities that vanished (destroyed / expired) are covered by the removed_* lists; drop their accumulators.
+    std::erase_if(m_entries, [&](const auto &kv) { return kv.second.seen_frame != m_frame; });
+    std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.priority > b.priority || (a.priority == b.priority && a.index < b.index);
+    });
+    uint32_t used = 0;
+    bool any = false;
+    for (const auto &c : m_candidates) {
+        uint32_t bytes = items[c.index].bytes;
+        if (any && used + bytes > budget_bytes) {
+            ++stats.deferred;
+            stats.priority_deferred_max = std::max(stats.priority_deferred_max, c.priority);
+            continue;
+        }
+        any = true;
+        used += bytes;
+        out.push_back(c.index);
+        ++stats.sent;
+        stats.priority_sent_sum += c.priority;
+        m_entries.erase(items[c.index].key);
+    }
+    stats.bytes += used;
+}
+
+} // namespace t2d::game
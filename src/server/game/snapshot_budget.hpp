@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+// snapshot_budget.hpp - Per-client priority accumulators for byte-budgeted delta snapshots
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace t2d::game {
+
+// Entity kinds share one accumulator table; the kind is folded into the key so ids never collide.
+enum class ReplKind : uint8_t
+{
+    Tank = 1,
+    Projectile = 2,
+    Crate = 3
+};
+
+inline constexpr uint64_t repl_key(ReplKind kind, uint32_t id)
+{
+    return (static_cast<uint64_t>(kind) << 32) | id;
+}
+
+inline constexpr ReplKind repl_kind(uint64_t key)
+{
+    return static_cast<ReplKind>(key >> 32);
+}
+
+struct PriorityTuning
+{
+    uint32_t budget_bytes{0}; // per client per delta frame (0 = unlimited, budgeting disabled)
+    float ref_distance{20.f}; // distance (world units) at which priority growth halves
+    float change_weight{1.f}; // multiplier for the per-frame change magnitude
+};
+
+// One replicable entity as seen by the shared delta pass this frame.
+struct PriorityItem
+{
+    uint64_t key{0};
+    float x{0.f};
+    float y{0.f};
+    float change{0.f}; // change magnitude since the last shared observation (0 when unchanged)
+    uint32_t bytes{0}; // encoded size of the entry inside the delta message (incl. tag + length prefix)
+    uint32_t slot{0}; // caller-defined (index of the entry in the shared delta)
+    bool dirty{false}; // changed this frame -> becomes pending for every client
+};
+
+struct PackStats
+{
+    uint32_t sent{0};
+    uint32_t deferred{0};
+    uint32_t bytes{0};
+    float priority_sent_sum{0.f};
+    float priority_deferred_max{0.f};
+};
+
+// Per-client state: an entity becomes pending when it changes and stays pending (accumulating priority every frame)
+// until it is packed into one of that client's frames. Growth per frame is
+//   (1 + change_weight * change) / (1 + distance / ref_distance)
+// so close, fast-changing entities win quickly while far or idle ones still make progress as time since last send
+// accumulates. Not thread-safe; owned by the match coroutine.
+class PriorityAccumulator
+{
+public:
+    // Accumulates priority for every pending item, then packs the highest ones into budget_bytes (the space left
+    // after the frame's mandatory content: header, removals, events). Smaller items may still fill the tail after a
+    // larger one no longer fits. At least one pending item is always selected so a budget smaller than a single
+    // entity cannot starve the client. Selected item indices (into items) are appended to out in priority order.
+    // Entries whose entity no longer appears in items are dropped.
+    void select(
+        std::span<const PriorityItem> items,
+        float viewer_x,
+        float viewer_y,
+        const PriorityTuning &tuning,
+        uint32_t budget_bytes,
+        std::vector<uint32_t> &out,
+        PackStats &stats);
+
+    // Full snapshot delivered everything: nothing is pending anymore.
+    void reset() { m_entries.clear(); }
+
+    bool pending(uint64_t key) const { return m_entries.count(key) != 0; }
+
+    size_t pending_count() const { return m_entries.size(); }
+
+private:
+    struct Entry
+    {
+        float priority{0.f};
+        uint64_t seen_frame{0};
+    };
+
+    struct Candidate
+    {
+        float priority;
+        uint32_t index;
+    };
+
+    std::unordered_map<uint64_t, Entry> m_entries; // pending entities only
+    std::vector<Candidate> m_candidates; // scratch reused across frames
+    uint64_t m_frame{0};
+};
+
+} // namespace t2d::game
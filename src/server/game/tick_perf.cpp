@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/game/tick_perf.hpp"
+
+#include "common/logger.hpp"
+#include "common/metrics.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace t2d::game {
+
+static_assert(kTickPhases == t2d::metrics::RuntimeCounters::TICK_PHASES);
+static_assert(kTickPerfEventCount == t2d::metrics::RuntimeCounters::TICK_PERF_EVENTS);
+
+namespace {
+
+std::atomic<bool> g_enabled{false};
+std::atomic<bool> g_unavailable_logged{false};
+
+struct ThreadCounters
+{
+    t2d::runtime::PerfCounterGroup group;
+    bool tried{false};
+};
+
+// Opened once per thread and left enabled; the group closes when the thread exits.
+const t2d::runtime::PerfCounterGroup *thread_group()
+{
+    thread_local ThreadCounters tc;
+    if (!tc.tried) {
+        tc.tried = true;
+        const size_t opened = tc.group.open(kTickPerfEvents);
+        if (opened == 0) {
+            if (!g_unavailable_logged.exchange(true, std::memory_order_relaxed)) {
+                t2d::log::warn(
+                    "[perf] hardware counters unavailable on tick threads ({}); tick phases report wall time only",
+                    std::strerror(tc.group.last_error()));
+            }
+            return nullptr;
+        }
+        uint64_t mask = 0;
+        for (size_t i = 0; i < kTickPerfEventCount; ++i)
+            mask |= tc.group.available(i) ? uint64_t(1) << i : 0;
+        auto &rt = t2d::metrics::runtime();
+        rt.tick_perf_event_mask.fetch_or(mask, std::memory_order_relaxed);
+        rt.tick_perf_threads.fetch_add(1, std::memory_order_relaxed);
+        tc.group.start();
+    }
+    return tc.group.opened() > 0 ? &tc.group : nullptr;
+}
+
+} // namespace
+
+void configure_tick_perf(bool enabled)
+{
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool tick_perf_enabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void TickPerfSampler::begin()
+{
+    m_group = tick_perf_enabled() ? thread_group() : nullptr;
+    for (auto &phase : m_events)
+        phase.fill(0);
+    if (m_group && !m_group->read_raw(m_prev))
+        m_group = nullptr; // group not scheduled on the PMU: wall time only for this tick
+}
+
+void TickPerfSampler::mark(TickPhase phase)
+{
+    if (!m_group)
+        return;
+    std::array<uint64_t, kTickPerfEventCount> now{};
+    if (!m_group->read_raw(now)) {
+        m_group = nullptr;
+        return;
+    }
+    auto &acc = m_events[static_cast<size_t>(phase)];
+    for (size_t i = 0; i < kTickPerfEventCount; ++i) {
+        acc[i] += now[i] >= m_prev[i] ? now[i] - m_prev[i] : 0;
+        m_prev[i] = now[i];
+    }
+}
+
+void TickPerfSampler::commit(const std::array<uint32_t, kTickPhases> &phase_ns)
+{
+    auto &rt = t2d::metrics::runtime();
+    for (size_t p = 0; p < kTickPhases; ++p)
+        rt.tick_phase_ns[p].fetch_add(phase_ns[p], std::memory_order_relaxed);
+    rt.tick_phase_samples.fetch_add(1, std::memory_order_relaxed);
+    if (!m_group)
+        return;
+    for (size_t p = 0; p < kTickPhases; ++p) {
+        for (size_t i = 0; i < kTickPerfEventCount; ++i)
+            rt.tick_phase_events[p][i].fetch_add(m_events[p][i], std::memory_order_relaxed);
+    }
+    rt.tick_phase_event_samples.fetch_add(1, std::memory_order_relaxed);
+    m_group = nullptr;
+}
+
+} // namespace t2d::game
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+// tick_perf.hpp - per tick phase cost: wall time always, hardware events (cycles, instructions, LLC / branch / dTLB
+// misses) with perf_counters_enabled. Every simulation thread opens one counter group on its first sampled tick and
+// leaves it counting; a match reads the group at each phase boundary of a tick (no suspension point in between, so
+// all reads of one tick happen on the same thread) and charges the differences to the phases. Totals go to the
+// tick_phase_* runtime metrics, from which /metrics and the profiling summary derive per-phase IPC and miss rates.
+//
+// Where the kernel exposes no PMU (most containers, some VMs) or perf_event_paranoid forbids it, the group does not
+// open, a warning is logged once and only the wall time is reported.
+#pragma once
+#include "server/game/tick_phase.hpp"
+#include "server/runtime/perf_counters.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace t2d::game {
+
+// Events sampled per phase, in tick_phase_events column order.
+inline constexpr std::array<t2d::runtime::PerfEvent, 5> kTickPerfEvents{
+    t2d::runtime::PerfEvent::Cycles,
+    t2d::runtime::PerfEvent::Instructions,
+    t2d::runtime::PerfEvent::LlcMisses,
+    t2d::runtime::PerfEvent::BranchMisses,
+    t2d::runtime::PerfEvent::DtlbLoadMisses};
+inline constexpr size_t kTickPerfEventCount = kTickPerfEvents.size();
+
+// Process-wide switch (call once at startup, before matches run).
+void configure_tick_perf(bool enabled);
+bool tick_perf_enabled();
+
+// Per-match sampler; not thread-safe, owned by the match loop.
+class TickPerfSampler
+{
+public:
+    // Baseline at tick start. The tick samples no events when counters are off or unavailable on this thread.
+    void begin();
+    // Charges the events since the previous mark (or begin) to phase.
+    void mark(TickPhase phase);
+    // Adds the tick's phase wall times and, when sampled, its phase events to the runtime metrics.
+    void commit(const std::array<uint32_t, kTickPhases> &phase_ns);
+
+    bool sampling() const { return m_group != nullptr; }
+
+private:
+    const t2d::runtime::PerfCounterGroup *m_group{nullptr}; // this thread's group for the current tick
+    std::array<uint64_t, kTickPerfEventCount> m_prev{};
+    std::array<std::array<uint64_t, kTickPerfEventCount>, kTickPhases> m_events{};
+};
+
+} // namespace t2d::game
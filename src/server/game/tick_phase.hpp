@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: Apache-2.0
+// tick_phase.hpp - coarse phases of one match tick, in execution order:
+//   input    - disconnects, player input, bot AI, firing, reload timers
+//   physics  - pre-step projectile capture, Box2D step, crate move events
+//   contacts - projectile impacts, ammo pickups, projectile sync and culling
+//   snapshot - keyframe planning, full / delta snapshot build and fan-out
+//   events   - standalone event batches, kill feed, victory check
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace t2d::game {
+
+enum class TickPhase : uint8_t
+{
+    Input,
+    Physics,
+    Contacts,
+    Snapshot,
+    Events,
+};
+inline constexpr size_t kTickPhases = 5;
+
+inline const char *tick_phase_name(TickPhase phase)
+{
+    constexpr std::array<const char *, kTickPhases> kNames{"input", "physics", "contacts", "snapshot", "events"};
+    const auto i = static_cast<size_t>(phase);
+    return i < kTickPhases ? kNames[i] : "?";
+}
+
+} // namespace t2d::game
@@ -2,15 +2,24 @@
 #include "common/logger.hpp"
 #include "common/metrics.hpp"
 #include "server/auth/auth_provider.hpp"
+#include "server/game/flight_recorder.hpp"
+#include "server/game/overload_governor.hpp"
+#include "server/game/physics.hpp"
+#include "server/game/tick_perf.hpp"
+#include "server/matchmaking/admission.hpp"
 #include "server/matchmaking/matchmaker.hpp"
 #include "server/matchmaking/session_manager.hpp"
 #include "server/net/listener.hpp"
 #include "server/net/metrics_http.hpp"
+#include "server/net/uring_listener.hpp"
+#include "server/runtime/huge_pages.hpp"
+#include "server/runtime/thread_profile.hpp"
 
 #include <coro/default_executor.hpp>
 #include <coro/io_scheduler.hpp>
 #include <yaml-cpp/yaml.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -175,6 +184,43 @@ struct ServerConfig
     uint32_t turret_disable_front_hits{2};
     // Optional fixed seed to produce deterministic bot spawn & rng; 0 means random each match
     uint32_t fixed_match_seed{0};
+    // Optional compiled static map (see docs/config.md "Static maps"); empty keeps the generated arena.
+    std::string map_path;
+    // Per-client delta snapshot byte budget (0 = unlimited) and priority falloff distance (world units).
+    uint32_t snapshot_budget_bytes{0};
+    float snapshot_priority_ref_distance{20.f};
+    // Spread per-client full snapshots across full_snapshot_interval_ticks (false = all clients on the same tick).
+    bool keyframe_stagger{true};
+    // Replicate projectiles only on spawn / trajectory change; clients extrapolate (false = every delta).
+    bool projectile_spawn_only{true};
+    // Matches whose humans all disconnected: "end", "fast_forward" or "keep" (see MatchConfig::headless_policy).
+    std::string headless_match_policy{"end"};
+    // Per-connection inbound token buckets and flood disconnect threshold (rate_limit_* keys).
+    t2d::net::RateLimits rate_limits;
+    // Client socket I/O: "epoll" (libcoro poll + recv/send) or "io_uring" (needs a T2D_ENABLE_IO_URING build).
+    std::string net_backend{"epoll"};
+    // Options applied to every accepted client socket (socket_* keys).
+    t2d::net::SocketProfile socket_profile;
+    // TLS for client connections (tls_* keys; needs a T2D_ENABLE_TLS build, epoll backend only).
+    t2d::net::TlsConfig tls;
+    // CPU sets per thread role and simulation thread priority / NUMA policy (thread_* keys).
+    t2d::runtime::ThreadProfile threads;
+    // Huge page backing for Box2D worlds and match entity arrays: "off", "thp" or "hugetlb" (falls back to thp).
+    std::string huge_pages{"off"};
+    uint32_t huge_page_region_mb{32}; // heap growth step
+    // Overload governor: degrades snapshot rate, bot AI, interest and precision under tick budget pressure
+    // (governor_* keys).
+    t2d::game::GovernorConfig governor;
+    // Slow tick flight recorder: per-match tick history dumped to a JSON file when a tick overruns the threshold
+    // (flight_recorder_* keys).
+    t2d::game::FlightRecorderConfig flight_recorder;
+    // Hardware counters (cycles, instructions, LLC / branch / dTLB misses) per tick phase via perf_event_open.
+    bool perf_counters_enabled{false};
+    // Admission control (admission_* keys): full groups wait in the queue while max_parallel_matches are running or
+    // the predicted simulation load would exceed admission_target_utilization_pct of admission_capacity_cores.
+    bool admission_enabled{true};
+    double admission_capacity_cores{0.0}; // 0 = size of thread_sim_cpus, else all hardware threads
+    uint32_t admission_target_utilization_pct{70};
 };
 
 static ServerConfig load_config(const std::string &path)
@@ -276,6 +322,159 @@ static ServerConfig load_config(const std::string &path)
     if (root["fixed_match_seed"]) {
         cfg.fixed_match_seed = root["fixed_match_seed"].as<uint32_t>();
     }
+    if (root["map_path"]) {
+        cfg.map_path = root["map_path"].as<std::string>();
+    }
+    if (root["snapshot_budget_bytes"]) {
+        cfg.snapshot_budget_bytes = root["snapshot_budget_bytes"].as<uint32_t>();
+    }
+    if (root["snapshot_priority_ref_distance"]) {
+        cfg.snapshot_priority_ref_distance = root["snapshot_priority_ref_distance"].as<float>();
+    }
+    if (root["keyframe_stagger"]) {
+        cfg.keyframe_stagger = root["keyframe_stagger"].as<bool>();
+    }
+    if (root["projectile_spawn_only"]) {
+        cfg.projectile_spawn_only = root["projectile_spawn_only"].as<bool>();
+    }
+    if (root["headless_match_policy"]) {
+        cfg.headless_match_policy = root["headless_match_policy"].as<std::string>();
+    }
+    if (root["rate_limit_input_per_sec"]) {
+        cfg.rate_limits.input_per_sec = root["rate_limit_input_per_sec"].as<uint32_t>();
+    }
+    if (root["rate_limit_heartbeat_per_sec"]) {
+        cfg.rate_limits.heartbeat_per_sec = root["rate_limit_heartbeat_per_sec"].as<uint32_t>();
+    }
+    if (root["rate_limit_control_per_sec"]) {
+        cfg.rate_limits.control_per_sec = root["rate_limit_control_per_sec"].as<uint32_t>();
+    }
+    if (root["rate_limit_burst_seconds"]) {
+        cfg.rate_limits.burst_seconds = root["rate_limit_burst_seconds"].as<float>();
+    }
+    if (root["rate_limit_disconnect_per_sec"]) {
+        cfg.rate_limits.disconnect_throttled_per_sec = root["rate_limit_disconnect_per_sec"].as<uint32_t>();
+    }
+    if (root["rate_limit_input_max_bytes"]) {
+        cfg.rate_limits.input_max_bytes = root["rate_limit_input_max_bytes"].as<uint32_t>();
+    }
+    if (root["rate_limit_heartbeat_max_bytes"]) {
+        cfg.rate_limits.heartbeat_max_bytes = root["rate_limit_heartbeat_max_bytes"].as<uint32_t>();
+    }
+    if (root["rate_limit_control_max_bytes"]) {
+        cfg.rate_limits.control_max_bytes = root["rate_limit_control_max_bytes"].as<uint32_t>();
+    }
+    if (root["net_backend"]) {
+        cfg.net_backend = root["net_backend"].as<std::string>();
+    }
+    if (root["socket_nodelay"]) {
+        cfg.socket_profile.nodelay = root["socket_nodelay"].as<bool>();
+    }
+    if (root["socket_sndbuf"]) {
+        cfg.socket_profile.sndbuf = root["socket_sndbuf"].as<int>();
+    }
+    if (root["socket_rcvbuf"]) {
+        cfg.socket_profile.rcvbuf = root["socket_rcvbuf"].as<int>();
+    }
+    if (root["socket_notsent_lowat"]) {
+        cfg.socket_profile.notsent_lowat = root["socket_notsent_lowat"].as<int>();
+    }
+    if (root["socket_busy_poll_us"]) {
+        cfg.socket_profile.busy_poll_us = root["socket_busy_poll_us"].as<int>();
+    }
+    if (root["socket_cork_flush"]) {
+        cfg.socket_profile.cork_flush = root["socket_cork_flush"].as<bool>();
+    }
+    if (root["tls_enabled"]) {
+        cfg.tls.enabled = root["tls_enabled"].as<bool>();
+    }
+    if (root["tls_cert_path"]) {
+        cfg.tls.cert_path = root["tls_cert_path"].as<std::string>();
+    }
+    if (root["tls_key_path"]) {
+        cfg.tls.key_path = root["tls_key_path"].as<std::string>();
+    }
+    if (root["tls_require_ktls"]) {
+        cfg.tls.require_ktls = root["tls_require_ktls"].as<bool>();
+    }
+    if (root["thread_sim_cpus"]) {
+        cfg.threads.sim_cpus = root["thread_sim_cpus"].as<std::string>();
+    }
+    if (root["thread_net_cpus"]) {
+        cfg.threads.net_cpus = root["thread_net_cpus"].as<std::string>();
+    }
+    if (root["thread_logger_cpus"]) {
+        cfg.threads.logger_cpus = root["thread_logger_cpus"].as<std::string>();
+    }
+    if (root["thread_metrics_cpus"]) {
+        cfg.threads.metrics_cpus = root["thread_metrics_cpus"].as<std::string>();
+    }
+    if (root["thread_sim_fifo_priority"]) {
+        cfg.threads.sim_fifo_priority = root["thread_sim_fifo_priority"].as<int>();
+    }
+    if (root["thread_sim_nice"]) {
+        cfg.threads.sim_nice = root["thread_sim_nice"].as<int>();
+    }
+    if (root["thread_sim_numa_local"]) {
+        cfg.threads.sim_numa_local = root["thread_sim_numa_local"].as<bool>();
+    }
+    if (root["huge_pages"]) {
+        cfg.huge_pages = root["huge_pages"].as<std::string>();
+    }
+    if (root["huge_page_region_mb"]) {
+        cfg.huge_page_region_mb = root["huge_page_region_mb"].as<uint32_t>();
+    }
+    if (root["governor_enabled"]) {
+        cfg.governor.enabled = root["governor_enabled"].as<bool>();
+    }
+    if (root["governor_tick_budget_us"]) {
+        cfg.governor.tick_budget_us = root["governor_tick_budget_us"].as<uint32_t>();
+    }
+    if (root["governor_escalate_pct"]) {
+        cfg.governor.escalate_pct = root["governor_escalate_pct"].as<uint32_t>();
+    }
+    if (root["governor_recover_pct"]) {
+        cfg.governor.recover_pct = root["governor_recover_pct"].as<uint32_t>();
+    }
+    if (root["governor_window_ms"]) {
+        cfg.governor.window_ms = root["governor_window_ms"].as<uint32_t>();
+    }
+    if (root["governor_recover_windows"]) {
+        cfg.governor.recover_windows = root["governor_recover_windows"].as<uint32_t>();
+    }
+    if (root["governor_max_level"]) {
+        cfg.governor.max_level = root["governor_max_level"].as<uint32_t>();
+    }
+    if (root["flight_recorder_enabled"]) {
+        cfg.flight_recorder.enabled = root["flight_recorder_enabled"].as<bool>();
+    }
+    if (root["flight_recorder_threshold_us"]) {
+        cfg.flight_recorder.threshold_us = root["flight_recorder_threshold_us"].as<uint32_t>();
+    }
+    if (root["flight_recorder_history_ms"]) {
+        cfg.flight_recorder.history_ms = root["flight_recorder_history_ms"].as<uint32_t>();
+    }
+    if (root["flight_recorder_min_interval_ms"]) {
+        cfg.flight_recorder.min_interval_ms = root["flight_recorder_min_interval_ms"].as<uint32_t>();
+    }
+    if (root["flight_recorder_max_dumps"]) {
+        cfg.flight_recorder.max_dumps = root["flight_recorder_max_dumps"].as<uint32_t>();
+    }
+    if (root["flight_recorder_dir"]) {
+        cfg.flight_recorder.dir = root["flight_recorder_dir"].as<std::string>();
+    }
+    if (root["perf_counters_enabled"]) {
+        cfg.perf_counters_enabled = root["perf_counters_enabled"].as<bool>();
+    }
+    if (root["admission_enabled"]) {
+        cfg.admission_enabled = root["admission_enabled"].as<bool>();
+    }
+    if (root["admission_capacity_cores"]) {
+        cfg.admission_capacity_cores = root["admission_capacity_cores"].as<double>();
+    }
+    if (root["admission_target_utilization_pct"]) {
+        cfg.admission_target_utilization_pct = root["admission_target_utilization_pct"].as<uint32_t>();
+    }
     return cfg;
 }
 
@@ -388,10 +587,121 @@ int main(int argc, char **argv)
         t2d::log::info("Bot AI disabled (--no-bot-ai)");
     }
 
-    // io_scheduler requires options; construct explicitly
+    // Thread placement: the scheduler's worker pool runs match ticks (simulation role), its I/O thread waits on epoll
+    // and timers (network role). Each thread applies its role as it starts; the logger writer already runs and is
+    // placed from here, the main thread last so threads created above do not inherit its CPU set.
+    const auto thread_profile = cfg.threads;
+    if (thread_profile.any())
+        t2d::log::info(
+            "Thread profile: sim_cpus='{}' net_cpus='{}' logger_cpus='{}' metrics_cpus='{}' fifo={} nice={} numa={}",
+            thread_profile.sim_cpus,
+            thread_profile.net_cpus,
+            thread_profile.logger_cpus,
+            thread_profile.metrics_cpus,
+            thread_profile.sim_fifo_priority,
+            thread_profile.sim_nice,
+            thread_profile.sim_numa_local);
+    // Huge page heap: configured before any match or physics world exists (Box2D's allocator cannot change while a
+    // world is alive).
+    t2d::runtime::HugePageMode huge_mode = t2d::runtime::HugePageMode::Off;
+    if (!t2d::runtime::parse_huge_page_mode(cfg.huge_pages, huge_mode))
+        t2d::log::warn("huge_pages '{}' unknown (off|thp|hugetlb); using off", cfg.huge_pages);
+    if (huge_mode != t2d::runtime::HugePageMode::Off) {
+        t2d::runtime::HugePageHeap::instance().configure(huge_mode, size_t{cfg.huge_page_region_mb} << 20);
+        t2d::phys::use_huge_page_heap();
+        t2d::log::info(
+            "Huge pages: {} (region {} MiB) for physics worlds and match arrays",
+            t2d::runtime::mode_name(huge_mode),
+            cfg.huge_page_region_mb);
+    }
+    t2d::game::governor().configure(cfg.governor, std::chrono::steady_clock::now());
+    if (cfg.governor.enabled) {
+        t2d::log::info(
+            "Overload governor: tick budget {} us, escalate above {}%, recover below {}% for {} x {} ms, max level {}",
+            cfg.governor.tick_budget_us,
+            cfg.governor.escalate_pct,
+            cfg.governor.recover_pct,
+            cfg.governor.recover_windows,
+            cfg.governor.window_ms,
+            cfg.governor.max_level);
+    }
+    t2d::game::configure_flight_recorder(cfg.flight_recorder);
+    if (cfg.flight_recorder.enabled) {
+        t2d::log::info(
+            "Flight recorder: {} ms of tick history per match, dump ticks over {} us to '{}' (at most every {} ms)",
+            cfg.flight_recorder.history_ms,
+            cfg.flight_recorder.threshold_us,
+            cfg.flight_recorder.dir,
+            cfg.flight_recorder.min_interval_ms);
+    }
+    t2d::game::configure_tick_perf(cfg.perf_counters_enabled);
+    if (cfg.perf_counters_enabled)
+        t2d::log::info("Tick phase hardware counters enabled (perf_event_open, user space only)");
+    {
+        t2d::mm::AdmissionConfig admission;
+        admission.enabled = cfg.admission_enabled;
+        admission.max_parallel_matches = cfg.max_parallel_matches;
+        admission.capacity_cores = cfg.admission_capacity_cores;
+        if (admission.capacity_cores <= 0.0) {
+            cpu_set_t sim_set;
+            if (!thread_profile.sim_cpus.empty() && t2d::runtime::parse_cpu_list(thread_profile.sim_cpus, sim_set))
+                admission.capacity_cores = CPU_COUNT(&sim_set);
+            else
+                admission.capacity_cores = std::max(1u, std::thread::hardware_concurrency());
+        }
+        admission.target_utilization_pct = cfg.admission_target_utilization_pct;
+        t2d::mm::admission().configure(admission);
+        if (admission.enabled) {
+            t2d::log::info(
+                "Admission control: max {} parallel matches, {}% of {} simulation cores",
+                admission.max_parallel_matches,
+                admission.target_utilization_pct,
+                admission.capacity_cores);
+        }
+    }
+    coro::io_scheduler::options sched_opts{};
+    sched_opts.on_io_thread_start_functor = [thread_profile]
+    { t2d::runtime::apply_current_thread(t2d::runtime::ThreadRole::Network, thread_profile, "t2d-io"); };
+    sched_opts.pool.on_thread_start_functor = [thread_profile](std::size_t idx)
+    {
+        t2d::runtime::apply_current_thread(
+            t2d::runtime::ThreadRole::Simulation, thread_profile, "t2d-sim-" + std::to_string(idx));
+    };
+    coro::default_executor::set_io_executor_options(sched_opts);
     auto scheduler = coro::default_executor::io_executor();
-    // Spawn TCP listener coroutine (pass tick_rate for adaptive connection poll timeouts)
-    scheduler->spawn(t2d::net::run_listener(scheduler, cfg.listen_port, cfg.tick_rate));
+    t2d::runtime::apply_thread(t2d::log::writer_thread(), t2d::runtime::ThreadRole::Logger, thread_profile, "t2d-log");
+    // Client connections: io_uring backend on its own thread when configured and available, otherwise the TCP
+    // listener coroutine (pass tick_rate for adaptive connection poll timeouts). TLS runs on the epoll listener only.
+    std::shared_ptr<t2d::net::TlsContext> tls_ctx;
+    if (cfg.tls.enabled) {
+        tls_ctx = t2d::net::TlsContext::create(cfg.tls);
+        if (!tls_ctx) {
+            if (t2d::net::tls_available())
+                t2d::log::error("TLS enabled but certificate/key could not be loaded; refusing to serve plain TCP");
+            else
+                t2d::log::error("TLS enabled but this build has no TLS support; refusing to serve plain TCP");
+            t2d::log::shutdown();
+            return 1;
+        }
+    }
+    t2d::net::UringListener uring_listener;
+    std::thread uring_thread;
+    if (tls_ctx && cfg.net_backend == "io_uring")
+        t2d::log::warn("net_backend io_uring does not support TLS; using epoll listener");
+    if (!tls_ctx && cfg.net_backend == "io_uring"
+        && uring_listener.open(cfg.listen_port, cfg.tick_rate, cfg.rate_limits, cfg.socket_profile)) {
+        uring_thread = std::thread(
+            [&uring_listener, thread_profile]
+            {
+                t2d::runtime::apply_current_thread(t2d::runtime::ThreadRole::Network, thread_profile, "t2d-uring");
+                uring_listener.run(t2d::g_shutdown);
+            });
+    } else {
+        if (cfg.net_backend != "epoll" && !tls_ctx)
+            t2d::log::warn("net_backend '{}' unavailable; using epoll listener", cfg.net_backend);
+        scheduler->spawn(t2d::net::run_listener(
+            scheduler, cfg.listen_port, cfg.tick_rate, cfg.rate_limits, cfg.socket_profile, tls_ctx));
+    }
     // Launch matchmaker coroutine
     scheduler->spawn(t2d::mm::run_matchmaker(
         scheduler,
@@ -421,7 +731,13 @@ int main(int argc, char **argv)
             cfg.persist_destroyed_tanks,
             cfg.track_break_hits,
             cfg.turret_disable_front_hits,
-            cfg.fixed_match_seed}));
+            cfg.fixed_match_seed,
+            cfg.map_path,
+            cfg.snapshot_budget_bytes,
+            cfg.snapshot_priority_ref_distance,
+            cfg.keyframe_stagger,
+            cfg.projectile_spawn_only,
+            cfg.headless_match_policy}));
     // Launch heartbeat monitor
     scheduler->spawn(heartbeat_monitor(scheduler, cfg.heartbeat_timeout_seconds));
     // Launch resource sampler (profiling / production lightweight)
@@ -440,7 +756,8 @@ int main(int argc, char **argv)
         t2d::log::info("Auto test match enabled: queued {} bots to trigger immediate match", created.size());
     }
 
-    // Main thread just sleeps; real implementation will add signal handling & graceful shutdown.
+    // Main thread just sleeps and reports metrics; real implementation will add signal handling & graceful shutdown.
+    t2d::runtime::apply_current_thread(t2d::runtime::ThreadRole::Metrics, thread_profile, "t2d-main");
     auto run_start = std::chrono::steady_clock::now();
     while (!t2d::g_shutdown.load()) {
         static auto last_metrics = std::chrono::steady_clock::now();
@@ -518,8 +835,41 @@ int main(int argc, char **argv)
                 j << ",\"queue_depth\":" << rt.queue_depth.load();
                 j << ",\"active_matches\":" << rt.active_matches.load();
                 j << ",\"bots_in_match\":" << rt.bots_in_match.load();
+                j << ",\"bots_live\":" << rt.bots_live.load();
+                j << ",\"bots_pooled\":" << rt.bots_pooled.load();
+                j << ",\"matches_headless\":" << rt.matches_headless.load();
+                j << ",\"fast_forward_ticks\":" << rt.fast_forward_ticks.load();
+                j << ",\"flight_recorder_dumps\":" << rt.flight_recorder_dumps.load();
                 j << ",\"projectiles_active\":" << rt.projectiles_active.load();
                 j << ",\"connected_players\":" << rt.connected_players.load();
+                // Preemptions of the tick threads since start (scheduler noise; compare with CPU isolation on/off)
+                uint64_t sim_nvcsw = 0;
+                for (const auto &ts : t2d::runtime::collect_thread_stats()) {
+                    if (ts.name.rfind("t2d-sim-", 0) == 0)
+                        sim_nvcsw += ts.nonvoluntary_switches;
+                }
+                j << ",\"sim_nonvoluntary_ctxt_switches\":" << sim_nvcsw;
+                if (t2d::runtime::HugePageHeap::instance().enabled()) {
+                    const auto hp = t2d::runtime::HugePageHeap::instance().stats();
+                    j << ",\"hugepage_backing\":\"" << t2d::runtime::backing_name(hp.backing) << "\"";
+                    j << ",\"hugepage_reserved_bytes\":" << hp.reserved_bytes;
+                    j << ",\"hugepage_in_use_bytes\":" << hp.in_use_bytes;
+                    j << ",\"hugepage_resident_bytes\":" << t2d::runtime::resident_huge_page_bytes();
+                }
+                {
+                    const auto as = t2d::mm::admission().stats();
+                    j << ",\"admission_running\":" << as.running;
+                    j << ",\"admission_load_cores\":" << as.load_cores;
+                    j << ",\"admission_denied\":" << (as.denied_cap + as.denied_capacity + as.denied_overload);
+                    j << ",\"admission_model_samples\":" << as.model_samples;
+                }
+                if (t2d::game::governor().enabled()) {
+                    const auto gs = t2d::game::governor().stats(std::chrono::steady_clock::now());
+                    j << ",\"governor_level\":" << gs.level;
+                    j << ",\"governor_tick_p95_us\":" << gs.last_p95_us;
+                    j << ",\"governor_escalations\":" << gs.escalations;
+                    j << ",\"governor_recoveries\":" << gs.recoveries;
+                }
                 j << "}";
                 t2d::log::info("{}", j.str());
             }
@@ -557,6 +907,23 @@ int main(int argc, char **argv)
             j << ",\"wait_mean_ns\":" << wait_mean_ns_final;
             j << ",\"cpu_user_pct\":" << cpu_pct;
             j << ",\"rss_peak_bytes\":" << rt.rss_peak_bytes.load(std::memory_order_relaxed);
+            j << ",\"tick_events_total\":" << rt.tick_events_total.load(std::memory_order_relaxed);
+            j << ",\"tick_event_batches_piggybacked\":"
+              << rt.tick_event_batches_piggybacked.load(std::memory_order_relaxed);
+            j << ",\"tick_event_batches_standalone\":"
+              << rt.tick_event_batches_standalone.load(std::memory_order_relaxed);
+            j << ",\"keyframes_sent\":" << rt.keyframes_sent.load(std::memory_order_relaxed);
+            j << ",\"keyframes_on_demand\":" << rt.keyframes_on_demand.load(std::memory_order_relaxed);
+            if (cfg.snapshot_budget_bytes > 0) {
+                j << ",\"snapshot_budget_frames\":" << rt.snapshot_budget_frames.load(std::memory_order_relaxed);
+                j << ",\"snapshot_budget_bytes\":" << rt.snapshot_budget_bytes.load(std::memory_order_relaxed);
+                j << ",\"snapshot_budget_entities_sent\":"
+                  << rt.snapshot_budget_entities_sent.load(std::memory_order_relaxed);
+                j << ",\"snapshot_budget_entities_deferred\":"
+                  << rt.snapshot_budget_entities_deferred.load(std::memory_order_relaxed);
+                j << ",\"snapshot_budget_over_budget_frames\":"
+                  << rt.snapshot_budget_over_budget_frames.load(std::memory_order_relaxed);
+            }
             if (cfg.fixed_match_seed > 0) {
                 j << ",\"fixed_match_seed\":" << cfg.fixed_match_seed;
             }
@@ -667,6 +1034,33 @@ int main(int argc, char **argv)
                 }
                 j << ",\"log_lines_per_tick_mean\":" << log_lines_mean;
             }
+            {
+                // Per tick phase: mean wall time, plus mean hardware events and IPC for ticks sampled with
+                // perf_counters_enabled.
+                const uint64_t phase_samples = rt.tick_phase_samples.load(std::memory_order_relaxed);
+                const uint64_t event_samples = rt.tick_phase_event_samples.load(std::memory_order_relaxed);
+                const uint64_t mask = rt.tick_perf_event_mask.load(std::memory_order_relaxed);
+                for (size_t p = 0; p < t2d::game::kTickPhases && phase_samples > 0; ++p) {
+                    const auto phase = static_cast<t2d::game::TickPhase>(p);
+                    const std::string prefix = std::string(",\"tick_phase_") + t2d::game::tick_phase_name(phase);
+                    j << prefix << "_ns_mean\":"
+                      << (double)rt.tick_phase_ns[p].load(std::memory_order_relaxed) / (double)phase_samples;
+                    if (event_samples == 0)
+                        continue;
+                    for (size_t i = 0; i < t2d::game::kTickPerfEventCount; ++i) {
+                        if (mask & (uint64_t(1) << i)) {
+                            j << prefix << "_" << t2d::runtime::event_name(t2d::game::kTickPerfEvents[i]) << "_mean\":"
+                              << (double)rt.tick_phase_events[p][i].load(std::memory_order_relaxed)
+                                    / (double)event_samples;
+                        }
+                    }
+                    const uint64_t cycles = rt.tick_phase_events[p][0].load(std::memory_order_relaxed);
+                    if ((mask & 3) == 3 && cycles > 0) {
+                        j << prefix << "_ipc\":"
+                          << (double)rt.tick_phase_events[p][1].load(std::memory_order_relaxed) / (double)cycles;
+                    }
+                }
+            }
 #endif
             {
                 double frees_per_tick_mean = 0.0;
@@ -687,12 +1081,19 @@ int main(int argc, char **argv)
             j << ",\"queue_depth\":" << rt.queue_depth.load();
             j << ",\"active_matches\":" << rt.active_matches.load();
             j << ",\"bots_in_match\":" << rt.bots_in_match.load();
+            j << ",\"bots_live\":" << rt.bots_live.load();
+            j << ",\"bots_pooled\":" << rt.bots_pooled.load();
+            j << ",\"matches_headless\":" << rt.matches_headless.load();
+            j << ",\"fast_forward_ticks\":" << rt.fast_forward_ticks.load();
+            j << ",\"flight_recorder_dumps\":" << rt.flight_recorder_dumps.load();
             j << ",\"projectiles_active\":" << rt.projectiles_active.load();
             j << ",\"connected_players\":" << rt.connected_players.load();
             j << "}";
             t2d::log::info("{}", j.str());
         }
     }
+    if (uring_thread.joinable())
+        uring_thread.join(); // exits within one flush period of g_shutdown
     // Dump snapshot metrics (stdout JSON lines if JSON mode enabled externally in logger)
     auto fullB = t2d::metrics::snapshot().full_bytes.load();
     auto deltaB = t2d::metrics::snapshot().delta_bytes.load();
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/matchmaking/admission.hpp"
+
+#include "server/game/overload_governor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace t2d::mm {
+
+MatchCostModel::MatchCostModel(Coefficients prior, double forget, double prior_weight)
+    : m_prior(prior), m_forget(forget), m_prior_weight(prior_weight)
+{
+    solve();
+}
+
+void MatchCostModel::observe(uint32_t humans, uint32_t bots, double mean_tick_us)
+{
+    const std::array<double, 3> x{1.0, static_cast<double>(humans), static_cast<double>(bots)};
+    for (size_t r = 0; r < 3; ++r) {
+        for (size_t c = 0; c < 3; ++c)
+            m_xtx[r * 3 + c] = m_xtx[r * 3 + c] * m_forget + x[r] * x[c];
+        m_xty[r] = m_xty[r] * m_forget + x[r] * mean_tick_us;
+    }
+    ++m_samples;
+    solve();
+}
+
+// (X^T X + w I) theta = X^T y + w prior: the prior holds directions the data does not constrain (e.g. every match
+// so far had the same bot count) and fades as observations accumulate.
+void MatchCostModel::solve()
+{
+    const std::array<double, 3> prior{m_prior.base_us, m_prior.per_human_us, m_prior.per_bot_us};
+    std::array<std::array<double, 4>, 3> a{};
+    for (size_t r = 0; r < 3; ++r) {
+        for (size_t c = 0; c < 3; ++c)
+            a[r][c] = m_xtx[r * 3 + c] + (r == c ? m_prior_weight : 0.0);
+        a[r][3] = m_xty[r] + m_prior_weight * prior[r];
+    }
+    // Gaussian elimination with partial pivoting (the system is symmetric positive definite).
+    for (size_t col = 0; col < 3; ++col) {
+        size_t pivot = col;
+        for (size_t r = col + 1; r < 3; ++r) {
+            if (std::fabs(a[r][col]) > std::fabs(a[pivot][col]))
+                pivot = r;
+        }
+        std::swap(a[col], a[pivot]);
+        if (std::fabs(a[col][col]) < 1e-12) {
+            m_theta = prior;
+            return;
+        }
+        for (size_t r = 0; r < 3; ++r) {
+            if (r == col)
+                continue;
+            const double f = a[r][col] / a[col][col];
+            for (size_t c = col; c < 4; ++c)
+                a[r][c] -= f * a[col][c];
+        }
+    }
+    for (size_t r = 0; r < 3; ++r)
+        m_theta[r] = a[r][3] / a[r][r];
+}
+
+double MatchCostModel::predict(uint32_t humans, uint32_t bots) const
+{
+    const double us = m_theta[0] + m_theta[1] * humans + m_theta[2] * bots;
+    return std::max(us, 0.0);
+}
+
+MatchCostModel::Coefficients MatchCostModel::coefficients() const
+{
+    return {m_theta[0], m_theta[1], m_theta[2]};
+}
+
+double MatchLoad::tick_us() const
+{
+    const uint64_t n = ticks.load(std::memory_order_relaxed);
+    if (n < tick_rate)
+        return predicted_tick_us;
+    return static_cast<double>(tick_ns_total.load(std::memory_order_relaxed)) / static_cast<double>(n) / 1000.0;
+}
+
+const char *verdict_name(AdmissionVerdict v)
+{
+    switch (v) {
+        case AdmissionVerdict::Admit:
+            return "admit";
+        case AdmissionVerdict::MatchCap:
+            return "match_cap";
+        case AdmissionVerdict::Capacity:
+            return "capacity";
+        case AdmissionVerdict::Overload:
+            return "overload";
+    }
+    return "?";
+}
+
+AdmissionController::AdmissionController()
+{
+    configure(AdmissionConfig{});
+}
+
+void AdmissionController::configure(const AdmissionConfig &cfg)
+{
+    std::lock_guard lk(m_mutex);
+    m_cfg = cfg;
+    m_model = MatchCostModel({cfg.prior_base_us, cfg.prior_per_human_us, cfg.prior_per_bot_us});
+    m_mean_match_seconds = cfg.prior_match_seconds;
+    m_finished = 0;
+    m_holding = false;
+}
+
+double AdmissionController::load_cores_locked() const
+{
+    double cores = 0.0;
+    for (const auto &m : m_running)
+        cores += m->cores();
+    return cores;
+}
+
+AdmissionDecision AdmissionController::evaluate(uint32_t humans, uint32_t bots, uint32_t tick_rate)
+{
+    std::lock_guard lk(m_mutex);
+    AdmissionDecision d;
+    d.predicted_tick_us = m_model.predict(humans, bots);
+    d.load_cores = load_cores_locked();
+    d.capacity_cores = m_cfg.capacity_cores * m_cfg.target_utilization_pct / 100.0;
+    // An idle process always admits: a match predicted above capacity on its own would otherwise never start.
+    if (!m_cfg.enabled || m_running.empty()) {
+        m_holding = false;
+        return d;
+    }
+    // Milder governor levels are left to the load check (the measured tick times of the degraded matches already
+    // show up in load_cores); only the top level, where nothing is left to shed, blocks outright.
+    const auto &gov = t2d::game::governor();
+    if (m_cfg.max_parallel_matches > 0 && m_running.size() >= m_cfg.max_parallel_matches)
+        d.verdict = AdmissionVerdict::MatchCap;
+    else if (gov.enabled() && gov.max_level() > 0 && gov.level() >= gov.max_level())
+        d.verdict = AdmissionVerdict::Overload;
+    else if (d.capacity_cores > 0.0 && d.load_cores + d.predicted_tick_us * tick_rate / 1e6 > d.capacity_cores)
+        d.verdict = AdmissionVerdict::Capacity;
+    if (d.admitted() || m_holding) {
+        m_holding = !d.admitted();
+        return d;
+    }
+    m_holding = true;
+    if (d.verdict == AdmissionVerdict::MatchCap)
+        ++m_denied_cap;
+    else if (d.verdict == AdmissionVerdict::Overload)
+        ++m_denied_overload;
+    else
+        ++m_denied_capacity;
+    return d;
+}
+
+std::shared_ptr<MatchLoad> AdmissionController::admit(
+    uint32_t humans, uint32_t bots, uint32_t tick_rate, std::chrono::steady_clock::time_point now)
+{
+    auto load = std::make_shared<MatchLoad>();
+    load->humans = humans;
+    load->bots = bots;
+    load->tick_rate = std::max<uint32_t>(tick_rate, 1);
+    load->started = now;
+    std::lock_guard lk(m_mutex);
+    load->predicted_tick_us = m_model.predict(humans, bots);
+    m_running.push_back(load);
+    ++m_admitted;
+    m_holding = false;
+    return load;
+}
+
+void AdmissionController::finish(const std::shared_ptr<MatchLoad> &load, std::chrono::steady_clock::time_point now)
+{
+    if (!load)
+        return;
+    std::lock_guard lk(m_mutex);
+    auto it = std::find(m_running.begin(), m_running.end(), load);
+    if (it == m_running.end())
+        return;
+    m_running.erase(it);
+    const uint64_t ticks = load->ticks.load(std::memory_order_relaxed);
+    if (ticks < load->tick_rate)
+        return;
+    m_model.observe(load->humans, load->bots, load->tick_us());
+    // Match length: EWMA that starts from the prior and settles over ~10 matches.
+    const double seconds = std::chrono::duration<double>(now - load->started).count();
+    const double alpha = m_finished < 10 ? 1.0 / static_cast<double>(m_finished + 2) : 0.1;
+    m_mean_match_seconds += alpha * (seconds - m_mean_match_seconds);
+    ++m_finished;
+}
+
+uint32_t AdmissionController::estimated_wait_seconds(size_t groups_ahead, std::chrono::steady_clock::time_point now)
+    const
+{
+    std::lock_guard lk(m_mutex);
+    if (m_running.empty())
+        return 0;
+    std::vector<double> remaining;
+    remaining.reserve(m_running.size());
+    for (const auto &m : m_running) {
+        const double elapsed = std::chrono::duration<double>(now - m->started).count();
+        remaining.push_back(std::max(0.0, m_mean_match_seconds - elapsed));
+    }
+    std::sort(remaining.begin(), remaining.end());
+    const size_t n = remaining.size();
+    const double wait = remaining[groups_ahead % n] + static_cast<double>(groups_ahead / n) * m_mean_match_seconds;
+    return static_cast<uint32_t>(std::ceil(wait));
+}
+
+AdmissionController::Stats AdmissionController::stats() const
+{
+    std::lock_guard lk(m_mutex);
+    Stats st;
+    st.admitted = m_admitted;
+    st.denied_cap = m_denied_cap;
+    st.denied_capacity = m_denied_capacity;
+    st.denied_overload = m_denied_overload;
+    st.running = m_running.size();
+    st.load_cores = load_cores_locked();
+    st.capacity_cores = m_cfg.capacity_cores * m_cfg.target_utilization_pct / 100.0;
+    st.mean_match_seconds = m_mean_match_seconds;
+    st.model = m_model.coefficients();
+    st.model_samples = m_model.samples();
+    return st;
+}
+
+AdmissionController &admission()
+{
+    static AdmissionController c;
+    return c;
+}
+
+} // namespace t2d::mm
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+// admission.hpp - capacity-aware admission control for the matchmaker. A full group only becomes a match while the
+// process has headroom: fewer than max_parallel_matches running, the predicted simulation load of the running
+// matches plus the new one within target_utilization_pct of the simulation cores, and the overload governor below
+// its top level (the milder levels leave the decision to the load check). Otherwise the group stays queued and its
+// players get a wait estimate from the expected remaining time of the running matches.
+//
+// The cost of a match is predicted from its composition by MatchCostModel, a ridge-regularized least-squares fit of
+// mean tick time = base + per_human * humans + per_bot * bots over finished matches (exponential forgetting, so the
+// model follows code and hardware changes). Until a composition has been observed the prior coefficients dominate.
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace t2d::mm {
+
+struct AdmissionConfig
+{
+    bool enabled{true}; // false = every full group becomes a match (legacy)
+    uint32_t max_parallel_matches{0}; // 0 = no cap
+    double capacity_cores{0.0}; // simulation cores the matches may use; 0 = no load check
+    uint32_t target_utilization_pct{70};
+    // Prior mean tick cost (microseconds) before any match has finished.
+    double prior_base_us{100.0};
+    double prior_per_human_us{30.0};
+    double prior_per_bot_us{50.0};
+    double prior_match_seconds{60.0}; // expected match length before any match has finished
+};
+
+// Mean tick cost (microseconds) = base_us + per_human_us * humans + per_bot_us * bots.
+struct MatchCostCoefficients
+{
+    double base_us{0};
+    double per_human_us{0};
+    double per_bot_us{0};
+};
+
+class MatchCostModel
+{
+public:
+    using Coefficients = MatchCostCoefficients;
+
+    explicit MatchCostModel(Coefficients prior = {}, double forget = 0.98, double prior_weight = 2.0);
+
+    void observe(uint32_t humans, uint32_t bots, double mean_tick_us);
+    double predict(uint32_t humans, uint32_t bots) const;
+    Coefficients coefficients() const;
+    uint64_t samples() const { return m_samples; }
+
+private:
+    void solve();
+
+    Coefficients m_prior;
+    double m_forget;
+    double m_prior_weight;
+    std::array<double, 9> m_xtx{}; // sum of x x^T, x = (1, humans, bots)
+    std::array<double, 3> m_xty{};
+    std::array<double, 3> m_theta{};
+    uint64_t m_samples{0};
+};
+
+// Live cost of one admitted match; the match loop records its ticks, finish() feeds the model.
+struct MatchLoad
+{
+    uint32_t humans{0};
+    uint32_t bots{0};
+    uint32_t tick_rate{30};
+    double predicted_tick_us{0};
+    std::chrono::steady_clock::time_point started{};
+    std::atomic<uint64_t> tick_ns_total{0};
+    std::atomic<uint64_t> ticks{0};
+
+    void record_tick(uint64_t tick_ns)
+    {
+        tick_ns_total.fetch_add(tick_ns, std::memory_order_relaxed);
+        ticks.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Measured mean once the match ran for a second, the prediction before that.
+    double tick_us() const;
+    double cores() const { return tick_us() * tick_rate / 1e6; }
+};
+
+enum class AdmissionVerdict : uint8_t
+{
+    Admit,
+    MatchCap, // max_parallel_matches reached
+    Capacity, // predicted load above the target utilization
+    Overload, // overload governor at its top level
+};
+
+const char *verdict_name(AdmissionVerdict v);
+
+struct AdmissionDecision
+{
+    AdmissionVerdict verdict{AdmissionVerdict::Admit};
+    double predicted_tick_us{0};
+    double load_cores{0}; // running matches
+    double capacity_cores{0}; // after target utilization (0 = unchecked)
+    bool admitted() const { return verdict == AdmissionVerdict::Admit; }
+};
+
+class AdmissionController
+{
+public:
+    AdmissionController();
+
+    // Resets the model to the configured priors; running matches stay registered.
+    void configure(const AdmissionConfig &cfg);
+
+    // Headroom check for a group of this composition. Refusals are counted once per held group, by the reason it was
+    // first held for: repeated polls of the same hold do not count again until a group is admitted. admit()
+    // registers the match.
+    AdmissionDecision evaluate(uint32_t humans, uint32_t bots, uint32_t tick_rate);
+    std::shared_ptr<MatchLoad> admit(
+        uint32_t humans, uint32_t bots, uint32_t tick_rate, std::chrono::steady_clock::time_point now);
+    // Match ended: unregisters it and trains the model (matches shorter than one second are not used).
+    void finish(const std::shared_ptr<MatchLoad> &load, std::chrono::steady_clock::time_point now);
+
+    // Seconds until the group `groups_ahead` places behind the head of the queue can expect a slot: the i-th running
+    // match to end frees the i-th slot, later groups wait for further match lengths.
+    uint32_t estimated_wait_seconds(size_t groups_ahead, std::chrono::steady_clock::time_point now) const;
+
+    struct Stats
+    {
+        uint64_t admitted{0};
+        uint64_t denied_cap{0};
+        uint64_t denied_capacity{0};
+        uint64_t denied_overload{0};
+        size_t running{0};
+        double load_cores{0};
+        double capacity_cores{0};
+        double mean_match_seconds{0};
+        MatchCostModel::Coefficients model;
+        uint64_t model_samples{0};
+    };
+    Stats stats() const;
+
+private:
+    double load_cores_locked() const;
+
+    mutable std::mutex m_mutex;
+    AdmissionConfig m_cfg;
+    MatchCostModel m_model;
+    std::vector<std::shared_ptr<MatchLoad>> m_running;
+    double m_mean_match_seconds{60.0};
+    uint64_t m_finished{0};
+    uint64_t m_admitted{0};
+    uint64_t m_denied_cap{0};
+    uint64_t m_denied_capacity{0};
+    uint64_t m_denied_overload{0};
+    bool m_holding{false}; // the last evaluation refused (its hold is already counted)
+};
+
+// Process-wide controller used by the matchmaker and the match loop (configured from main).
+AdmissionController &admission();
+
+} // namespace t2d::mm
@@ -1,10 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "server/matchmaking/matchmaker.hpp"
 
+#include "common/log_rate_limit.hpp"
 #include "common/logger.hpp"
 #include "common/metrics.hpp"
+#include "common/rot_angle.hpp"
 #include "game.pb.h"
 #include "server/game/match.hpp"
+#include "server/matchmaking/admission.hpp"
 #include "server/matchmaking/session_manager.hpp"
 
 #include <coro/coro.hpp>
@@ -33,6 +36,17 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
     co_await scheduler->schedule();
     t2d::log::info("matchmaker started");
     auto &mgr = instance();
+    // Static map is mapped once and shared read-only by every match (cache keyed by path).
+    std::shared_ptr<const t2d::map::MappedMap> map;
+    if (!cfg.map_path.empty()) {
+        map = t2d::map::load_shared_map(cfg.map_path);
+        if (!map)
+            t2d::log::warn("matchmaker: map '{}' unavailable, using generated arena", cfg.map_path);
+    }
+    auto headless_policy = t2d::game::HeadlessPolicy::End;
+    if (!t2d::game::parse_headless_policy(cfg.headless_policy, headless_policy))
+        t2d::log::warn(
+            "matchmaker: headless_match_policy '{}' unknown (end|fast_forward|keep); using end", cfg.headless_policy);
     while (true) {
         // sleep configured poll interval
         co_await scheduler->yield_for(std::chrono::milliseconds(cfg.poll_interval_ms));
@@ -80,6 +94,31 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
             }
         }
 
+        // Admission: a full group only becomes a match while the process has headroom (admission.hpp). A held group
+        // stays at the head of the queue; its players and everyone behind them get lobby_state 4 with a wait estimate.
+        const auto now = std::chrono::steady_clock::now();
+        uint32_t group_humans = 0, group_bots = 0;
+        bool waiting_capacity = false;
+        if (queued.size() >= cfg.max_players) {
+            for (size_t i = 0; i < cfg.max_players; ++i)
+                ++(queued[i]->is_bot ? group_bots : group_humans);
+            const auto decision = admission().evaluate(group_humans, group_bots, cfg.tick_rate);
+            waiting_capacity = !decision.admitted();
+            if (waiting_capacity) {
+                T2D_LOG_EVERY_N(
+                    info,
+                    50,
+                    "[admission] holding group humans={} bots={} reason={} predicted_tick_us={} load_cores={} "
+                    "capacity_cores={}",
+                    group_humans,
+                    group_bots,
+                    verdict_name(decision.verdict),
+                    decision.predicted_tick_us,
+                    decision.load_cores,
+                    decision.capacity_cores);
+            }
+        }
+
         // Periodic QueueStatusUpdate broadcast to all waiting sessions (real players only; bots don't receive msgs)
         if (!queued.empty()) {
             uint32_t players_now = static_cast<uint32_t>(queued.size());
@@ -111,11 +150,17 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
                 qs->set_timeout_seconds_left(lobby_countdown);
                 qs->set_lobby_countdown(lobby_countdown);
                 qs->set_projected_bot_fill(projected_bot_fill);
-                qs->set_lobby_state(0); // queued
+                if (waiting_capacity) {
+                    qs->set_lobby_state(4); // waiting for server capacity
+                    qs->set_lobby_countdown(0);
+                    qs->set_estimated_wait_seconds(admission().estimated_wait_seconds(i / cfg.max_players, now));
+                } else {
+                    qs->set_lobby_state(0); // queued
+                }
                 mgr.push_message(sess, smsg);
             }
         }
-        if (queued.size() >= cfg.max_players) {
+        if (queued.size() >= cfg.max_players && !waiting_capacity) {
             // form match using first max_players
             std::vector<std::shared_ptr<Session>> group(queued.begin(), queued.begin() + cfg.max_players);
             mgr.pop_from_queue(group);
@@ -125,6 +170,7 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
             ctx->tick_rate = cfg.tick_rate;
             ctx->players = group;
             ctx->initial_player_count = static_cast<uint32_t>(group.size());
+            ctx->admission_load = admission().admit(group_humans, group_bots, cfg.tick_rate, now);
             ctx->snapshot_interval_ticks = cfg.snapshot_interval_ticks;
             ctx->full_snapshot_interval_ticks = cfg.full_snapshot_interval_ticks;
             // For tests we want rapid engagements; clamp bot fire interval to <=5 ticks
@@ -149,9 +195,20 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
             ctx->test_mode = cfg.test_mode;
             ctx->map_width = cfg.map_width;
             ctx->map_height = cfg.map_height;
+            if (map) {
+                ctx->map = map;
+                ctx->map_width = map->view().width();
+                ctx->map_height = map->view().height();
+            }
             ctx->persist_destroyed_tanks = cfg.persist_destroyed_tanks;
             ctx->track_break_hits = cfg.track_break_hits;
             ctx->turret_disable_front_hits = cfg.turret_disable_front_hits;
+            ctx->priority_tuning.budget_bytes = cfg.snapshot_budget_bytes;
+            ctx->priority_tuning.ref_distance = cfg.snapshot_priority_ref_distance;
+            ctx->keyframe_stagger = cfg.keyframe_stagger;
+            ctx->projectile_spawn_only = cfg.projectile_spawn_only;
+            ctx->headless_policy = headless_policy;
+            ctx->keyframe_request_cooldown_ticks = std::max<uint32_t>(1, cfg.tick_rate / 4); // <= 4 per second
             ctx->physics_world = std::make_unique<t2d::phys::World>(b2Vec2{0.f, 0.f});
             // Spawn distribution (random or forced line for tests)
             uint32_t eid = 1;
@@ -190,13 +247,28 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
                 const float min_dist = 12.f; // separation to avoid overlap (tank ~6 world units long incl. turret)
                 std::vector<std::pair<float, float>> placed;
                 placed.reserve(group.size());
+                const size_t map_spawns = map ? map->view().spawns.size() : 0;
                 for (auto &s : group) {
                     float x = 0.f, y = 0.f;
+                    float angle_deg = 0.f;
                     bool ok = false;
+                    if (placed.size() < map_spawns) {
+                        // Authored spawn points, rotated by seed so the same slot is not always player 1.
+                        const auto &sp = map->view().spawns[(seed + placed.size()) % map_spawns];
+                        x = sp.x;
+                        y = sp.y;
+                        angle_deg = sp.angle_deg;
+                        ok = true;
+                    }
                     for (int attempt = 0; attempt < 200 && !ok; ++attempt) {
                         x = dx(rng);
                         y = dy(rng);
                         ok = true;
+                        // Keep random spawns off wall tiles (need at least one free cell around the tank).
+                        if (map && map->view().clearance_at(x, y) < 2) {
+                            ok = false;
+                            continue;
+                        }
                         for (auto &pp : placed) {
                             float ddx = x - pp.first;
                             float ddy = y - pp.second;
@@ -214,6 +286,11 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
                     placed.emplace_back(x, y);
                     auto phys_tank = t2d::phys::create_tank_with_turret(
                         *ctx->physics_world, x, y, eid++, ctx->hull_density, ctx->turret_density);
+                    if (angle_deg != 0.f) {
+                        b2Rot rot = b2MakeRot(angle_deg * 3.14159265f / 180.f);
+                        b2Body_SetTransform(phys_tank.hull, {x, y}, rot);
+                        b2Body_SetTransform(phys_tank.turret, {x, y}, rot);
+                    }
                     ctx->tanks.push_back(phys_tank);
                     s->tank_entity_id = phys_tank.entity_id;
                     t2d::ServerMessage smsg;
@@ -243,8 +320,8 @@ coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, M
                     auto pos = t2d::phys::get_body_position(adv.hull);
                     b2Transform xh = b2Body_GetTransform(adv.hull);
                     b2Transform xt = b2Body_GetTransform(adv.turret);
-                    float hull_deg = std::atan2(xh.q.s, xh.q.c) * 180.f / 3.14159265f;
-                    float tur_deg = std::atan2(xt.q.s, xt.q.c) * 180.f / 3.14159265f;
+                    float hull_deg = t2d::math::vec_deg(xh.q.c, xh.q.s);
+                    float tur_deg = t2d::math::vec_deg(xt.q.c, xt.q.s);
                     ts->set_entity_id(adv.entity_id);
                     ts->set_x(pos.x);
                     ts->set_y(pos.y);
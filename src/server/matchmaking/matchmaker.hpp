@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
 namespace t2d::mm {
 
@@ -42,6 +43,17 @@ struct MatchConfig
     uint32_t turret_disable_front_hits{2}; // frontal hits to disable turret motor
     // Optional fixed seed override; when >0 use this instead of random_seed()
     uint32_t fixed_seed{0};
+    // Optional compiled static map (t2d_map_compile output). Empty = legacy walls + random crate clusters.
+    std::string map_path{};
+    // Per-client delta byte budget with priority accumulators (0 = unlimited, every change sent every delta).
+    uint32_t snapshot_budget_bytes{0};
+    float snapshot_priority_ref_distance{20.f};
+    // Per-client keyframe phases spread over full_snapshot_interval_ticks (false = synchronized full snapshots).
+    bool keyframe_stagger{true};
+    // Projectiles replicated as spawn samples + trajectory changes, extrapolated by clients (false = every delta).
+    bool projectile_spawn_only{true};
+    // Once every human has disconnected: "end" now, "fast_forward" to a result at 4x speed, "keep" simulating (legacy).
+    std::string headless_policy{"end"};
 };
 
 coro::task<void> run_matchmaker(std::shared_ptr<coro::io_scheduler> scheduler, MatchConfig cfg);
@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/matchmaking/outbound_lanes.hpp"
+
+#include "common/frame_header.hpp"
+#include "common/metrics.hpp"
+
+#include <algorithm>
+
+namespace t2d::mm {
+
+OutboundLane outbound_lane(const t2d::ServerMessage &msg)
+{
+    return (msg.has_snapshot() || msg.has_delta_snapshot()) ? OutboundLane::State : OutboundLane::Control;
+}
+
+std::shared_ptr<const EncodedMessage> encode_shared(const t2d::ServerMessage &msg)
+{
+    auto enc = std::make_shared<EncodedMessage>();
+    enc->msg = msg;
+    if (!msg.SerializeToString(&enc->body))
+        return nullptr;
+    const bool state = outbound_lane(msg) == OutboundLane::State;
+    enc->typed = t2d::netutil::build_typed_frame(
+        t2d::netutil::FrameType::ServerMessage,
+        enc->body,
+        enc->body.size() >= t2d::netutil::FRAME_COMPRESS_MIN_BYTES,
+        state ? t2d::netutil::FRAME_FLAG_MORE : 0);
+    t2d::metrics::runtime().fanout_encodes.fetch_add(1, std::memory_order_relaxed);
+    return enc;
+}
+
+// LEB128 varint into buf (at most 5 bytes); returns its length.
+static size_t put_varint(char *buf, uint32_t v)
+{
+    size_t n = 0;
+    while (v >= 0x80) {
+        buf[n++] = static_cast<char>((v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = static_cast<char>(v);
+    return n;
+}
+
+void append_last_input_tick(const t2d::ServerMessage &msg, uint32_t tick, std::string &out)
+{
+    constexpr uint32_t kVarint = 0;
+    constexpr uint32_t kLengthDelimited = 2;
+    const bool delta = msg.has_delta_snapshot();
+    const uint32_t outer = delta ? static_cast<uint32_t>(t2d::ServerMessage::kDeltaSnapshotFieldNumber)
+                                 : static_cast<uint32_t>(t2d::ServerMessage::kSnapshotFieldNumber);
+    const uint32_t inner = delta ? static_cast<uint32_t>(t2d::DeltaSnapshot::kLastInputTickFieldNumber)
+                                 : static_cast<uint32_t>(t2d::StateSnapshot::kLastInputTickFieldNumber);
+    char field[10];
+    size_t field_len = put_varint(field, (inner << 3) | kVarint);
+    field_len += put_varint(field + field_len, tick);
+    char head[10];
+    size_t head_len = put_varint(head, (outer << 3) | kLengthDelimited);
+    head_len += put_varint(head + head_len, static_cast<uint32_t>(field_len));
+    out.append(head, head_len);
+    out.append(field, field_len);
+}
+
+// Replaces the entry with the same id in into (or appends it).
+template <typename List, typename Id> static void upsert(List &into, const typename List::value_type &v, Id id)
+{
+    auto it = std::find_if(into.begin(), into.end(), [&](const auto &e) { return id(e) == id(v); });
+    if (it != into.end())
+        *it = v;
+    else
+        *into.Add() = v;
+}
+
+template <typename List, typename Id> static void erase_id(List &from, uint32_t removed, Id id)
+{
+    for (int i = 0; i < from.size(); ++i) {
+        if (id(from.Get(i)) == removed) {
+            from.DeleteSubrange(i, 1);
+            return;
+        }
+    }
+}
+
+static void append_unique(google::protobuf::RepeatedField<uint32_t> &into, uint32_t v)
+{
+    if (std::find(into.begin(), into.end(), v) == into.end())
+        into.Add(v);
+}
+
+bool merge_delta(t2d::DeltaSnapshot &queued, const t2d::DeltaSnapshot &newer)
+{
+    if (queued.base_tick() != newer.base_tick())
+        return false;
+    const auto tank_id = [](const t2d::TankState &t) { return t.entity_id(); };
+    const auto proj_id = [](const t2d::ProjectileState &p) { return p.projectile_id(); };
+    const auto crate_id = [](const t2d::CrateState &c) { return c.crate_id(); };
+    const auto box_id = [](const t2d::AmmoBoxState &b) { return b.box_id(); };
+    // ref_tick 0 means "sampled at the carrying message's tick", which is about to change.
+    for (auto &p : *queued.mutable_projectiles()) {
+        if (p.ref_tick() == 0)
+            p.set_ref_tick(queued.server_tick());
+    }
+    for (const auto &t : newer.tanks())
+        upsert(*queued.mutable_tanks(), t, tank_id);
+    for (const auto &p : newer.projectiles())
+        upsert(*queued.mutable_projectiles(), p, proj_id);
+    for (const auto &c : newer.crates())
+        upsert(*queued.mutable_crates(), c, crate_id);
+    for (const auto &b : newer.ammo_boxes())
+        upsert(*queued.mutable_ammo_boxes(), b, box_id);
+    for (uint32_t id : newer.removed_tanks()) {
+        erase_id(*queued.mutable_tanks(), id, tank_id);
+        append_unique(*queued.mutable_removed_tanks(), id);
+    }
+    for (uint32_t id : newer.removed_projectiles()) {
+        erase_id(*queued.mutable_projectiles(), id, proj_id);
+        append_unique(*queued.mutable_removed_projectiles(), id);
+    }
+    for (uint32_t id : newer.removed_crates()) {
+        erase_id(*queued.mutable_crates(), id, crate_id);
+        append_unique(*queued.mutable_removed_crates(), id);
+    }
+    queued.set_server_tick(newer.server_tick());
+    queued.set_server_time_us(newer.server_time_us());
+    queued.set_last_input_tick(newer.last_input_tick());
+    return true;
+}
+
+void OutboundLanes::rescue_events(t2d::TickEvents &events, Clock::time_point queued_at)
+{
+    auto &control = m_lanes[static_cast<size_t>(OutboundLane::Control)];
+    // Control messages queued after the state message stay behind its events.
+    auto pos = std::upper_bound(control.queued_at.begin(), control.queued_at.end(), queued_at);
+    const auto idx = pos - control.queued_at.begin();
+    control.queued_at.insert(pos, queued_at);
+    auto entry = control.messages.emplace(control.messages.begin() + idx);
+    entry->msg.mutable_tick_events()->Swap(&events);
+    t2d::metrics::runtime().outbound_events_rescued.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OutboundLanes::rescue_events(OutboundMessage &entry, Clock::time_point queued_at)
+{
+    if (entry.shared) {
+        const auto &msg = entry.shared->msg;
+        t2d::TickEvents copy;
+        if (msg.has_snapshot() && msg.snapshot().has_events())
+            copy = msg.snapshot().events();
+        else if (msg.has_delta_snapshot() && msg.delta_snapshot().has_events())
+            copy = msg.delta_snapshot().events();
+        else
+            return;
+        rescue_events(copy, queued_at);
+        return;
+    }
+    auto &state = entry.msg;
+    if (state.has_snapshot() && state.snapshot().has_events()) {
+        rescue_events(*state.mutable_snapshot()->mutable_events(), queued_at);
+        state.mutable_snapshot()->clear_events();
+    } else if (state.has_delta_snapshot() && state.delta_snapshot().has_events()) {
+        rescue_events(*state.mutable_delta_snapshot()->mutable_events(), queued_at);
+        state.mutable_delta_snapshot()->clear_events();
+    }
+}
+
+void OutboundLanes::supersede_state()
+{
+    auto &q = m_lanes[static_cast<size_t>(OutboundLane::State)];
+    for (size_t i = 0; i < q.messages.size(); ++i)
+        rescue_events(q.messages[i], q.queued_at[i]);
+    t2d::metrics::runtime().outbound_state_superseded.fetch_add(q.messages.size(), std::memory_order_relaxed);
+    q.messages.clear();
+    q.queued_at.clear();
+}
+
+t2d::ServerMessage &OutboundLanes::push(const t2d::ServerMessage &msg, Clock::time_point now)
+{
+    const auto lane = outbound_lane(msg);
+    auto &q = m_lanes[static_cast<size_t>(lane)];
+    if (lane == OutboundLane::State && !q.messages.empty()) {
+        if (msg.has_snapshot()) {
+            supersede_state();
+        } else {
+            auto &last = q.messages.back();
+            if (!last.shared && last.msg.has_delta_snapshot()
+                && last.msg.delta_snapshot().base_tick() == msg.delta_snapshot().base_tick()) {
+                // The merged message keeps the older queue time (its latency covers the oldest state it carries);
+                // both event batches keep their own position in the control lane.
+                rescue_events(last, q.queued_at.back());
+                merge_delta(*last.msg.mutable_delta_snapshot(), msg.delta_snapshot());
+                if (msg.delta_snapshot().has_events()) {
+                    t2d::TickEvents events = msg.delta_snapshot().events();
+                    rescue_events(events, now);
+                }
+                t2d::metrics::runtime().outbound_state_superseded.fetch_add(1, std::memory_order_relaxed);
+                publish_depth();
+                return last.msg;
+            }
+        }
+    }
+    q.messages.emplace_back().msg = msg;
+    q.queued_at.push_back(now);
+    publish_depth();
+    return q.messages.back().msg;
+}
+
+OutboundMessage &OutboundLanes::push(std::shared_ptr<const EncodedMessage> shared, Clock::time_point now)
+{
+    const auto lane = outbound_lane(shared->msg);
+    auto &q = m_lanes[static_cast<size_t>(lane)];
+    if (lane == OutboundLane::State && shared->msg.has_snapshot() && !q.messages.empty())
+        supersede_state();
+    q.messages.emplace_back().shared = std::move(shared);
+    q.queued_at.push_back(now);
+    publish_depth();
+    return q.messages.back();
+}
+
+size_t OutboundLanes::size() const
+{
+    size_t n = 0;
+    for (const auto &q : m_lanes)
+        n += q.messages.size();
+    return n;
+}
+
+} // namespace t2d::mm
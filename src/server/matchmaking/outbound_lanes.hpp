@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+// outbound_lanes.hpp - per-session outbound queues split by delivery class. Reliable messages (match lifecycle,
+// queue status, tick events, kill feed) go to the control lane and are never dropped; snapshots and deltas go to the
+// state lane, where newer state replaces queued state once the socket falls behind. Draining flushes the control
+// lane first, so a MatchEnd or a damage batch never waits behind a large full snapshot.
+//
+// Fan-out messages (event batches, keyframes, match lifecycle) are serialized once per fan-out and every recipient
+// queues a reference to that encoding; only per-recipient messages (budgeted deltas, queue status) are queued as
+// protobuf copies and serialized by the connection.
+#pragma once
+#include "game.pb.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace t2d::mm {
+
+// Lanes in flush order.
+enum class OutboundLane : uint8_t
+{
+    Control = 0,
+    State = 1,
+};
+inline constexpr size_t kOutboundLanes = 2;
+
+OutboundLane outbound_lane(const t2d::ServerMessage &msg);
+
+// A fan-out message serialized once, shared by the queues of all its recipients. typed is the complete frame for
+// clients that negotiated frame headers. For snapshots it is a leading fragment (FRAME_FLAG_MORE): each recipient
+// completes it with a short final fragment carrying its own last_input_tick (see append_last_input_tick).
+struct EncodedMessage
+{
+    t2d::ServerMessage msg; // decoded form: lane, superseding, event rescue
+    std::string body; // serialized msg (legacy frames add the length prefix per recipient)
+    std::string typed;
+};
+
+std::shared_ptr<const EncodedMessage> encode_shared(const t2d::ServerMessage &msg);
+
+// Appends the encoding of {snapshot | delta_snapshot: {last_input_tick: tick}} (matching msg's state field) to out.
+// Parsed right after msg's body it merges into the same submessage, so shared body + suffix reads as a stamped copy.
+void append_last_input_tick(const t2d::ServerMessage &msg, uint32_t tick, std::string &out);
+
+struct OutboundMessage
+{
+    t2d::ServerMessage msg; // per-recipient message (empty when shared is set)
+    std::shared_ptr<const EncodedMessage> shared; // fan-out message encoded once
+    uint32_t last_input_tick{0}; // recipient stamp for a shared snapshot (0 = none)
+
+    const t2d::ServerMessage &message() const { return shared ? shared->msg : msg; }
+};
+
+// Folds newer into queued (both deltas against the same base_tick): entities upsert by id, removals accumulate and
+// the tick fields (server_tick, server_time_us, last_input_tick) come from newer. Returns false, leaving queued
+// untouched, when the bases differ. Events are left alone (they belong to one tick; see OutboundLanes::push).
+bool merge_delta(t2d::DeltaSnapshot &queued, const t2d::DeltaSnapshot &newer);
+
+// Not thread-safe; guarded by the SessionManager mutex like the rest of the Session (except queued_relaxed()).
+class OutboundLanes
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    OutboundLanes() = default;
+    OutboundLanes(OutboundLanes &&other) noexcept : m_lanes(std::move(other.m_lanes)) { publish_depth(); }
+    OutboundLanes &operator=(OutboundLanes &&other) noexcept
+    {
+        m_lanes = std::move(other.m_lanes);
+        publish_depth();
+        return *this;
+    }
+
+    // Queues msg on its lane and returns the queued copy (for per-recipient stamping). State superseding:
+    //  - a full snapshot replaces every queued state message;
+    //  - a delta is folded into a queued delta of the same base (deltas are diffs against the previously built
+    //    state, so they are merged, never dropped).
+    // Events piggybacked on a replaced or merged state message move to the control lane as a standalone TickEvents
+    // batch at their original queue position.
+    t2d::ServerMessage &push(const t2d::ServerMessage &msg, Clock::time_point now);
+    // Queues a shared encoding (same superseding for full snapshots; shared deltas are never merged).
+    OutboundMessage &push(std::shared_ptr<const EncodedMessage> shared, Clock::time_point now);
+
+    // Moves every queued message to out, control lane first, and reports each message's time in the queue
+    // (microseconds) per lane through on_latency(lane, us). Lane storage keeps its capacity.
+    template <typename F> void drain(std::vector<OutboundMessage> &out, Clock::time_point now, F &&on_latency)
+    {
+        out.reserve(out.size() + size());
+        for (size_t l = 0; l < kOutboundLanes; ++l) {
+            auto &q = m_lanes[l];
+            for (size_t i = 0; i < q.messages.size(); ++i) {
+                out.push_back(std::move(q.messages[i]));
+                auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - q.queued_at[i]).count();
+                on_latency(static_cast<OutboundLane>(l), static_cast<uint64_t>(us < 0 ? 0 : us));
+            }
+            q.messages.clear();
+            q.queued_at.clear();
+        }
+        publish_depth();
+    }
+
+    size_t size() const;
+    size_t size(OutboundLane lane) const { return m_lanes[static_cast<size_t>(lane)].messages.size(); }
+    bool empty() const { return size() == 0; }
+    // size() as of the last push / drain, readable from any thread without the owner's lock (flight recorder).
+    uint32_t queued_relaxed() const { return m_depth.load(std::memory_order_relaxed); }
+
+private:
+    struct Queue
+    {
+        std::vector<OutboundMessage> messages;
+        std::vector<Clock::time_point> queued_at; // parallel to messages
+    };
+
+    // Drops every queued state message ahead of a full snapshot, rescuing their events.
+    void supersede_state();
+    // Moves the events of a state message about to be replaced or merged into the control lane (copied out of a
+    // shared encoding).
+    void rescue_events(OutboundMessage &state, Clock::time_point queued_at);
+    void rescue_events(t2d::TickEvents &events, Clock::time_point queued_at);
+    void publish_depth() { m_depth.store(static_cast<uint32_t>(size()), std::memory_order_relaxed); }
+
+    std::array<Queue, kOutboundLanes> m_lanes;
+    std::atomic<uint32_t> m_depth{0};
+};
+
+} // namespace t2d::mm
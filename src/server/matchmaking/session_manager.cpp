@@ -23,6 +23,15 @@ std::shared_ptr<Session> SessionManager::add_connection(coro::net::tcp::client c
     return s;
 }
 
+std::shared_ptr<Session> SessionManager::add_connection()
+{
+    std::scoped_lock lk{m_mutex};
+    auto s = std::make_shared<Session>();
+    s->connection_id = "conn_" + std::to_string(++m_connection_counter);
+    m_by_connection.emplace(s->connection_id, s);
+    return s;
+}
+
 void SessionManager::authenticate(const std::shared_ptr<Session> &s, std::string session_id)
 {
     std::scoped_lock lk{m_mutex};
@@ -66,20 +75,90 @@ void SessionManager::pop_from_queue(const std::vector<std::shared_ptr<Session>>
     }
 }
 
+// Remembers which applied client tick went into a queued snapshot (caller holds m_mutex).
+static void note_stamp(Session::InputLatency &lat)
+{
+    if (lat.applied_tick != lat.stamped_tick) {
+        lat.stamped_tick = lat.applied_tick;
+        lat.stamped_received_at = lat.applied_received_at;
+    }
+}
+
+// Writes the recipient's newest applied client tick into its copy of a snapshot (caller holds m_mutex).
+static void stamp_last_input_tick(Session &s, t2d::ServerMessage &msg)
+{
+    auto &lat = s.latency;
+    if (lat.applied_tick == 0)
+        return;
+    if (msg.has_snapshot())
+        msg.mutable_snapshot()->set_last_input_tick(lat.applied_tick);
+    else if (msg.has_delta_snapshot())
+        msg.mutable_delta_snapshot()->set_last_input_tick(lat.applied_tick);
+    else
+        return;
+    note_stamp(lat);
+}
+
+// Same for a shared snapshot: the stamp travels next to the shared encoding and is appended when framed.
+static void stamp_last_input_tick(Session &s, OutboundMessage &entry)
+{
+    auto &lat = s.latency;
+    if (lat.applied_tick == 0 || outbound_lane(entry.message()) != OutboundLane::State)
+        return;
+    entry.last_input_tick = lat.applied_tick;
+    note_stamp(lat);
+}
+
 void SessionManager::push_message(const std::shared_ptr<Session> &s, const t2d::ServerMessage &msg)
 {
     std::scoped_lock lk{m_mutex};
     if (s->is_bot)
         return; // bots do not receive network messages (prototype)
-    s->outgoing.push_back(msg);
+    stamp_last_input_tick(*s, s->outbound.push(msg, std::chrono::steady_clock::now()));
+}
+
+void SessionManager::push_message_all(
+    const std::vector<std::shared_ptr<Session>> &recipients, const t2d::ServerMessage &msg)
+{
+    // is_bot is fixed for a session's lifetime, so the recipient check and the serialization stay outside the lock.
+    if (std::none_of(recipients.begin(), recipients.end(), [](const auto &s) { return !s->is_bot; }))
+        return;
+    auto shared = encode_shared(msg);
+    if (!shared)
+        return;
+    std::scoped_lock lk{m_mutex};
+    const auto now = std::chrono::steady_clock::now();
+    for (auto &s : recipients) {
+        if (s->is_bot)
+            continue;
+        stamp_last_input_tick(*s, s->outbound.push(shared, now));
+    }
 }
 
-std::vector<t2d::ServerMessage> SessionManager::drain_messages(const std::shared_ptr<Session> &s)
+void SessionManager::drain_messages(const std::shared_ptr<Session> &s, std::vector<OutboundMessage> &out)
 {
     std::scoped_lock lk{m_mutex};
-    std::vector<t2d::ServerMessage> out;
-    out.swap(s->outgoing);
-    return out;
+    if (s->outbound.empty())
+        return;
+    const auto now = std::chrono::steady_clock::now();
+    s->outbound.drain(out, now, [](OutboundLane lane, uint64_t us) {
+        if (lane == OutboundLane::Control)
+            t2d::metrics::add_outbound_control_queue(us);
+        else
+            t2d::metrics::add_outbound_state_queue(us);
+    });
+    // The drained batch goes straight to the socket: a newly stamped tick has now reached the send path.
+    auto &lat = s->latency;
+    if (lat.stamped_tick != lat.sent_tick) {
+        lat.sent_tick = lat.stamped_tick;
+        auto us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - lat.stamped_received_at).count());
+        ++lat.samples;
+        lat.recv_to_send_us_sum += us;
+        lat.recv_to_send_us_max = std::max(lat.recv_to_send_us_max, us);
+        lat.recv_to_send_us_last = us;
+        t2d::metrics::add_input_recv_to_send(us);
+    }
 }
 
 void SessionManager::update_heartbeat(const std::shared_ptr<Session> &s)
@@ -88,22 +167,48 @@ void SessionManager::update_heartbeat(const std::shared_ptr<Session> &s)
     s->last_heartbeat = std::chrono::steady_clock::now();
 }
 
+void SessionManager::update_heartbeat(const std::shared_ptr<Session> &s, const t2d::Heartbeat &hb)
+{
+    std::scoped_lock lk{m_mutex};
+    s->last_heartbeat = std::chrono::steady_clock::now();
+    if (hb.rtt_us() == 0)
+        return; // no completed exchange yet
+    s->clock.rtt_us = hb.rtt_us();
+    s->clock.offset_us = hb.clock_offset_us();
+    ++s->clock.reports;
+}
+
+Session::ClockReport SessionManager::get_clock_report(const std::shared_ptr<Session> &s)
+{
+    std::scoped_lock lk{m_mutex};
+    return s->clock;
+}
+
 void SessionManager::update_input(const std::shared_ptr<Session> &s, const t2d::InputCommand &cmd)
+{
+    Session::InputState in;
+    in.last_client_tick = cmd.client_tick();
+    in.move_dir = cmd.move_dir();
+    in.turn_dir = cmd.turn_dir();
+    in.turret_turn = cmd.turret_turn();
+    in.fire = cmd.fire();
+    in.brake = cmd.brake();
+    update_input(s, in);
+}
+
+void SessionManager::update_input(const std::shared_ptr<Session> &s, const Session::InputState &in)
 {
     std::scoped_lock lk{m_mutex};
-    if (cmd.client_tick() < s->input.last_client_tick)
+    if (in.last_client_tick < s->input.last_client_tick)
         return; // ignore old
-    bool move_changed = s->input.move_dir != cmd.move_dir();
-    bool turn_changed = s->input.turn_dir != cmd.turn_dir();
-    bool turret_changed = s->input.turret_turn != cmd.turret_turn();
-    bool fire_changed = s->input.fire != cmd.fire();
-    bool brake_changed = s->input.brake != cmd.brake();
-    s->input.last_client_tick = cmd.client_tick();
-    s->input.move_dir = cmd.move_dir();
-    s->input.turn_dir = cmd.turn_dir();
-    s->input.turret_turn = cmd.turret_turn();
-    s->input.fire = cmd.fire();
-    s->input.brake = cmd.brake();
+    if (in.last_client_tick > s->input.last_client_tick)
+        s->latency.received_at = std::chrono::steady_clock::now();
+    bool move_changed = s->input.move_dir != in.move_dir;
+    bool turn_changed = s->input.turn_dir != in.turn_dir;
+    bool turret_changed = s->input.turret_turn != in.turret_turn;
+    bool fire_changed = s->input.fire != in.fire;
+    bool brake_changed = s->input.brake != in.brake;
+    s->input = in;
     if (!s->is_bot && (move_changed || turn_changed || turret_changed || fire_changed || brake_changed)) {
         // Revert to debug (was temporarily elevated to info).
         t2d::log::debug(
@@ -124,6 +229,45 @@ Session::InputState SessionManager::get_input_copy(const std::shared_ptr<Session
     return s->input;
 }
 
+Session::InputState SessionManager::apply_input(const std::shared_ptr<Session> &s)
+{
+    std::scoped_lock lk{m_mutex};
+    auto &lat = s->latency;
+    if (!s->is_bot && s->input.last_client_tick > lat.applied_tick) {
+        lat.applied_tick = s->input.last_client_tick;
+        lat.applied_received_at = lat.received_at;
+        t2d::metrics::add_input_recv_to_apply(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lat.received_at)
+                .count()));
+    }
+    return s->input;
+}
+
+Session::InputLatency SessionManager::get_input_latency(const std::shared_ptr<Session> &s)
+{
+    std::scoped_lock lk{m_mutex};
+    return s->latency;
+}
+
+void SessionManager::request_keyframe(const std::shared_ptr<Session> &s)
+{
+    std::scoped_lock lk{m_mutex};
+    s->keyframe_requested = true;
+}
+
+void SessionManager::consume_keyframe_requests(
+    const std::vector<std::shared_ptr<Session>> &players, std::vector<size_t> &out)
+{
+    out.clear();
+    std::scoped_lock lk{m_mutex};
+    for (size_t i = 0; i < players.size(); ++i) {
+        if (players[i]->keyframe_requested) {
+            players[i]->keyframe_requested = false;
+            out.push_back(i);
+        }
+    }
+}
+
 std::vector<std::shared_ptr<Session>> SessionManager::snapshot_all_sessions()
 {
     std::scoped_lock lk{m_mutex};
@@ -137,6 +281,8 @@ std::vector<std::shared_ptr<Session>> SessionManager::snapshot_all_sessions()
 void SessionManager::disconnect_session(const std::shared_ptr<Session> &s)
 {
     std::scoped_lock lk{m_mutex};
+    if (s->disconnected)
+        return; // heartbeat timeout and connection close both land here
     if (s->in_queue) {
         m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), s), m_queue.end());
         s->in_queue = false;
@@ -144,6 +290,7 @@ void SessionManager::disconnect_session(const std::shared_ptr<Session> &s)
     if (!s->session_id.empty())
         m_by_session.erase(s->session_id);
     m_by_connection.erase(s->connection_id);
+    s->disconnected = true;
     if (!s->is_bot && s->authenticated) {
         auto &cp = t2d::metrics::runtime().connected_players;
         auto cur = cp.load(std::memory_order_relaxed);
@@ -152,26 +299,92 @@ void SessionManager::disconnect_session(const std::shared_ptr<Session> &s)
     }
 }
 
+void SessionManager::find_disconnected(const std::vector<std::shared_ptr<Session>> &players, std::vector<size_t> &out)
+{
+    out.clear();
+    std::scoped_lock lk{m_mutex};
+    for (size_t i = 0; i < players.size(); ++i) {
+        if (players[i]->disconnected)
+            out.push_back(i);
+    }
+}
+
+size_t SessionManager::outbound_pending(const std::vector<std::shared_ptr<Session>> &players) const
+{
+    size_t n = 0;
+    for (const auto &s : players)
+        n += s->outbound.queued_relaxed();
+    return n;
+}
+
+// Caller holds m_mutex.
+static void publish_bot_gauges(size_t live, size_t pooled)
+{
+    auto &rt = t2d::metrics::runtime();
+    rt.bots_live.store(live, std::memory_order_relaxed);
+    rt.bots_pooled.store(pooled, std::memory_order_relaxed);
+}
+
 std::vector<std::shared_ptr<Session>> SessionManager::create_bots(size_t count)
 {
     std::scoped_lock lk{m_mutex};
     std::vector<std::shared_ptr<Session>> created;
     created.reserve(count);
     for (size_t i = 0; i < count; ++i) {
-        auto s = std::make_shared<Session>();
-        s->is_bot = true;
-        s->authenticated = true;
-        s->session_id = "bot_" + std::to_string(++m_bot_counter);
+        std::shared_ptr<Session> s;
+        if (!m_bot_pool.empty()) {
+            s = std::move(m_bot_pool.back());
+            m_bot_pool.pop_back();
+        } else {
+            s = std::make_shared<Session>();
+            s->is_bot = true;
+            s->authenticated = true;
+            s->session_id = "bot_" + std::to_string(++m_bot_counter);
+        }
         s->last_heartbeat = std::chrono::steady_clock::now();
         s->in_queue = true;
-        s->queue_join_time = std::chrono::steady_clock::now();
+        s->queue_join_time = s->last_heartbeat;
         m_queue.push_back(s);
-        m_by_session[s->session_id] = s;
         created.push_back(s);
     }
+    m_live_bots += count;
+    publish_bot_gauges(m_live_bots, m_bot_pool.size());
     return created;
 }
 
+void SessionManager::release_bots(const std::vector<std::shared_ptr<Session>> &players)
+{
+    std::scoped_lock lk{m_mutex};
+    for (auto &s : players) {
+        if (!s->is_bot)
+            continue;
+        if (s->in_queue)
+            m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), s), m_queue.end());
+        // Fresh state for the next match; the id stays with the pooled session.
+        std::string id = std::move(s->session_id);
+        *s = Session{};
+        s->session_id = std::move(id);
+        s->is_bot = true;
+        s->authenticated = true;
+        m_bot_pool.push_back(s);
+        if (m_live_bots > 0)
+            --m_live_bots;
+    }
+    publish_bot_gauges(m_live_bots, m_bot_pool.size());
+}
+
+size_t SessionManager::live_bot_count()
+{
+    std::scoped_lock lk{m_mutex};
+    return m_live_bots;
+}
+
+size_t SessionManager::pooled_bot_count()
+{
+    std::scoped_lock lk{m_mutex};
+    return m_bot_pool.size();
+}
+
 void SessionManager::set_bot_input(const std::shared_ptr<Session> &s, const Session::InputState &st)
 {
     std::scoped_lock lk{m_mutex};
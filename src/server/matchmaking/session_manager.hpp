@@ -2,6 +2,7 @@
 #pragma once
 
 #include "game.pb.h"
+#include "server/matchmaking/outbound_lanes.hpp"
 
 #include <coro/net/tcp/client.hpp>
 
@@ -23,6 +24,8 @@ struct Session : public std::enable_shared_from_this<Session>
     bool authenticated{false};
     bool in_queue{false};
     bool is_bot{false};
+    // Set by disconnect_session (guarded by the SessionManager mutex); the match loop drops the player's tank.
+    bool disconnected{false};
     // Match association (set when a match starts). Weak reference to avoid lifetime cycles.
     std::weak_ptr<void> match_ctx; // cast to t2d::game::MatchContext in implementation to avoid circular include
     uint32_t tank_entity_id{0}; // entity id inside the match (0 if not in a match)
@@ -42,8 +45,37 @@ struct Session : public std::enable_shared_from_this<Session>
         uint32_t last_client_tick{0};
     } input;
 
+    // Input-to-effect instrumentation (guarded by the SessionManager mutex). A newer client tick is stamped on
+    // receive, marked applied when the match loop first reads it, written into this player's snapshots as
+    // last_input_tick and measured (receive -> send) when the first stamped snapshot is drained for the socket.
+    struct InputLatency
+    {
+        std::chrono::steady_clock::time_point received_at{}; // of input.last_client_tick
+        uint32_t applied_tick{0};
+        std::chrono::steady_clock::time_point applied_received_at{};
+        uint32_t stamped_tick{0}; // newest tick written into a queued snapshot
+        std::chrono::steady_clock::time_point stamped_received_at{};
+        uint32_t sent_tick{0}; // newest tick already measured at send
+        uint64_t samples{0};
+        uint64_t recv_to_send_us_sum{0};
+        uint64_t recv_to_send_us_max{0};
+        uint64_t recv_to_send_us_last{0};
+    } latency;
+
+    // Clock sync estimate the client reported in its last Heartbeat (rtt_us / clock_offset_us); reports == 0 until
+    // the client completed its first exchange. Guarded by the SessionManager mutex.
+    struct ClockReport
+    {
+        uint32_t rtt_us{0};
+        int64_t offset_us{0};
+        uint64_t reports{0};
+    } clock;
+
+    // Client asked for an on-demand keyframe (KeyframeRequest); consumed by the match loop.
+    bool keyframe_requested{false};
+
     std::unique_ptr<coro::net::tcp::client> client; // nullptr for bots
-    std::vector<t2d::ServerMessage> outgoing; // pending outbound messages
+    OutboundLanes outbound; // pending outbound messages (control lane, state lane)
 
     Session(std::string cid, coro::net::tcp::client c)
         : connection_id(std::move(cid)), client(std::make_unique<coro::net::tcp::client>(std::move(c)))
@@ -56,19 +88,47 @@ class SessionManager
 {
 public:
     std::shared_ptr<Session> add_connection(coro::net::tcp::client client);
+    // Connection whose socket is owned by another transport (io_uring backend): client stays nullptr.
+    std::shared_ptr<Session> add_connection();
     void authenticate(const std::shared_ptr<Session> &s, std::string session_id);
     void enqueue(const std::shared_ptr<Session> &s);
     std::vector<std::shared_ptr<Session>> snapshot_queue();
     void pop_from_queue(const std::vector<std::shared_ptr<Session>> &sessions);
     void push_message(const std::shared_ptr<Session> &s, const t2d::ServerMessage &msg);
-    std::vector<t2d::ServerMessage> drain_messages(const std::shared_ptr<Session> &s);
+    // Fan-out helper: serializes msg once (outside the lock) and queues that encoding for every human recipient under
+    // a single lock acquisition; snapshots get each recipient's last_input_tick as a separate stamp.
+    void push_message_all(const std::vector<std::shared_ptr<Session>> &recipients, const t2d::ServerMessage &msg);
+    // Appends pending messages to out in egress order: the control lane (reliable, never dropped) ahead of the state
+    // lane. out is the caller's reused buffer.
+    void drain_messages(const std::shared_ptr<Session> &s, std::vector<OutboundMessage> &out);
     void update_heartbeat(const std::shared_ptr<Session> &s);
+    // Also records the client's clock sync estimate when the heartbeat carries one.
+    void update_heartbeat(const std::shared_ptr<Session> &s, const t2d::Heartbeat &hb);
+    Session::ClockReport get_clock_report(const std::shared_ptr<Session> &s);
     void update_input(const std::shared_ptr<Session> &s, const t2d::InputCommand &cmd);
+    // Compact input fast path (already decoded; last_client_tick carries the client tick).
+    void update_input(const std::shared_ptr<Session> &s, const Session::InputState &in);
     Session::InputState get_input_copy(const std::shared_ptr<Session> &s);
+    // Match loop read of this tick's input; also marks a newly seen client tick as applied (latency metrics).
+    Session::InputState apply_input(const std::shared_ptr<Session> &s);
+    Session::InputLatency get_input_latency(const std::shared_ptr<Session> &s);
+    void request_keyframe(const std::shared_ptr<Session> &s);
+    // Indices of players that asked for a keyframe since the last call, clearing their flags (one lock per match).
+    void consume_keyframe_requests(const std::vector<std::shared_ptr<Session>> &players, std::vector<size_t> &out);
+    // Human sessions past authentication (bots live in the bot pool, not in this registry).
     std::vector<std::shared_ptr<Session>> snapshot_all_sessions();
     void disconnect_session(const std::shared_ptr<Session> &s);
-    // Create and enqueue the given number of bot sessions; returns created bots
+    // Indices of players disconnected since they joined the match (one lock, independent of the registry size).
+    void find_disconnected(const std::vector<std::shared_ptr<Session>> &players, std::vector<size_t> &out);
+    // Outbound messages still queued for the given sessions, as of their last push / drain. Lock-free (per-session
+    // relaxed counters), so the flight recorder can sample it every tick.
+    size_t outbound_pending(const std::vector<std::shared_ptr<Session>> &players) const;
+    // Enqueue the given number of bots, reusing pooled sessions before allocating new ones; returns the bots.
     std::vector<std::shared_ptr<Session>> create_bots(size_t count);
+    // Match end: resets the match's bots and returns them to the pool (humans in players are ignored).
+    void release_bots(const std::vector<std::shared_ptr<Session>> &players);
+    size_t live_bot_count();
+    size_t pooled_bot_count();
     // Directly set input for a bot (no client tick ordering)
     void set_bot_input(const std::shared_ptr<Session> &s, const Session::InputState &st);
     void clear_bot_fire(const std::shared_ptr<Session> &s);
@@ -80,6 +140,10 @@ private:
     std::unordered_map<std::string, std::shared_ptr<Session>> m_by_connection; // pre-auth
     std::unordered_map<std::string, std::shared_ptr<Session>> m_by_session; // post-auth
     std::vector<std::shared_ptr<Session>> m_queue; // FIFO queue of players waiting matchmaking
+    // Idle bots (LIFO; bounded by the peak number of bots in use at once). Live bots are owned by the queue and the
+    // match contexts only.
+    std::vector<std::shared_ptr<Session>> m_bot_pool;
+    size_t m_live_bots{0};
 };
 
 // Global accessor (simple singleton for early prototype)
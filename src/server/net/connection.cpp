@@ -0,0 +1,337 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/net/connection.hpp"
+
+#include "common/clock_sync.hpp"
+#include "common/compact_input.hpp"
+#include "common/logger.hpp"
+#include "common/metrics.hpp"
+#include "common/rle.hpp"
+#include "server/auth/auth_provider.hpp"
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace t2d::net {
+
+// frame_len includes the length prefix and the 4-byte compressed header.
+static void count_compressed(size_t body_len, size_t frame_len)
+{
+    auto &rt = t2d::metrics::runtime();
+    rt.frames_compressed.fetch_add(1, std::memory_order_relaxed);
+    rt.frame_compress_saved_bytes.fetch_add(body_len + 8 - frame_len, std::memory_order_relaxed);
+}
+
+// Fills the 4-byte length prefix at offset with the number of bytes appended after it.
+static void patch_length_prefix(size_t offset, std::string &out)
+{
+    uint32_t be = htonl(static_cast<uint32_t>(out.size() - offset - 4));
+    std::memcpy(out.data() + offset, &be, 4);
+}
+
+// Serializes straight into out (no per-message body or frame string); out is the caller's reused batch buffer.
+void append_server_frame(const t2d::ServerMessage &msg, uint32_t frame_version, std::string &out)
+{
+    const size_t offset = out.size();
+    out.append(4, '\0');
+    const bool typed = frame_version >= t2d::netutil::FRAME_VERSION;
+    t2d::netutil::FrameHeader h;
+    h.type = t2d::netutil::FrameType::ServerMessage;
+    if (typed)
+        t2d::netutil::append_frame_header(h, out);
+    const size_t body_at = out.size();
+    if (!msg.AppendToString(&out)) {
+        out.resize(offset);
+        return;
+    }
+    const size_t body_len = out.size() - body_at;
+    if (typed && body_len >= t2d::netutil::FRAME_COMPRESS_MIN_BYTES) {
+        // Encode into a per-thread scratch buffer and swap it in for the body only when it is smaller.
+        thread_local std::string rle;
+        rle.clear();
+        t2d::compress::rle_compress_append(out.data() + body_at, body_len, rle);
+        if (rle.size() < body_len) {
+            out.resize(offset + 4);
+            h.flags = t2d::netutil::FRAME_FLAG_COMPRESSED;
+            h.codec = t2d::netutil::FrameCodec::Rle;
+            t2d::netutil::append_frame_header(h, out);
+            out.append(rle);
+            count_compressed(body_len, out.size() - offset);
+        }
+    }
+    patch_length_prefix(offset, out);
+}
+
+void append_server_frame(const t2d::mm::OutboundMessage &m, uint32_t frame_version, std::string &out)
+{
+    if (!m.shared) {
+        append_server_frame(m.msg, frame_version, out);
+        return;
+    }
+    const auto &enc = *m.shared;
+    const bool state = t2d::mm::outbound_lane(enc.msg) == t2d::mm::OutboundLane::State;
+    t2d::metrics::runtime().fanout_frames.fetch_add(1, std::memory_order_relaxed);
+    if (frame_version >= t2d::netutil::FRAME_VERSION) {
+        if (static_cast<uint8_t>(enc.typed[5]) & t2d::netutil::FRAME_FLAG_COMPRESSED)
+            count_compressed(enc.body.size(), enc.typed.size());
+        out.append(enc.typed);
+        if (!state)
+            return;
+        // The shared frame of a snapshot carries FRAME_FLAG_MORE; this final fragment (possibly empty) ends it.
+        const size_t tail = out.size();
+        out.append(4, '\0');
+        t2d::netutil::FrameHeader h;
+        h.type = t2d::netutil::FrameType::ServerMessage;
+        t2d::netutil::append_frame_header(h, out);
+        if (m.last_input_tick != 0)
+            t2d::mm::append_last_input_tick(enc.msg, m.last_input_tick, out);
+        patch_length_prefix(tail, out);
+        return;
+    }
+    // Legacy: the stamp is a protobuf suffix that merges last_input_tick into the snapshot when parsed.
+    const size_t offset = out.size();
+    out.append(4, '\0');
+    out.append(enc.body);
+    if (state && m.last_input_tick != 0)
+        t2d::mm::append_last_input_tick(enc.msg, m.last_input_tick, out);
+    patch_length_prefix(offset, out);
+}
+
+// Heartbeat handling shared by the typed fast path and the ClientMessage path. The response is written straight into
+// the immediate replies (not the per-tick outbound queue) so server_send_us (t3) is close to the actual send and the
+// client's RTT / offset estimate does not absorb up to one flush interval of queueing.
+static void handle_heartbeat(
+    const std::shared_ptr<t2d::mm::Session> &session,
+    const t2d::Heartbeat &in,
+    std::chrono::steady_clock::time_point received,
+    uint32_t frame_version,
+    std::string &replies)
+{
+    t2d::mm::instance().update_heartbeat(session, in);
+    t2d::ServerMessage hb;
+    auto *hbr = hb.mutable_heartbeat_resp();
+    hbr->set_session_id(session->session_id);
+    hbr->set_client_time_ms(in.time_ms());
+    hbr->set_server_time_ms(t2d::netutil::steady_us(received) / 1000);
+    hbr->set_client_send_us(in.client_send_us());
+    hbr->set_server_recv_us(t2d::netutil::steady_us(received));
+    hbr->set_server_send_us(t2d::netutil::steady_us());
+    append_server_frame(hb, frame_version, replies);
+}
+
+// Counts a throttled message by class (metrics only; the message itself is dropped by the caller).
+static void count_throttled(MsgClass c)
+{
+    auto &rt = t2d::metrics::runtime();
+    switch (c) {
+        case MsgClass::Input:
+            rt.inbound_throttled_input.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case MsgClass::Heartbeat:
+            rt.inbound_throttled_heartbeat.fetch_add(1, std::memory_order_relaxed);
+            break;
+        default:
+            rt.inbound_throttled_control.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+}
+
+Connection::Connection(std::shared_ptr<t2d::mm::Session> session, const RateLimits &limits)
+    : m_session(std::move(session)), m_limiter(limits, std::chrono::steady_clock::now())
+{}
+
+bool Connection::on_bytes(const char *data, size_t len, std::string &replies)
+{
+    m_fps.buffer.insert(m_fps.buffer.end(), data, data + len);
+    auto now = std::chrono::steady_clock::now(); // one clock read per chunk for the rate limiter
+    while (t2d::netutil::try_extract(m_fps, m_payload)) {
+        if (!dispatch(m_payload, now, replies))
+            return false;
+    }
+    return true;
+}
+
+void Connection::drain_outbound(std::string &out)
+{
+    m_pending.clear();
+    t2d::mm::instance().drain_messages(m_session, m_pending);
+    for (const auto &m : m_pending)
+        append_server_frame(m, m_frame_version, out);
+    m_pending.clear(); // drop the shared encodings now rather than at the next flush
+}
+
+bool Connection::dispatch(const std::string &payload, std::chrono::steady_clock::time_point now, std::string &replies)
+{
+    const auto &session = m_session;
+    // Flood protection before decompression, fragment reassembly or any protobuf parse: class from the raw header /
+    // first tag byte, charged at the wire size. A fragment cannot be dropped without corrupting its message, so a
+    // throttled fragment closes the connection.
+    const auto pc = classify_payload(payload.data(), payload.size(), m_decoder.in_fragment);
+    const auto mclass = pc.cls;
+    auto verdict = m_limiter.check(mclass, payload.size(), now);
+    if (verdict == RateVerdict::Throttle) {
+        count_throttled(mclass);
+        if (!pc.fragment)
+            return true;
+        verdict = RateVerdict::Disconnect;
+    }
+    if (verdict == RateVerdict::Disconnect) {
+        t2d::metrics::runtime().inbound_flood_disconnects.fetch_add(1, std::memory_order_relaxed);
+        t2d::log::warn(
+            "[conn] Inbound flood / oversized frame class={} bytes={}, dropping connection",
+            static_cast<int>(mclass),
+            payload.size());
+        return false;
+    }
+    t2d::netutil::FrameType ftype{};
+    const char *body = nullptr;
+    size_t body_len = 0;
+    const uint32_t cap = m_limiter.limits().max_bytes(mclass);
+    auto fstat = m_decoder.decode(
+        payload.data(),
+        payload.size(),
+        ftype,
+        body,
+        body_len,
+        cap != 0 ? cap : t2d::netutil::FRAME_MAX_MESSAGE_BYTES);
+    if (fstat == t2d::netutil::FrameStatus::Partial)
+        return true;
+    if (fstat == t2d::netutil::FrameStatus::Error) {
+        t2d::log::warn("[conn] Malformed or oversized frame, dropping connection");
+        return false;
+    }
+    // Typed fast paths: routed by the frame header without parsing a ClientMessage.
+    if (ftype == t2d::netutil::FrameType::InputCompact) {
+        t2d::netutil::CompactInput ci;
+        if (!m_compact_input || !t2d::netutil::decode_compact_input(body, body_len, ci)) {
+            t2d::log::warn("[conn] Malformed or unnegotiated compact frame, dropping connection");
+            return false;
+        }
+        auto &rt = t2d::metrics::runtime();
+        rt.input_frames_compact.fetch_add(1, std::memory_order_relaxed);
+        rt.input_bytes.fetch_add(4 + payload.size(), std::memory_order_relaxed);
+        if (session->authenticated) {
+            t2d::mm::Session::InputState in;
+            in.last_client_tick = ci.client_tick;
+            in.move_dir = ci.move_dir;
+            in.turn_dir = ci.turn_dir;
+            in.turret_turn = ci.turret_turn;
+            in.fire = ci.fire;
+            in.brake = ci.brake;
+            t2d::mm::instance().update_input(session, in);
+        }
+        return true;
+    }
+    if (ftype == t2d::netutil::FrameType::Input) {
+        t2d::InputCommand ic;
+        if (!ic.ParseFromArray(body, (int)body_len)) {
+            t2d::log::warn("[conn] Failed to parse InputCommand frame, dropping connection");
+            return false;
+        }
+        auto &rt = t2d::metrics::runtime();
+        rt.input_frames_proto.fetch_add(1, std::memory_order_relaxed);
+        rt.input_bytes.fetch_add(4 + payload.size(), std::memory_order_relaxed);
+        if (session->authenticated)
+            t2d::mm::instance().update_input(session, ic);
+        return true;
+    }
+    if (ftype == t2d::netutil::FrameType::Heartbeat) {
+        t2d::Heartbeat hb;
+        if (!hb.ParseFromArray(body, (int)body_len)) {
+            t2d::log::warn("[conn] Failed to parse Heartbeat frame, dropping connection");
+            return false;
+        }
+        handle_heartbeat(session, hb, now, m_frame_version, replies);
+        return true;
+    }
+    if (ftype != t2d::netutil::FrameType::Legacy && ftype != t2d::netutil::FrameType::ClientMessage) {
+        t2d::log::debug("[conn] Ignoring frame type={}", static_cast<int>(ftype));
+        return true; // unknown / server-only type: forward compatible
+    }
+    t2d::ClientMessage cmsg;
+    if (!cmsg.ParseFromArray(body, (int)body_len)) {
+        t2d::log::warn("[conn] Failed to parse protobuf, dropping connection");
+        return false;
+    }
+    t2d::ServerMessage smsg;
+    if (cmsg.has_auth_request()) {
+        const auto &ar = cmsg.auth_request();
+        auto *resp = smsg.mutable_auth_response();
+        auto *prov = t2d::auth::provider();
+        t2d::auth::AuthResult r;
+        if (prov)
+            r = prov->validate(ar.oauth_token());
+        else {
+            r.ok = true;
+            r.user_id = "anon";
+        }
+        if (!r.ok) {
+            resp->set_success(false);
+            resp->set_reason(r.reason.empty() ? "auth_failed" : r.reason);
+            t2d::metrics::runtime().auth_failures.fetch_add(1, std::memory_order_relaxed);
+            t2d::log::warn("[conn] AuthRequest failed reason={}", resp->reason());
+        } else {
+            resp->set_success(true);
+            resp->set_session_id(r.user_id);
+            resp->set_reason("");
+            m_compact_input = ar.compact_input();
+            resp->set_compact_input(m_compact_input);
+            m_frame_version = std::min<uint32_t>(ar.frame_version(), t2d::netutil::FRAME_VERSION);
+            resp->set_frame_version(m_frame_version);
+            t2d::mm::instance().authenticate(session, r.user_id);
+            t2d::log::info("[conn] AuthRequest -> success sid={} compact_input={}", r.user_id, m_compact_input);
+        }
+    } else if (cmsg.has_queue_join()) {
+        auto *qs = smsg.mutable_queue_status();
+        // Populate minimal queue status; refined periodic updates will be pushed by matchmaker loop in future.
+        qs->set_position(1);
+        qs->set_players_in_queue(1);
+        qs->set_needed_for_match(16);
+        qs->set_timeout_seconds_left(180);
+        qs->set_lobby_countdown(180);
+        qs->set_projected_bot_fill(15);
+        if (session->authenticated) {
+            t2d::mm::instance().enqueue(session);
+        }
+        t2d::log::info("[conn] QueueJoin received (enqueued={})", (session->authenticated ? "yes" : "no-auth"));
+    } else if (cmsg.has_heartbeat()) {
+        handle_heartbeat(session, cmsg.heartbeat(), now, m_frame_version, replies);
+        return true;
+    } else if (cmsg.has_input()) {
+        auto &rt = t2d::metrics::runtime();
+        rt.input_frames_proto.fetch_add(1, std::memory_order_relaxed);
+        rt.input_bytes.fetch_add(4 + payload.size(), std::memory_order_relaxed);
+        if (session->authenticated) {
+            t2d::mm::instance().update_input(session, cmsg.input());
+        }
+        return true; // no immediate ack
+    } else if (cmsg.has_keyframe_request()) {
+        if (session->authenticated) {
+            t2d::mm::instance().request_keyframe(session);
+            t2d::log::debug(
+                "[conn] KeyframeRequest session={} last_full={} last_tick={}",
+                session->session_id,
+                cmsg.keyframe_request().last_full_tick(),
+                cmsg.keyframe_request().last_server_tick());
+        }
+        return true; // answered by the match loop on its next snapshot tick
+    } else {
+        return true; // ignore others
+    }
+    size_t before = replies.size();
+    append_server_frame(smsg, m_frame_version, replies);
+    if (replies.size() == before) {
+        t2d::log::warn("[conn] Failed serialize server msg");
+        return true;
+    }
+    t2d::log::debug(
+        "[conn] Queued server message type={}",
+        (smsg.has_auth_response()      ? "AuthResponse"
+             : smsg.has_queue_status() ? "QueueStatus"
+             : smsg.has_match_start()  ? "MatchStart"
+                                       : "Other"));
+    return true;
+}
+
+} // namespace t2d::net
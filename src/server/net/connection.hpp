@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// connection.hpp - Transport-independent per-connection protocol state: frame extraction and decoding, inbound rate
+// limiting, auth negotiation and dispatch into the session manager. Shared by the libcoro (epoll) listener and the
+// optional io_uring backend so both speak exactly the same protocol.
+#pragma once
+#include "common/frame_header.hpp"
+#include "common/framing.hpp"
+#include "game.pb.h"
+#include "server/matchmaking/session_manager.hpp"
+#include "server/net/rate_limit.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace t2d::net {
+
+// Read poll timeout / flush period derived from tick_rate so outbound flush latency stays a fraction of a simulation
+// tick: half the tick interval, clamped to [5, 50] ms.
+inline uint32_t flush_interval_ms(uint32_t tick_rate)
+{
+    uint32_t tick_interval_ms = tick_rate > 0 ? (1000u / tick_rate) : 33u; // default ~30Hz
+    if (tick_interval_ms == 0)
+        tick_interval_ms = 1; // guard divide rounding when tick_rate > 1000
+    uint32_t desired_ms = tick_interval_ms / 2u;
+    if (desired_ms < 5u)
+        desired_ms = 5u; // lower clamp to avoid busy looping
+    if (desired_ms > 50u)
+        desired_ms = 50u; // upper clamp to keep latency reasonable
+    return desired_ms;
+}
+
+// Appends one length-prefixed ServerMessage frame to out: bare protobuf for legacy clients, typed header (plus RLE
+// when it shrinks the body) once the client negotiated frame_version >= 1.
+void append_server_frame(const t2d::ServerMessage &msg, uint32_t frame_version, std::string &out);
+// Same for a drained outbound entry. A shared fan-out encoding is copied as is, followed by the recipient's
+// last_input_tick stamp: as a final fragment for typed clients, appended to the bare body for legacy ones.
+void append_server_frame(const t2d::mm::OutboundMessage &m, uint32_t frame_version, std::string &out);
+
+// Not thread-safe; owned by the loop that performs the socket I/O for this connection.
+class Connection
+{
+public:
+    Connection(std::shared_ptr<t2d::mm::Session> session, const RateLimits &limits);
+
+    // Consumes bytes received from the socket, dispatches every complete frame and appends immediate replies
+    // (AuthResponse, QueueStatus, HeartbeatResponse) as frames to replies. Returns false when the connection must be
+    // closed (malformed frame, parse failure, flood).
+    bool on_bytes(const char *data, size_t len, std::string &replies);
+
+    // Appends every queued outbound message of the session to out: the control lane (match lifecycle, events) ahead
+    // of the state lane (snapshots, deltas). Callers reuse out across flushes, so a steady flush allocates nothing
+    // here once out and the drain buffer have grown.
+    void drain_outbound(std::string &out);
+
+    const std::shared_ptr<t2d::mm::Session> &session() const { return m_session; }
+
+private:
+    bool dispatch(const std::string &payload, std::chrono::steady_clock::time_point now, std::string &replies);
+
+    std::shared_ptr<t2d::mm::Session> m_session;
+    t2d::netutil::FrameParseState m_fps; // streaming frame parser state
+    t2d::netutil::FrameDecoder m_decoder; // strips frame headers, decompresses, reassembles fragments
+    ConnectionRateLimiter m_limiter;
+    std::string m_payload; // reused extraction buffer
+    std::vector<t2d::mm::OutboundMessage> m_pending; // reused drain buffer
+    bool m_compact_input{false}; // negotiated in AuthResponse
+    uint32_t m_frame_version{0}; // outbound header version (inbound frames are self-describing)
+};
+
+} // namespace t2d::net
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/net/frame_pool.hpp"
+
+#include "common/metrics.hpp"
+
+#include <new>
+
+namespace t2d::net {
+
+FramePool::~FramePool()
+{
+    for (auto *head : m_free) {
+        while (head) {
+            Node *next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+}
+
+void *FramePool::allocate(size_t n)
+{
+    auto &rt = t2d::metrics::runtime();
+    const size_t c = size_class(n);
+    if (c < kClasses && m_free[c]) {
+        Node *node = m_free[c];
+        m_free[c] = node->next;
+        --m_count[c];
+        rt.net_frame_pool_hits.fetch_add(1, std::memory_order_relaxed);
+        return node;
+    }
+    rt.net_frame_pool_misses.fetch_add(1, std::memory_order_relaxed);
+    // Round up to the class size so the block fits any frame of its class when it is reused.
+    return ::operator new(c < kClasses ? (c + 1) * kGranule : n);
+}
+
+void FramePool::deallocate(void *p, size_t n) noexcept
+{
+    const size_t c = size_class(n);
+    if (c >= kClasses || m_count[c] >= kMaxCached) {
+        ::operator delete(p);
+        return;
+    }
+    auto *node = static_cast<Node *>(p);
+    node->next = m_free[c];
+    m_free[c] = node;
+    ++m_count[c];
+}
+
+uint32_t FramePool::cached(size_t n) const
+{
+    const size_t c = size_class(n);
+    return c < kClasses ? m_count[c] : 0;
+}
+
+FramePool &frame_pool()
+{
+    thread_local FramePool pool;
+    return pool;
+}
+
+} // namespace t2d::net
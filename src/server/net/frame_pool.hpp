@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: Apache-2.0
+// frame_pool.hpp - pooled coroutine frames for the per-connection network helpers. send_all / send_all_tls run once
+// per flush per connection per tick; as coro::task coroutines every call heap-allocated a frame. PooledTask is a
+// minimal lazy task whose promise takes its frame from a thread-local, size-classed freelist (FramePool), so the
+// steady-state flush path reuses frames instead of allocating. It is awaited from coro::task code like any other
+// awaitable and resumes the awaiting coroutine by symmetric transfer when done.
+//
+// Frames may be released on another thread than the one that allocated them (the scheduler resumes on any worker);
+// the block then joins the releasing thread's freelist. Each class caches at most kMaxCached blocks per thread, the
+// rest go back to operator delete, so imbalanced threads cannot hoard memory.
+#pragma once
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+namespace t2d::net {
+
+class FramePool
+{
+public:
+    static constexpr size_t kGranule = 64; // size class step (bytes)
+    static constexpr size_t kClasses = 16; // frames up to kGranule * kClasses bytes are pooled
+    static constexpr uint32_t kMaxCached = 256; // per class and thread
+
+    FramePool() = default;
+    FramePool(const FramePool &) = delete;
+    FramePool &operator=(const FramePool &) = delete;
+    ~FramePool();
+
+    void *allocate(size_t n);
+    void deallocate(void *p, size_t n) noexcept;
+
+    uint32_t cached(size_t n) const;
+
+private:
+    struct Node
+    {
+        Node *next;
+    };
+    static size_t size_class(size_t n) { return (n + kGranule - 1) / kGranule - 1; }
+
+    std::array<Node *, kClasses> m_free{};
+    std::array<uint32_t, kClasses> m_count{};
+};
+
+// Pool of the calling thread.
+FramePool &frame_pool();
+
+class [[nodiscard]] PooledTask
+{
+public:
+    struct promise_type
+    {
+        std::coroutine_handle<> continuation{std::noop_coroutine()};
+        std::exception_ptr error;
+
+        static void *operator new(std::size_t n) { return frame_pool().allocate(n); }
+        static void operator delete(void *p, std::size_t n) noexcept { frame_pool().deallocate(p, n); }
+
+        PooledTask get_return_object() noexcept
+        {
+            return PooledTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+            {
+                return h.promise().continuation;
+            }
+            void await_resume() const noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    explicit PooledTask(std::coroutine_handle<promise_type> h) noexcept : m_handle(h) {}
+    PooledTask(PooledTask &&other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    PooledTask(const PooledTask &) = delete;
+    PooledTask &operator=(const PooledTask &) = delete;
+    PooledTask &operator=(PooledTask &&) = delete;
+    ~PooledTask()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_handle.promise().continuation = awaiting;
+        return m_handle;
+    }
+    void await_resume() const
+    {
+        if (m_handle && m_handle.promise().error)
+            std::rethrow_exception(m_handle.promise().error);
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+} // namespace t2d::net
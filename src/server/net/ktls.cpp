@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/net/ktls.hpp"
+
+#include "common/logger.hpp"
+
+#if T2D_HAS_TLS
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <cstdio>
+#endif
+
+namespace t2d::net {
+
+#if T2D_HAS_TLS
+
+static std::string last_ssl_error()
+{
+    char buf[256];
+    unsigned long e = ERR_get_error();
+    if (e == 0)
+        return "unknown";
+    ERR_error_string_n(e, buf, sizeof(buf));
+    ERR_clear_error();
+    return buf;
+}
+
+bool tls_available()
+{
+    return true;
+}
+
+bool write_self_signed_cert(const std::string &cert_path, const std::string &key_path)
+{
+    EVP_PKEY *pkey = EVP_EC_gen("P-256");
+    X509 *x = X509_new();
+    bool ok = pkey && x;
+    if (ok) {
+        X509_set_version(x, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(x), 1);
+        X509_gmtime_adj(X509_getm_notBefore(x), 0);
+        X509_gmtime_adj(X509_getm_notAfter(x), 365L * 24 * 3600);
+        X509_set_pubkey(x, pkey);
+        X509_NAME *name = X509_get_subject_name(x);
+        const auto *cn = reinterpret_cast<const unsigned char *>("localhost");
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, cn, -1, -1, 0);
+        X509_set_issuer_name(x, name);
+        ok = X509_sign(x, pkey, EVP_sha256()) > 0;
+    }
+    if (ok) {
+        FILE *cf = std::fopen(cert_path.c_str(), "wb");
+        FILE *kf = std::fopen(key_path.c_str(), "wb");
+        ok = cf && kf && PEM_write_X509(cf, x) == 1
+            && PEM_write_PrivateKey(kf, pkey, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+        if (cf)
+            std::fclose(cf);
+        if (kf)
+            std::fclose(kf);
+    }
+    X509_free(x);
+    EVP_PKEY_free(pkey);
+    return ok;
+}
+
+std::shared_ptr<TlsContext> TlsContext::create(const TlsConfig &cfg)
+{
+    std::shared_ptr<TlsContext> ctx(new TlsContext());
+    ctx->m_require_ktls = cfg.require_ktls;
+    ctx->m_ctx = SSL_CTX_new(TLS_server_method());
+    if (!ctx->m_ctx) {
+        t2d::log::error("[tls] SSL_CTX_new failed: {}", last_ssl_error());
+        return nullptr;
+    }
+    SSL_CTX *c = ctx->m_ctx;
+    SSL_CTX_set_min_proto_version(c, TLS1_2_VERSION);
+    // Only AEAD suites the kernel TLS module implements, so offload is never refused because of the cipher.
+    SSL_CTX_set_ciphersuites(c, "TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256");
+    SSL_CTX_set_cipher_list(c, "ECDHE+AESGCM:ECDHE+CHACHA20");
+    // No post-handshake NewSessionTicket records: once the kernel owns the socket every record must be app data.
+    SSL_CTX_set_num_tickets(c, 0);
+    SSL_CTX_set_mode(c, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+#ifdef SSL_OP_ENABLE_KTLS
+    if (cfg.offer_ktls)
+        SSL_CTX_set_options(c, SSL_OP_ENABLE_KTLS);
+#endif
+    if (SSL_CTX_use_certificate_chain_file(c, cfg.cert_path.c_str()) != 1
+        || SSL_CTX_use_PrivateKey_file(c, cfg.key_path.c_str(), SSL_FILETYPE_PEM) != 1
+        || SSL_CTX_check_private_key(c) != 1) {
+        t2d::log::error(
+            "[tls] cannot load cert '{}' / key '{}': {}", cfg.cert_path, cfg.key_path, last_ssl_error());
+        return nullptr;
+    }
+    return ctx;
+}
+
+TlsContext::~TlsContext()
+{
+    SSL_CTX_free(m_ctx);
+}
+
+TlsStream::TlsStream(const TlsContext &ctx, int fd)
+    : m_ssl(SSL_new(ctx.native()))
+{
+    if (m_ssl) {
+        SSL_set_fd(m_ssl, fd); // socket BIO with BIO_NOCLOSE: the fd outlives the stream
+        SSL_set_accept_state(m_ssl);
+    }
+}
+
+TlsStream::~TlsStream()
+{
+    SSL_free(m_ssl);
+}
+
+static TlsStatus map_ssl_result(SSL *ssl, int rc)
+{
+    switch (SSL_get_error(ssl, rc)) {
+        case SSL_ERROR_WANT_READ:
+            return TlsStatus::WantRead;
+        case SSL_ERROR_WANT_WRITE:
+            return TlsStatus::WantWrite;
+        case SSL_ERROR_ZERO_RETURN:
+            return TlsStatus::Closed;
+        default:
+            ERR_clear_error();
+            return TlsStatus::Error;
+    }
+}
+
+TlsStatus TlsStream::handshake()
+{
+    if (!m_ssl)
+        return TlsStatus::Error;
+    int rc = SSL_do_handshake(m_ssl);
+    return rc == 1 ? TlsStatus::Ok : map_ssl_result(m_ssl, rc);
+}
+
+bool TlsStream::ktls_send() const
+{
+#ifndef OPENSSL_NO_KTLS
+    return m_ssl && BIO_get_ktls_send(SSL_get_wbio(m_ssl)) > 0;
+#else
+    return false;
+#endif
+}
+
+bool TlsStream::ktls_recv() const
+{
+#ifndef OPENSSL_NO_KTLS
+    return m_ssl && BIO_get_ktls_recv(SSL_get_rbio(m_ssl)) > 0;
+#else
+    return false;
+#endif
+}
+
+TlsStatus TlsStream::read(char *buf, size_t cap, size_t &n)
+{
+    n = 0;
+    int rc = SSL_read_ex(m_ssl, buf, cap, &n);
+    return rc == 1 ? TlsStatus::Ok : map_ssl_result(m_ssl, rc);
+}
+
+TlsStatus TlsStream::write(const char *buf, size_t len, size_t &n)
+{
+    n = 0;
+    int rc = SSL_write_ex(m_ssl, buf, len, &n);
+    return rc == 1 ? TlsStatus::Ok : map_ssl_result(m_ssl, rc);
+}
+
+bool TlsStream::pending() const
+{
+    return m_ssl && SSL_pending(m_ssl) > 0;
+}
+
+std::string TlsStream::describe() const
+{
+    if (!m_ssl)
+        return "none";
+    return std::string(SSL_get_version(m_ssl)) + " " + SSL_get_cipher_name(m_ssl);
+}
+
+#else // !T2D_HAS_TLS
+
+bool tls_available()
+{
+    return false;
+}
+
+bool write_self_signed_cert(const std::string &, const std::string &)
+{
+    return false;
+}
+
+std::shared_ptr<TlsContext> TlsContext::create(const TlsConfig &)
+{
+    return nullptr; // built without OpenSSL (T2D_ENABLE_TLS=OFF); the caller refuses to start
+}
+
+TlsContext::~TlsContext() = default;
+
+TlsStream::TlsStream(const TlsContext &, int) {}
+
+TlsStream::~TlsStream() = default;
+
+TlsStatus TlsStream::handshake()
+{
+    return TlsStatus::Error;
+}
+
+bool TlsStream::ktls_send() const
+{
+    return false;
+}
+
+bool TlsStream::ktls_recv() const
+{
+    return false;
+}
+
+TlsStatus TlsStream::read(char *, size_t, size_t &n)
+{
+    n = 0;
+    return TlsStatus::Error;
+}
+
+TlsStatus TlsStream::write(const char *, size_t, size_t &n)
+{
+    n = 0;
+    return TlsStatus::Error;
+}
+
+bool TlsStream::pending() const
+{
+    return false;
+}
+
+std::string TlsStream::describe() const
+{
+    return "none";
+}
+
+#endif
+
+} // namespace t2d::net
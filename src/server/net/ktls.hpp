@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+// ktls.hpp - Optional TLS for client connections (build with -DT2D_ENABLE_TLS=ON, needs OpenSSL 3). The handshake
+// runs in userspace (OpenSSL); afterwards the record layer is handed to kernel TLS (SOL_TLS / TCP_ULP "tls") so the
+// connection loop keeps sending its batched frames with plain send() on the socket and crypto stays out of the
+// event loop. When the kernel cannot take a direction (tls module missing, unsupported cipher) that direction falls
+// back to SSL_read / SSL_write unless require_ktls is set.
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+
+struct ssl_st;
+struct ssl_ctx_st;
+
+namespace t2d::net {
+
+struct TlsConfig
+{
+    bool enabled{false};
+    std::string cert_path; // PEM certificate (chain)
+    std::string key_path; // PEM private key
+    bool require_ktls{false}; // close connections whose record layer could not be offloaded in both directions
+    bool offer_ktls{true}; // false = pure userspace TLS (benchmark baseline)
+};
+
+// True when the binary was built with OpenSSL (T2D_HAS_TLS).
+bool tls_available();
+
+// Writes a self-signed P-256 certificate for CN=localhost and its key (PEM) for local testing and benchmarks.
+bool write_self_signed_cert(const std::string &cert_path, const std::string &key_path);
+
+class TlsContext
+{
+public:
+    // Loads certificate and key; returns nullptr on failure (after logging why) or when built without OpenSSL.
+    static std::shared_ptr<TlsContext> create(const TlsConfig &cfg);
+    ~TlsContext();
+    TlsContext(const TlsContext &) = delete;
+    TlsContext &operator=(const TlsContext &) = delete;
+
+    bool require_ktls() const { return m_require_ktls; }
+
+    ssl_ctx_st *native() const { return m_ctx; }
+
+private:
+    TlsContext() = default;
+    ssl_ctx_st *m_ctx{nullptr};
+    bool m_require_ktls{false};
+};
+
+enum class TlsStatus
+{
+    Ok,
+    WantRead, // poll for readability, then retry
+    WantWrite, // poll for writability, then retry
+    Closed, // peer sent close_notify / EOF
+    Error
+};
+
+// Server side of one TLS connection on a non-blocking socket. The fd stays owned by the caller; destroying the
+// stream after the handshake keeps the kernel TLS state on the socket.
+class TlsStream
+{
+public:
+    TlsStream(const TlsContext &ctx, int fd);
+    ~TlsStream();
+    TlsStream(const TlsStream &) = delete;
+    TlsStream &operator=(const TlsStream &) = delete;
+
+    TlsStatus handshake();
+
+    // Record layer offloaded to the kernel for this direction (valid after the handshake): plain send / recv on the
+    // socket are encrypted / decrypted transparently.
+    bool ktls_send() const;
+    bool ktls_recv() const;
+
+    // Userspace record layer (directions that were not offloaded). n = bytes transferred when Ok.
+    TlsStatus read(char *buf, size_t cap, size_t &n);
+    TlsStatus write(const char *buf, size_t len, size_t &n);
+
+    // Decrypted bytes already buffered inside OpenSSL (read without waiting for the socket).
+    bool pending() const;
+
+    // Negotiated protocol / cipher for logs.
+    std::string describe() const;
+
+private:
+    ssl_st *m_ssl{nullptr};
+};
+
+} // namespace t2d::net
@@ -1,41 +1,52 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "server/net/listener.hpp"
 
-#include "common/framing.hpp"
 #include "common/logger.hpp"
 #include "common/metrics.hpp"
-#include "game.pb.h"
-#include "server/auth/auth_provider.hpp"
 #include "server/matchmaking/session_manager.hpp"
+#include "server/net/connection.hpp"
+#include "server/net/frame_pool.hpp"
 
-#include <arpa/inet.h>
 #include <coro/coro.hpp>
 #include <coro/net/tcp/client.hpp>
 #include <coro/net/tcp/server.hpp>
 #include <coro/poll.hpp>
 
-#include <iostream>
+#include <chrono>
+#include <memory>
 #include <string>
-#include <vector>
 
 namespace t2d::net {
 
 // Forward declarations of per-connection coroutine (tick_rate used to derive read poll timeout).
 static coro::task<void> connection_loop(
-    std::shared_ptr<coro::io_scheduler> scheduler, std::shared_ptr<t2d::mm::Session> session, uint32_t tick_rate);
+    std::shared_ptr<coro::io_scheduler> scheduler,
+    std::shared_ptr<t2d::mm::Session> session,
+    uint32_t tick_rate,
+    RateLimits limits,
+    bool cork_flush,
+    std::shared_ptr<TlsContext> tls_ctx);
 
-coro::task<void> run_listener(std::shared_ptr<coro::io_scheduler> scheduler, uint16_t port, uint32_t tick_rate)
+coro::task<void> run_listener(
+    std::shared_ptr<coro::io_scheduler> scheduler,
+    uint16_t port,
+    uint32_t tick_rate,
+    RateLimits limits,
+    SocketProfile socket,
+    std::shared_ptr<TlsContext> tls)
 {
     co_await scheduler->schedule();
-    t2d::log::info("[listener] Starting TCP listener on port {}", port);
+    t2d::log::info("[listener] Starting {} listener on port {}", tls ? "TLS" : "TCP", port);
     coro::net::tcp::server server{scheduler, coro::net::tcp::server::options{.port = port}};
     while (true) {
         auto status = co_await server.poll();
         if (status == coro::poll_status::event) {
             auto client = server.accept();
             if (client.socket().is_valid()) {
+                if (int failed = apply_socket_profile(client.socket().native_handle(), socket); failed > 0)
+                    t2d::log::debug("[listener] {} socket option(s) rejected by the kernel", failed);
                 auto session = t2d::mm::instance().add_connection(std::move(client));
-                scheduler->spawn(connection_loop(scheduler, session, tick_rate));
+                scheduler->spawn(connection_loop(scheduler, session, tick_rate, limits, socket.cork_flush, tls));
             }
         } else if (status == coro::poll_status::error || status == coro::poll_status::closed) {
             t2d::log::error("[listener] Poll error/closed, exiting listener loop");
@@ -47,8 +58,8 @@ coro::task<void> run_listener(std::shared_ptr<coro::io_scheduler> scheduler, uin
 // Helper: read exactly n bytes into buffer (append), returns false on closed/error.
 // Removed read_exact; replaced by streaming parser approach below.
 
-// Helper: send all bytes of buffer.
-static coro::task<void> send_all(coro::net::tcp::client &client, std::span<const char> data)
+// Helper: send all bytes of buffer. Runs once per flush: frame from the thread-local pool (frame_pool.hpp).
+static PooledTask send_all(coro::net::tcp::client &client, std::span<const char> data)
 {
     std::span<const char> rest = data;
     while (!rest.empty()) {
@@ -63,50 +74,143 @@ static coro::task<void> send_all(coro::net::tcp::client &client, std::span<const
     }
 }
 
+// Helper: send all bytes through the userspace TLS record layer (direction not offloaded to the kernel).
+static PooledTask send_all_tls(coro::net::tcp::client &client, TlsStream &tls, std::span<const char> data)
+{
+    size_t off = 0;
+    while (off < data.size()) {
+        size_t n = 0;
+        auto st = tls.write(data.data() + off, data.size() - off, n);
+        if (st == TlsStatus::Ok) {
+            off += n;
+        } else if (st == TlsStatus::WantWrite) {
+            co_await client.poll(coro::poll_op::write);
+        } else if (st == TlsStatus::WantRead) {
+            co_await client.poll(coro::poll_op::read);
+        } else {
+            co_return; // abort on other errors
+        }
+    }
+}
+
+// Drives the server handshake on the non-blocking socket; false on failure or when it does not finish in time.
+static coro::task<bool> tls_handshake(coro::net::tcp::client &client, TlsStream &tls)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto st = tls.handshake();
+        if (st == TlsStatus::Ok)
+            co_return true;
+        if (st == TlsStatus::WantRead)
+            co_await client.poll(coro::poll_op::read, std::chrono::milliseconds(100));
+        else if (st == TlsStatus::WantWrite)
+            co_await client.poll(coro::poll_op::write, std::chrono::milliseconds(100));
+        else
+            co_return false;
+    }
+    co_return false;
+}
+
 static coro::task<void> connection_loop(
-    std::shared_ptr<coro::io_scheduler> scheduler, std::shared_ptr<t2d::mm::Session> session, uint32_t tick_rate)
+    std::shared_ptr<coro::io_scheduler> scheduler,
+    std::shared_ptr<t2d::mm::Session> session,
+    uint32_t tick_rate,
+    RateLimits limits,
+    bool cork_flush,
+    std::shared_ptr<TlsContext> tls_ctx)
 {
     co_await scheduler->schedule();
     t2d::log::info("[conn] New connection");
-    t2d::netutil::FrameParseState fps; // streaming frame parser state
+    // Whatever ends the loop (peer close, read error, TLS failure), the player is gone: a match sees the drop on its
+    // next tick instead of after the heartbeat timeout.
+    struct DisconnectOnExit
+    {
+        std::shared_ptr<t2d::mm::Session> session;
+        ~DisconnectOnExit() { t2d::mm::instance().disconnect_session(session); }
+    } disconnect_on_exit{session};
+    // TLS: userspace handshake, then the kernel owns the record layer where it can. Offloaded directions use the
+    // plain socket path below unchanged; only directions left in userspace go through tls_rx / tls_tx.
+    std::unique_ptr<TlsStream> tls;
+    TlsStream *tls_rx = nullptr;
+    TlsStream *tls_tx = nullptr;
+    if (tls_ctx && session->client) {
+        auto &rt = t2d::metrics::runtime();
+        tls = std::make_unique<TlsStream>(*tls_ctx, session->client->socket().native_handle());
+        if (!co_await tls_handshake(*session->client, *tls)) {
+            rt.tls_handshake_failures.fetch_add(1, std::memory_order_relaxed);
+            t2d::log::warn("[conn] TLS handshake failed");
+            co_return;
+        }
+        rt.tls_handshakes.fetch_add(1, std::memory_order_relaxed);
+        const bool offloaded = tls->ktls_send() && tls->ktls_recv();
+        if (!offloaded && tls_ctx->require_ktls()) {
+            t2d::log::warn("[conn] kernel TLS unavailable ({}), closing (tls_require_ktls)", tls->describe());
+            co_return;
+        }
+        (offloaded ? rt.tls_ktls_offloaded : rt.tls_userspace).fetch_add(1, std::memory_order_relaxed);
+        t2d::log::debug(
+            "[conn] TLS {} ktls tx={} rx={}", tls->describe(), tls->ktls_send() ? 1 : 0, tls->ktls_recv() ? 1 : 0);
+        if (!tls->ktls_recv())
+            tls_rx = tls.get();
+        if (!tls->ktls_send())
+            tls_tx = tls.get();
+        if (offloaded)
+            tls.reset(); // the kernel keeps the crypto state on the socket
+    }
+    auto send_out = [&](std::span<const char> data) -> PooledTask {
+        if (tls_tx)
+            return send_all_tls(*session->client, *tls_tx, data);
+        return send_all(*session->client, data);
+    };
+    Connection conn(session, limits);
+    const uint32_t desired_ms = flush_interval_ms(tick_rate);
+    std::string out; // outbound batch (queued messages + direct replies), reused across iterations
+    std::string tmp(1024, '\0'); // recv chunk, reused for the life of the connection
     while (true) {
         // Flush pending outbound first (if any)
-        auto pending = t2d::mm::instance().drain_messages(session);
-        if (!pending.empty()) {
-            std::string batch;
-            batch.reserve(pending.size() * 64); // heuristic
-            for (auto &msg : pending) {
-                std::string out;
-                if (!msg.SerializeToString(&out))
-                    continue;
-                uint32_t out_len = htonl(static_cast<uint32_t>(out.size()));
-                size_t offset = batch.size();
-                batch.resize(offset + 4 + out.size());
-                std::memcpy(batch.data() + offset, &out_len, 4);
-                std::memcpy(batch.data() + offset + 4, out.data(), out.size());
-            }
-            if (session->client)
-                co_await send_all(*session->client, std::span<const char>(batch.data(), batch.size()));
+        out.clear();
+        conn.drain_outbound(out);
+        if (!out.empty() && session->client) {
+            // Corked flush: this tick's events and snapshot leave as full segments even if send_all needs several
+            // writes; uncork pushes the tail immediately.
+            int fd = session->client->socket().native_handle();
+            if (cork_flush)
+                set_cork(fd, true);
+            co_await send_out(std::span<const char>(out.data(), out.size()));
+            if (cork_flush)
+                set_cork(fd, false);
         }
         // Poll read with small timeout so loop progresses to flush snapshots
         if (!session->client)
             co_return; // bot session should never be here
-        // Derive adaptive read poll timeout from tick_rate so outbound flush latency
-        // stays a fraction of simulation tick. Use half the tick interval, clamped.
-        uint32_t tick_interval_ms = tick_rate > 0 ? (1000u / tick_rate) : 33u; // default ~30Hz
-        if (tick_interval_ms == 0)
-            tick_interval_ms = 1; // guard divide rounding when tick_rate > 1000
-        uint32_t desired_ms = tick_interval_ms / 2u;
-        if (desired_ms < 5u)
-            desired_ms = 5u; // lower clamp to avoid busy looping
-        if (desired_ms > 50u)
-            desired_ms = 50u; // upper clamp to keep latency reasonable
-        auto pstat = co_await session->client->poll(coro::poll_op::read, std::chrono::milliseconds(desired_ms));
-        if (pstat == coro::poll_status::timeout) {
+        // Records already decrypted inside OpenSSL do not make the socket readable; consume them first.
+        if (!(tls_rx && tls_rx->pending())) {
+            auto pstat = co_await session->client->poll(coro::poll_op::read, std::chrono::milliseconds(desired_ms));
+            if (pstat == coro::poll_status::timeout) {
+                continue;
+            }
+        }
+        if (tls_rx) {
+            size_t n = 0;
+            auto st = tls_rx->read(tmp.data(), tmp.size(), n);
+            if (st == TlsStatus::Closed) {
+                t2d::log::info("[conn] Closed by peer");
+                co_return;
+            }
+            if (st == TlsStatus::Error) {
+                t2d::log::warn("[conn] TLS read error");
+                co_return;
+            }
+            if (st != TlsStatus::Ok)
+                continue;
+            out.clear();
+            if (!conn.on_bytes(tmp.data(), n, out))
+                co_return;
+            if (!out.empty())
+                co_await send_out(std::span<const char>(out.data(), out.size()));
             continue;
         }
         // Read available chunk
-        std::string tmp(1024, '\0');
         auto [rstatus, span] = session->client->recv(tmp);
         if (rstatus == coro::net::recv_status::closed) {
             t2d::log::info("[conn] Closed by peer");
@@ -116,97 +220,15 @@ static coro::task<void> connection_loop(
             t2d::log::warn("[conn] recv error");
             co_return;
         }
-        if (rstatus == coro::net::recv_status::ok) {
-            fps.buffer.insert(fps.buffer.end(), span.begin(), span.end());
-        }
-        std::string payload;
-        while (t2d::netutil::try_extract(fps, payload)) {
-            t2d::ClientMessage cmsg;
-            if (!cmsg.ParseFromArray(payload.data(), (int)payload.size())) {
-                t2d::log::warn("[conn] Failed to parse protobuf, dropping connection");
-                co_return;
-            }
-            t2d::ServerMessage smsg;
-            if (cmsg.has_auth_request()) {
-                const auto &ar = cmsg.auth_request();
-                auto *resp = smsg.mutable_auth_response();
-                auto *prov = t2d::auth::provider();
-                t2d::auth::AuthResult r;
-                if (prov)
-                    r = prov->validate(ar.oauth_token());
-                else {
-                    r.ok = true;
-                    r.user_id = "anon";
-                }
-                if (!r.ok) {
-                    resp->set_success(false);
-                    resp->set_reason(r.reason.empty() ? "auth_failed" : r.reason);
-                    t2d::metrics::runtime().auth_failures.fetch_add(1, std::memory_order_relaxed);
-                    t2d::log::warn("[conn] AuthRequest failed reason={}", resp->reason());
-                } else {
-                    resp->set_success(true);
-                    resp->set_session_id(r.user_id);
-                    resp->set_reason("");
-                    t2d::mm::instance().authenticate(session, r.user_id);
-                    t2d::log::info("[conn] AuthRequest -> success sid={}", r.user_id);
-                }
-            } else if (cmsg.has_queue_join()) {
-                auto *qs = smsg.mutable_queue_status();
-                // Populate minimal queue status; refined periodic updates will be pushed by matchmaker loop in future.
-                qs->set_position(1);
-                qs->set_players_in_queue(1);
-                qs->set_needed_for_match(16);
-                qs->set_timeout_seconds_left(180);
-                qs->set_lobby_countdown(180);
-                qs->set_projected_bot_fill(15);
-                if (session->authenticated) {
-                    t2d::mm::instance().enqueue(session);
-                }
-                t2d::log::info("[conn] QueueJoin received (enqueued={})", (session->authenticated ? "yes" : "no-auth"));
-            } else if (cmsg.has_heartbeat()) {
-                t2d::mm::instance().update_heartbeat(session);
-                auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                  std::chrono::steady_clock::now().time_since_epoch())
-                                  .count();
-                t2d::ServerMessage hb;
-                auto *hbr = hb.mutable_heartbeat_resp();
-                hbr->set_session_id(session->session_id);
-                hbr->set_client_time_ms(cmsg.heartbeat().time_ms());
-                hbr->set_server_time_ms(now_ms);
-                auto client_ms = static_cast<int64_t>(cmsg.heartbeat().time_ms());
-                int64_t diff = static_cast<int64_t>(now_ms) - client_ms;
-                if (diff < 0)
-                    diff = 0;
-                hbr->set_delta_ms(static_cast<uint64_t>(diff));
-                t2d::mm::instance().push_message(session, hb);
-                continue;
-            } else if (cmsg.has_input()) {
-                if (session->authenticated) {
-                    t2d::mm::instance().update_input(session, cmsg.input());
-                }
-                continue; // no immediate ack
-            } else {
-                continue; // ignore others
-            }
-            std::string out;
-            if (!smsg.SerializeToString(&out)) {
-                t2d::log::warn("[conn] Failed serialize server msg");
-                continue;
-            }
-            uint32_t out_len = htonl(static_cast<uint32_t>(out.size()));
-            std::string frame;
-            frame.resize(4 + out.size());
-            std::memcpy(frame.data(), &out_len, 4);
-            std::memcpy(frame.data() + 4, out.data(), out.size());
-            if (session->client)
-                co_await send_all(*session->client, std::span<const char>(frame.data(), frame.size()));
-            t2d::log::debug(
-                "[conn] Sent server message type={}",
-                (smsg.has_auth_response()      ? "AuthResponse"
-                     : smsg.has_queue_status() ? "QueueStatus"
-                     : smsg.has_match_start()  ? "MatchStart"
-                                               : "Other"));
-        }
+        if (rstatus != coro::net::recv_status::ok)
+            continue;
+        // Dispatch complete frames; direct replies (AuthResponse, QueueStatus, HeartbeatResponse) go out before the
+        // next drain.
+        out.clear();
+        if (!conn.on_bytes(span.data(), span.size(), out))
+            co_return;
+        if (!out.empty())
+            co_await send_out(std::span<const char>(out.data(), out.size()));
     }
 }
 
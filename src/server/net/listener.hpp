@@ -1,6 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "server/net/ktls.hpp"
+#include "server/net/rate_limit.hpp"
+#include "server/net/socket_profile.hpp"
+
 #include <coro/coro.hpp>
 #include <coro/io_scheduler.hpp>
 
@@ -11,7 +15,15 @@ namespace t2d::net {
 
 // Starts the TCP accept loop on the given port.
 // poll/read timeout inside each connection loop is derived from tick_rate to
-// keep outbound flush latency bounded relative to simulation ticks.
-coro::task<void> run_listener(std::shared_ptr<coro::io_scheduler> scheduler, uint16_t port, uint32_t tick_rate);
+// keep outbound flush latency bounded relative to simulation ticks. limits configures the per-connection inbound
+// token buckets (rate_limit.hpp); socket is applied to every accepted connection (socket_profile.hpp). When tls is
+// set every connection completes a TLS handshake first and then runs on kernel TLS where available (ktls.hpp).
+coro::task<void> run_listener(
+    std::shared_ptr<coro::io_scheduler> scheduler,
+    uint16_t port,
+    uint32_t tick_rate,
+    RateLimits limits = {},
+    SocketProfile socket = {},
+    std::shared_ptr<TlsContext> tls = nullptr);
 
 } // namespace t2d::net
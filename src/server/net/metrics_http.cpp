@@ -3,11 +3,18 @@
 
 #include "common/logger.hpp"
 #include "common/metrics.hpp"
+#include "server/game/overload_governor.hpp"
+#include "server/game/tick_perf.hpp"
+#include "server/matchmaking/admission.hpp"
+#include "server/matchmaking/session_manager.hpp"
+#include "server/runtime/huge_pages.hpp"
+#include "server/runtime/thread_profile.hpp"
 
 #include <coro/net/tcp/client.hpp>
 #include <coro/net/tcp/server.hpp>
 #include <coro/poll.hpp>
 
+#include <chrono>
 #include <cstring>
 #include <span>
 #include <sstream>
@@ -15,6 +22,212 @@
 
 namespace t2d::net {
 
+// Prometheus histogram for one of the input latency bucket arrays (microseconds; last bucket = overflow).
+static void write_input_latency_histogram(
+    std::ostringstream &oss,
+    const char *name,
+    const std::atomic<uint64_t> *hist,
+    const std::atomic<uint64_t> &accum,
+    const std::atomic<uint64_t> &samples)
+{
+    using RC = t2d::metrics::RuntimeCounters;
+    oss << "# TYPE " << name << " histogram\n";
+    uint64_t cumulative = 0;
+    for (int i = 0; i < RC::INPUT_LATENCY_BUCKETS - 1; ++i) {
+        cumulative += hist[i].load();
+        oss << name << "_bucket{le=\"" << (RC::INPUT_LATENCY_BASE_US << i) << "\"} " << cumulative << "\n";
+    }
+    cumulative += hist[RC::INPUT_LATENCY_BUCKETS - 1].load();
+    oss << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+    oss << name << "_sum " << accum.load() << "\n";
+    oss << name << "_count " << samples.load() << "\n";
+}
+
+// Prometheus label value with quotes and backslashes escaped.
+static std::string escape_label(const std::string &v)
+{
+    std::string out;
+    out.reserve(v.size());
+    for (char c : v) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// Label block for a session id ({session="..."} plus the separating space).
+static std::string session_label(const std::string &id)
+{
+    return "{session=\"" + escape_label(id) + "\"} ";
+}
+
+// Per-session receive -> send input latency (sessions that have had at least one input reach the socket).
+static void write_session_input_latency(std::ostringstream &oss)
+{
+    auto sessions = t2d::mm::instance().snapshot_all_sessions();
+    std::ostringstream sum, count, max, last;
+    for (const auto &s : sessions) {
+        if (s->is_bot)
+            continue;
+        auto lat = t2d::mm::instance().get_input_latency(s);
+        if (lat.samples == 0)
+            continue;
+        const std::string label = session_label(s->session_id);
+        sum << "t2d_session_input_recv_to_send_us_sum" << label << lat.recv_to_send_us_sum << "\n";
+        count << "t2d_session_input_recv_to_send_us_count" << label << lat.samples << "\n";
+        max << "t2d_session_input_recv_to_send_max_us" << label << lat.recv_to_send_us_max << "\n";
+        last << "t2d_session_input_recv_to_send_last_us" << label << lat.recv_to_send_us_last << "\n";
+    }
+    oss << "# TYPE t2d_session_input_recv_to_send_us summary\n" << sum.str() << count.str();
+    oss << "# TYPE t2d_session_input_recv_to_send_max_us gauge\n" << max.str();
+    oss << "# TYPE t2d_session_input_recv_to_send_last_us gauge\n" << last.str();
+}
+
+// Per-session clock sync as last reported by the client (Heartbeat.rtt_us / clock_offset_us, min-RTT filtered).
+static void write_session_clock(std::ostringstream &oss)
+{
+    auto sessions = t2d::mm::instance().snapshot_all_sessions();
+    std::ostringstream rtt, offset;
+    for (const auto &s : sessions) {
+        if (s->is_bot)
+            continue;
+        auto clk = t2d::mm::instance().get_clock_report(s);
+        if (clk.reports == 0)
+            continue;
+        const std::string label = session_label(s->session_id);
+        rtt << "t2d_session_rtt_us" << label << clk.rtt_us << "\n";
+        offset << "t2d_session_clock_offset_us" << label << clk.offset_us << "\n";
+    }
+    oss << "# TYPE t2d_session_rtt_us gauge\n" << rtt.str();
+    oss << "# TYPE t2d_session_clock_offset_us gauge\n" << offset.str();
+}
+
+// Per-thread scheduler statistics (labels: thread name as set by the thread profile, tid). Involuntary switches
+// count preemptions while runnable: the noise CPU isolation / SCHED_FIFO is meant to remove from tick threads.
+static void write_thread_stats(std::ostringstream &oss)
+{
+    std::ostringstream vol, invol, cpu;
+    for (const auto &ts : t2d::runtime::collect_thread_stats()) {
+        const std::string label = "{thread=\"" + escape_label(ts.name) + "\",tid=\"" + std::to_string(ts.tid) + "\"} ";
+        vol << "t2d_thread_voluntary_ctxt_switches" << label << ts.voluntary_switches << "\n";
+        invol << "t2d_thread_nonvoluntary_ctxt_switches" << label << ts.nonvoluntary_switches << "\n";
+        cpu << "t2d_thread_last_cpu" << label << ts.last_cpu << "\n";
+    }
+    oss << "# TYPE t2d_thread_voluntary_ctxt_switches counter\n" << vol.str();
+    oss << "# TYPE t2d_thread_nonvoluntary_ctxt_switches counter\n" << invol.str();
+    oss << "# TYPE t2d_thread_last_cpu gauge\n" << cpu.str();
+}
+
+// Huge page heap (only when huge_pages is enabled). backing: 0 normal, 1 thp, 2 hugetlb - the weakest any region got.
+static void write_huge_pages(std::ostringstream &oss)
+{
+    auto &heap = t2d::runtime::HugePageHeap::instance();
+    if (!heap.enabled())
+        return;
+    const auto st = heap.stats();
+    oss << "# TYPE t2d_hugepage_backing gauge\n";
+    oss << "t2d_hugepage_backing " << static_cast<int>(st.backing) << "\n";
+    oss << "# TYPE t2d_hugepage_reserved_bytes gauge\n";
+    oss << "t2d_hugepage_reserved_bytes " << st.reserved_bytes << "\n";
+    oss << "# TYPE t2d_hugepage_in_use_bytes gauge\n";
+    oss << "t2d_hugepage_in_use_bytes " << st.in_use_bytes << "\n";
+    oss << "# TYPE t2d_hugepage_resident_bytes gauge\n";
+    oss << "t2d_hugepage_resident_bytes " << t2d::runtime::resident_huge_page_bytes() << "\n";
+    oss << "# TYPE t2d_hugepage_system_allocations counter\n";
+    oss << "t2d_hugepage_system_allocations " << st.system_allocations << "\n";
+}
+
+// Overload governor (only when governor_enabled). level: 0 normal .. 4 precision (see overload_governor.hpp).
+static void write_governor(std::ostringstream &oss)
+{
+    auto &gov = t2d::game::governor();
+    if (!gov.enabled())
+        return;
+    const auto st = gov.stats(std::chrono::steady_clock::now());
+    oss << "# TYPE t2d_governor_level gauge\n";
+    oss << "t2d_governor_level " << st.level << "\n";
+    oss << "# TYPE t2d_governor_tick_p95_us gauge\n";
+    oss << "t2d_governor_tick_p95_us " << st.last_p95_us << "\n";
+    oss << "# TYPE t2d_governor_escalations counter\n";
+    oss << "t2d_governor_escalations " << st.escalations << "\n";
+    oss << "# TYPE t2d_governor_recoveries counter\n";
+    oss << "t2d_governor_recoveries " << st.recoveries << "\n";
+    oss << "# TYPE t2d_governor_time_at_level_seconds counter\n";
+    for (uint32_t lv = 0; lv < t2d::game::OverloadGovernor::kLevels; ++lv) {
+        oss << "t2d_governor_time_at_level_seconds{level=\"" << lv << "\",name=\""
+            << t2d::game::OverloadGovernor::level_name(lv) << "\"} "
+            << static_cast<double>(st.time_at_level_ms[lv]) / 1000.0 << "\n";
+    }
+}
+
+// Admission control: matches held back per reason, predicted / measured simulation load and the learned cost model.
+static void write_admission(std::ostringstream &oss)
+{
+    const auto st = t2d::mm::admission().stats();
+    oss << "# TYPE t2d_admission_admitted counter\n";
+    oss << "t2d_admission_admitted " << st.admitted << "\n";
+    oss << "# TYPE t2d_admission_denied counter\n";
+    oss << "t2d_admission_denied{reason=\"match_cap\"} " << st.denied_cap << "\n";
+    oss << "t2d_admission_denied{reason=\"capacity\"} " << st.denied_capacity << "\n";
+    oss << "t2d_admission_denied{reason=\"overload\"} " << st.denied_overload << "\n";
+    oss << "# TYPE t2d_admission_running_matches gauge\n";
+    oss << "t2d_admission_running_matches " << st.running << "\n";
+    oss << "# TYPE t2d_admission_load_cores gauge\n";
+    oss << "t2d_admission_load_cores " << st.load_cores << "\n";
+    oss << "# TYPE t2d_admission_capacity_cores gauge\n";
+    oss << "t2d_admission_capacity_cores " << st.capacity_cores << "\n";
+    oss << "# TYPE t2d_admission_match_seconds_mean gauge\n";
+    oss << "t2d_admission_match_seconds_mean " << st.mean_match_seconds << "\n";
+    oss << "# TYPE t2d_admission_model_tick_us gauge\n";
+    oss << "t2d_admission_model_tick_us{term=\"base\"} " << st.model.base_us << "\n";
+    oss << "t2d_admission_model_tick_us{term=\"per_human\"} " << st.model.per_human_us << "\n";
+    oss << "t2d_admission_model_tick_us{term=\"per_bot\"} " << st.model.per_bot_us << "\n";
+    oss << "# TYPE t2d_admission_model_samples counter\n";
+    oss << "t2d_admission_model_samples " << st.model_samples << "\n";
+}
+
+// Tick cost per phase: wall time, and hardware events plus IPC on threads where perf_counters_enabled could open
+// the counter group (only the events the PMU accepted are listed).
+static void write_tick_phases(std::ostringstream &oss)
+{
+    auto &rt = t2d::metrics::runtime();
+    oss << "# TYPE t2d_tick_phase_ns counter\n";
+    for (size_t p = 0; p < t2d::game::kTickPhases; ++p) {
+        oss << "t2d_tick_phase_ns{phase=\"" << t2d::game::tick_phase_name(static_cast<t2d::game::TickPhase>(p))
+            << "\"} " << rt.tick_phase_ns[p].load() << "\n";
+    }
+    oss << "# TYPE t2d_tick_phase_samples counter\n";
+    oss << "t2d_tick_phase_samples " << rt.tick_phase_samples.load() << "\n";
+    oss << "# TYPE t2d_tick_perf_threads gauge\n";
+    oss << "t2d_tick_perf_threads " << rt.tick_perf_threads.load() << "\n";
+    const uint64_t mask = rt.tick_perf_event_mask.load();
+    if (mask == 0)
+        return;
+    oss << "# TYPE t2d_tick_phase_event_samples counter\n";
+    oss << "t2d_tick_phase_event_samples " << rt.tick_phase_event_samples.load() << "\n";
+    oss << "# TYPE t2d_tick_phase_events counter\n";
+    for (size_t p = 0; p < t2d::game::kTickPhases; ++p) {
+        const char *phase = t2d::game::tick_phase_name(static_cast<t2d::game::TickPhase>(p));
+        for (size_t i = 0; i < t2d::game::kTickPerfEventCount; ++i) {
+            if (!(mask & (uint64_t(1) << i)))
+                continue;
+            oss << "t2d_tick_phase_events{phase=\"" << phase << "\",event=\""
+                << t2d::runtime::event_name(t2d::game::kTickPerfEvents[i]) << "\"} "
+                << rt.tick_phase_events[p][i].load() << "\n";
+        }
+    }
+    if ((mask & 3) != 3) // cycles and instructions
+        return;
+    oss << "# TYPE t2d_tick_phase_ipc gauge\n";
+    for (size_t p = 0; p < t2d::game::kTickPhases; ++p) {
+        const uint64_t cycles = rt.tick_phase_events[p][0].load();
+        const double ipc = cycles ? static_cast<double>(rt.tick_phase_events[p][1].load()) / cycles : 0.0;
+        oss << "t2d_tick_phase_ipc{phase=\"" << t2d::game::tick_phase_name(static_cast<t2d::game::TickPhase>(p))
+            << "\"} " << ipc << "\n";
+    }
+}
+
 static std::string build_metrics_body()
 {
     std::ostringstream oss;
@@ -50,6 +263,20 @@ static std::string build_metrics_body()
     oss << "t2d_active_matches " << rt.active_matches.load() << "\n";
     oss << "# TYPE t2d_bots_in_match gauge\n";
     oss << "t2d_bots_in_match " << rt.bots_in_match.load() << "\n";
+    oss << "# TYPE t2d_bots_live gauge\n";
+    oss << "t2d_bots_live " << rt.bots_live.load() << "\n";
+    oss << "# TYPE t2d_bots_pooled gauge\n";
+    oss << "t2d_bots_pooled " << rt.bots_pooled.load() << "\n";
+    oss << "# TYPE t2d_matches_headless counter\n";
+    oss << "t2d_matches_headless " << rt.matches_headless.load() << "\n";
+    oss << "# TYPE t2d_fast_forward_ticks counter\n";
+    oss << "t2d_fast_forward_ticks " << rt.fast_forward_ticks.load() << "\n";
+    oss << "# TYPE t2d_fast_forward_tick_ns_total counter\n";
+    oss << "t2d_fast_forward_tick_ns_total " << rt.fast_forward_tick_ns_total.load() << "\n";
+    oss << "# TYPE t2d_flight_recorder_breaches counter\n";
+    oss << "t2d_flight_recorder_breaches " << rt.flight_recorder_breaches.load() << "\n";
+    oss << "# TYPE t2d_flight_recorder_dumps counter\n";
+    oss << "t2d_flight_recorder_dumps " << rt.flight_recorder_dumps.load() << "\n";
     oss << "# TYPE t2d_connected_players gauge\n";
     oss << "t2d_connected_players " << rt.connected_players.load() << "\n";
     oss << "# TYPE t2d_projectiles_active gauge\n";
@@ -115,6 +342,120 @@ static std::string build_metrics_body()
     // Sum & count (using existing accumulators)
     oss << "t2d_tick_duration_ns_sum " << rt.tick_duration_ns_accum.load() << "\n";
     oss << "t2d_tick_duration_ns_count " << rt.tick_samples.load() << "\n";
+    oss << "# TYPE t2d_tick_events_total counter\n";
+    oss << "t2d_tick_events_total " << rt.tick_events_total.load() << "\n";
+    oss << "# TYPE t2d_tick_event_batches_piggybacked counter\n";
+    oss << "t2d_tick_event_batches_piggybacked " << rt.tick_event_batches_piggybacked.load() << "\n";
+    oss << "# TYPE t2d_tick_event_batches_standalone counter\n";
+    oss << "t2d_tick_event_batches_standalone " << rt.tick_event_batches_standalone.load() << "\n";
+    oss << "# TYPE t2d_fanout_encodes counter\n";
+    oss << "t2d_fanout_encodes " << rt.fanout_encodes.load() << "\n";
+    oss << "# TYPE t2d_fanout_frames counter\n";
+    oss << "t2d_fanout_frames " << rt.fanout_frames.load() << "\n";
+    oss << "# TYPE t2d_keyframes_sent counter\n";
+    oss << "t2d_keyframes_sent " << rt.keyframes_sent.load() << "\n";
+    oss << "# TYPE t2d_keyframes_on_demand counter\n";
+    oss << "t2d_keyframes_on_demand " << rt.keyframes_on_demand.load() << "\n";
+    oss << "# TYPE t2d_keyframe_requests_throttled counter\n";
+    oss << "t2d_keyframe_requests_throttled " << rt.keyframe_requests_throttled.load() << "\n";
+    oss << "# TYPE t2d_snapshot_budget_frames counter\n";
+    oss << "t2d_snapshot_budget_frames " << rt.snapshot_budget_frames.load() << "\n";
+    oss << "# TYPE t2d_snapshot_budget_bytes counter\n";
+    oss << "t2d_snapshot_budget_bytes " << rt.snapshot_budget_bytes.load() << "\n";
+    oss << "# TYPE t2d_snapshot_budget_entities_sent counter\n";
+    oss << "t2d_snapshot_budget_entities_sent " << rt.snapshot_budget_entities_sent.load() << "\n";
+    oss << "# TYPE t2d_snapshot_budget_entities_deferred counter\n";
+    oss << "t2d_snapshot_budget_entities_deferred " << rt.snapshot_budget_entities_deferred.load() << "\n";
+    oss << "# TYPE t2d_snapshot_budget_over_budget_frames counter\n";
+    oss << "t2d_snapshot_budget_over_budget_frames " << rt.snapshot_budget_over_budget_frames.load() << "\n";
+    {
+        uint64_t sent = rt.snapshot_budget_entities_sent.load();
+        double prio_mean = sent ? (double)rt.snapshot_budget_priority_sent_milli.load() / 1000.0 / (double)sent : 0.0;
+        oss << "# TYPE t2d_snapshot_budget_priority_sent_mean gauge\n";
+        oss << "t2d_snapshot_budget_priority_sent_mean " << prio_mean << "\n";
+        oss << "# TYPE t2d_snapshot_budget_priority_deferred_max gauge\n";
+        oss << "t2d_snapshot_budget_priority_deferred_max "
+            << (double)rt.snapshot_budget_priority_deferred_max_milli.load() / 1000.0 << "\n";
+    }
+    oss << "# TYPE t2d_projectile_delta_entries counter\n";
+    oss << "t2d_projectile_delta_entries " << rt.projectile_delta_entries.load() << "\n";
+    oss << "# TYPE t2d_projectile_resamples counter\n";
+    oss << "t2d_projectile_resamples " << rt.projectile_resamples.load() << "\n";
+    oss << "# TYPE t2d_input_frames_compact counter\n";
+    oss << "t2d_input_frames_compact " << rt.input_frames_compact.load() << "\n";
+    oss << "# TYPE t2d_input_frames_proto counter\n";
+    oss << "t2d_input_frames_proto " << rt.input_frames_proto.load() << "\n";
+    oss << "# TYPE t2d_input_bytes counter\n";
+    oss << "t2d_input_bytes " << rt.input_bytes.load() << "\n";
+    oss << "# TYPE t2d_frames_compressed counter\n";
+    oss << "t2d_frames_compressed " << rt.frames_compressed.load() << "\n";
+    oss << "# TYPE t2d_frame_compress_saved_bytes counter\n";
+    oss << "t2d_frame_compress_saved_bytes " << rt.frame_compress_saved_bytes.load() << "\n";
+    oss << "# TYPE t2d_inbound_throttled_input counter\n";
+    oss << "t2d_inbound_throttled_input " << rt.inbound_throttled_input.load() << "\n";
+    oss << "# TYPE t2d_inbound_throttled_heartbeat counter\n";
+    oss << "t2d_inbound_throttled_heartbeat " << rt.inbound_throttled_heartbeat.load() << "\n";
+    oss << "# TYPE t2d_inbound_throttled_control counter\n";
+    oss << "t2d_inbound_throttled_control " << rt.inbound_throttled_control.load() << "\n";
+    oss << "# TYPE t2d_inbound_flood_disconnects counter\n";
+    oss << "t2d_inbound_flood_disconnects " << rt.inbound_flood_disconnects.load() << "\n";
+    oss << "# TYPE t2d_net_uring_submits counter\n";
+    oss << "t2d_net_uring_submits " << rt.net_uring_submits.load() << "\n";
+    oss << "# TYPE t2d_net_uring_cqes counter\n";
+    oss << "t2d_net_uring_cqes " << rt.net_uring_cqes.load() << "\n";
+    oss << "# TYPE t2d_net_uring_send_sqes counter\n";
+    oss << "t2d_net_uring_send_sqes " << rt.net_uring_send_sqes.load() << "\n";
+    oss << "# TYPE t2d_net_uring_recv_nobufs counter\n";
+    oss << "t2d_net_uring_recv_nobufs " << rt.net_uring_recv_nobufs.load() << "\n";
+    oss << "# TYPE t2d_net_uring_short_sends counter\n";
+    oss << "t2d_net_uring_short_sends " << rt.net_uring_short_sends.load() << "\n";
+    oss << "# TYPE t2d_net_frame_pool_hits counter\n";
+    oss << "t2d_net_frame_pool_hits " << rt.net_frame_pool_hits.load() << "\n";
+    oss << "# TYPE t2d_net_frame_pool_misses counter\n";
+    oss << "t2d_net_frame_pool_misses " << rt.net_frame_pool_misses.load() << "\n";
+    oss << "# TYPE t2d_tls_handshakes counter\n";
+    oss << "t2d_tls_handshakes " << rt.tls_handshakes.load() << "\n";
+    oss << "# TYPE t2d_tls_handshake_failures counter\n";
+    oss << "t2d_tls_handshake_failures " << rt.tls_handshake_failures.load() << "\n";
+    oss << "# TYPE t2d_tls_ktls_offloaded counter\n";
+    oss << "t2d_tls_ktls_offloaded " << rt.tls_ktls_offloaded.load() << "\n";
+    oss << "# TYPE t2d_tls_userspace counter\n";
+    oss << "t2d_tls_userspace " << rt.tls_userspace.load() << "\n";
+    write_input_latency_histogram(
+        oss,
+        "t2d_input_recv_to_apply_us",
+        rt.input_recv_to_apply_hist,
+        rt.input_recv_to_apply_us_accum,
+        rt.input_recv_to_apply_samples);
+    write_input_latency_histogram(
+        oss,
+        "t2d_input_recv_to_send_us",
+        rt.input_recv_to_send_hist,
+        rt.input_recv_to_send_us_accum,
+        rt.input_recv_to_send_samples);
+    write_input_latency_histogram(
+        oss,
+        "t2d_outbound_control_queue_us",
+        rt.outbound_control_queue_hist,
+        rt.outbound_control_queue_us_accum,
+        rt.outbound_control_queue_samples);
+    write_input_latency_histogram(
+        oss,
+        "t2d_outbound_state_queue_us",
+        rt.outbound_state_queue_hist,
+        rt.outbound_state_queue_us_accum,
+        rt.outbound_state_queue_samples);
+    oss << "# TYPE t2d_outbound_state_superseded counter\n";
+    oss << "t2d_outbound_state_superseded " << rt.outbound_state_superseded.load() << "\n";
+    oss << "# TYPE t2d_outbound_events_rescued counter\n";
+    oss << "t2d_outbound_events_rescued " << rt.outbound_events_rescued.load() << "\n";
+    write_session_input_latency(oss);
+    write_session_clock(oss);
+    write_thread_stats(oss);
+    write_huge_pages(oss);
+    write_tick_phases(oss);
+    write_governor(oss);
+    write_admission(oss);
     oss << "# TYPE t2d_auth_failures counter\n";
     oss << "t2d_auth_failures " << rt.auth_failures.load() << "\n";
     return oss.str();
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+// rate_limit.hpp - Per-connection inbound token buckets by message class (flood protection for connection_loop)
+#pragma once
+#include "common/frame_header.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace t2d::net {
+
+enum class MsgClass : uint8_t
+{
+    Input = 0, // InputCommand / compact input (one mutex acquisition in update_input each)
+    Heartbeat = 1, // each one produces a HeartbeatResponse
+    Control = 2, // auth, queue join, keyframe request, unknown
+    Count = 3
+};
+
+struct RateLimits
+{
+    uint32_t input_per_sec{240}; // clients send at most 2x tick rate; leaves headroom for 120 Hz servers
+    uint32_t heartbeat_per_sec{5}; // clients send one per second
+    uint32_t control_per_sec{10};
+    float burst_seconds{1.f}; // bucket depth = rate * burst_seconds (at least one message)
+    uint32_t disconnect_throttled_per_sec{1000}; // close once this many are throttled within 1s (0 = never)
+    // Larger frames of the class close the connection before decompression or reassembly (0 = no cap). Control
+    // covers auth (token), queue join and keyframe requests, and every compressed or fragmented frame.
+    uint32_t input_max_bytes{256};
+    uint32_t heartbeat_max_bytes{256};
+    uint32_t control_max_bytes{8192};
+
+    uint32_t max_bytes(MsgClass c) const
+    {
+        return c == MsgClass::Input   ? input_max_bytes
+            : c == MsgClass::Heartbeat ? heartbeat_max_bytes
+                                       : control_max_bytes;
+    }
+};
+
+// Classic token bucket: refills continuously at rate tokens/s up to burst. rate 0 disables limiting.
+class TokenBucket
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    void configure(double rate, double burst, clock::time_point now)
+    {
+        m_rate = rate;
+        m_burst = burst < 1.0 ? 1.0 : burst;
+        m_tokens = m_burst;
+        m_last = now;
+    }
+
+    bool allow(clock::time_point now)
+    {
+        if (m_rate <= 0.0)
+            return true;
+        double dt = std::chrono::duration<double>(now - m_last).count();
+        m_last = now;
+        if (dt > 0.0) {
+            m_tokens += dt * m_rate;
+            if (m_tokens > m_burst)
+                m_tokens = m_burst;
+        }
+        if (m_tokens < 1.0)
+            return false;
+        m_tokens -= 1.0;
+        return true;
+    }
+
+private:
+    double m_rate{0.0};
+    double m_burst{1.0};
+    double m_tokens{1.0};
+    clock::time_point m_last{};
+};
+
+enum class RateVerdict : uint8_t
+{
+    Accept,
+    Throttle, // drop this message, keep the connection
+    Disconnect // oversized for its class or sustained flood
+};
+
+// One per connection; owned by connection_loop (not thread-safe).
+class ConnectionRateLimiter
+{
+public:
+    explicit ConnectionRateLimiter(const RateLimits &limits, TokenBucket::clock::time_point now)
+        : m_limits(limits)
+    {
+        configure(MsgClass::Input, limits.input_per_sec, now);
+        configure(MsgClass::Heartbeat, limits.heartbeat_per_sec, now);
+        configure(MsgClass::Control, limits.control_per_sec, now);
+        m_window_start = now;
+    }
+
+    // Checks one frame of class c that is wire_len bytes on the wire. Called before decoding, so every fragment and
+    // every compressed frame is charged at its received size.
+    RateVerdict check(MsgClass c, size_t wire_len, TokenBucket::clock::time_point now)
+    {
+        uint32_t cap = m_limits.max_bytes(c);
+        if (cap != 0 && wire_len > cap)
+            return RateVerdict::Disconnect;
+        if (m_buckets[static_cast<size_t>(c)].allow(now))
+            return RateVerdict::Accept;
+        if (now - m_window_start >= std::chrono::seconds(1)) {
+            m_window_start = now;
+            m_window_throttled = 0;
+        }
+        ++m_window_throttled;
+        if (m_limits.disconnect_throttled_per_sec != 0 && m_window_throttled > m_limits.disconnect_throttled_per_sec)
+            return RateVerdict::Disconnect;
+        return RateVerdict::Throttle;
+    }
+
+    const RateLimits &limits() const { return m_limits; }
+
+private:
+    void configure(MsgClass c, uint32_t rate, TokenBucket::clock::time_point now)
+    {
+        double burst = static_cast<double>(rate) * m_limits.burst_seconds;
+        m_buckets[static_cast<size_t>(c)].configure(rate, burst, now);
+    }
+
+    RateLimits m_limits;
+    std::array<TokenBucket, static_cast<size_t>(MsgClass::Count)> m_buckets{};
+    TokenBucket::clock::time_point m_window_start{};
+    uint32_t m_window_throttled{0};
+};
+
+// Message class from the frame type and, for ClientMessage / legacy frames, the first protobuf tag of the body
+// (the oneof field number) - no parse needed.
+inline MsgClass classify_frame(t2d::netutil::FrameType type, const char *body, size_t body_len)
+{
+    using t2d::netutil::FrameType;
+    switch (type) {
+        case FrameType::InputCompact:
+        case FrameType::Input:
+            return MsgClass::Input;
+        case FrameType::Heartbeat:
+            return MsgClass::Heartbeat;
+        case FrameType::Legacy:
+        case FrameType::ClientMessage:
+            break;
+        default:
+            return MsgClass::Control;
+    }
+    if (body_len == 0)
+        return MsgClass::Control;
+    // ClientMessage oneof tags are < 16, so the key is a single byte: (field << 3) | wire_type.
+    switch (static_cast<uint8_t>(body[0]) >> 3) {
+        case 3: // input
+            return MsgClass::Input;
+        case 4: // heartbeat
+            return MsgClass::Heartbeat;
+        default:
+            return MsgClass::Control;
+    }
+}
+
+struct PayloadClass
+{
+    MsgClass cls{MsgClass::Control};
+    bool fragment{false}; // part of a multi-frame message: cannot be dropped alone
+};
+
+// Class of a received payload (inside the length prefix) before the decoder touches it. Compressed frames and
+// fragments count as control: their body is not readable without decoding, and no well-behaved client sends input
+// or heartbeats that way. in_fragment is the decoder's reassembly state.
+inline PayloadClass classify_payload(const char *data, size_t len, bool in_fragment)
+{
+    using namespace t2d::netutil;
+    PayloadClass pc;
+    pc.fragment = in_fragment;
+    if (!is_headered_payload(data, len)) {
+        if (!in_fragment)
+            pc.cls = classify_frame(FrameType::Legacy, data, len);
+        return pc;
+    }
+    FrameHeader h;
+    const size_t hs = parse_frame_header(data, len, h);
+    pc.fragment |= (h.flags & FRAME_FLAG_MORE) != 0;
+    if (hs == 0 || pc.fragment || (h.flags & FRAME_FLAG_COMPRESSED))
+        return pc;
+    pc.cls = classify_frame(h.type, data + hs, len - hs);
+    return pc;
+}
+
+} // namespace t2d::net
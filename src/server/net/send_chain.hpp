@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+// send_chain.hpp - Bookkeeping for one connection's linked send chain on the io_uring backend (uring_listener.cpp).
+// Every completion is checked against the length of the segment it was submitted for: MSG_WAITALL does not promise a
+// full write on a non-blocking TCP socket, and a short segment ends the chain (the kernel cancels the linked rest),
+// so the chain resumes from the first unsent byte instead of dropping the remainder from the stream.
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace t2d::net {
+
+class SendChain
+{
+public:
+    enum class Completion : uint8_t
+    {
+        InFlight, // more sends of this chain are outstanding
+        Done, // every byte of the chain was written
+        Resume, // the chain stopped after a short send; submit() again to send the rest
+        Failed, // a send failed or made no progress (reported once, on that completion)
+    };
+
+    bool idle() const { return m_inflight == 0; }
+    bool empty() const { return m_sent >= m_buf.size(); }
+
+    // Takes pending as the bytes of the next chain; pending is left empty with the previous buffer's capacity.
+    // Only while idle(): in-flight sends point into the buffer.
+    void start(std::string &pending)
+    {
+        m_buf.swap(pending);
+        pending.clear();
+        m_sent = 0;
+        m_stopped = false;
+    }
+
+    // Calls prep(data, len, linked) for each segment of the unsent bytes, in order; linked is true for every segment
+    // but the last. Returns the number of sends submitted.
+    template<class Prep>
+    uint32_t submit(size_t segment_bytes, Prep &&prep)
+    {
+        m_stopped = false;
+        m_next = m_sent;
+        size_t off = m_sent;
+        uint32_t n = 0;
+        while (off < m_buf.size()) {
+            size_t len = std::min(segment_bytes, m_buf.size() - off);
+            prep(m_buf.data() + off, len, off + len < m_buf.size());
+            off += len;
+            ++n;
+        }
+        m_segment = segment_bytes;
+        m_inflight = n;
+        return n;
+    }
+
+    // Accounts the result of one send completion. Completions of a linked chain arrive in submission order.
+    Completion complete(int res)
+    {
+        if (m_inflight > 0)
+            --m_inflight;
+        Completion r = Completion::InFlight;
+        if (!m_stopped) {
+            const size_t expected = std::min(m_segment, m_buf.size() - m_next);
+            if (res <= 0) {
+                m_stopped = true;
+                r = Completion::Failed;
+            } else {
+                m_sent += static_cast<size_t>(res);
+                m_next += expected;
+                if (static_cast<size_t>(res) < expected)
+                    m_stopped = true; // short: the linked sends behind it complete with -ECANCELED
+            }
+        } else if (res > 0) {
+            // A send behind the stopped one still went out (not cancelled): the stream has a gap that cannot be
+            // repaired.
+            r = Completion::Failed;
+        }
+        if (r == Completion::Failed || m_inflight > 0)
+            return r;
+        return empty() ? Completion::Done : Completion::Resume;
+    }
+
+    // Drops the buffer (connection released).
+    void reset()
+    {
+        m_buf.clear();
+        m_sent = m_next = 0;
+        m_inflight = 0;
+        m_stopped = false;
+    }
+
+private:
+    std::string m_buf; // owned by the submitted sends until their completions arrive
+    size_t m_sent{0}; // bytes confirmed written
+    size_t m_next{0}; // start of the segment the next completion belongs to
+    size_t m_segment{0};
+    uint32_t m_inflight{0};
+    bool m_stopped{false}; // a send of the current chain was short or failed
+};
+
+} // namespace t2d::net
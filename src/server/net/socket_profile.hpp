@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+// socket_profile.hpp - Low-latency socket options applied to every accepted client connection
+#pragma once
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+namespace t2d::net {
+
+struct SocketProfile
+{
+    bool nodelay{true}; // disable Nagle: frames are small and latency bound
+    int sndbuf{0}; // SO_SNDBUF bytes (0 = kernel default / autotuning)
+    int rcvbuf{0}; // SO_RCVBUF bytes (0 = kernel default / autotuning)
+    int notsent_lowat{16384}; // TCP_NOTSENT_LOWAT: cap unsent bytes queued in the kernel (0 = unset)
+    int busy_poll_us{0}; // SO_BUSY_POLL microseconds (0 = off; needs CAP_NET_ADMIN to raise above sysctl)
+    bool cork_flush{false}; // TCP_CORK around each flush so a multi-write flush leaves as full segments
+};
+
+// Applies the profile to fd. Returns the number of options the kernel rejected (the connection stays usable).
+inline int apply_socket_profile(int fd, const SocketProfile &p)
+{
+    int failed = 0;
+    int one = 1;
+    if (p.nodelay && ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) != 0)
+        ++failed;
+    if (p.sndbuf > 0 && ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &p.sndbuf, sizeof(p.sndbuf)) != 0)
+        ++failed;
+    if (p.rcvbuf > 0 && ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &p.rcvbuf, sizeof(p.rcvbuf)) != 0)
+        ++failed;
+#ifdef TCP_NOTSENT_LOWAT
+    if (p.notsent_lowat > 0
+        && ::setsockopt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &p.notsent_lowat, sizeof(p.notsent_lowat)) != 0)
+        ++failed;
+#endif
+#ifdef SO_BUSY_POLL
+    if (p.busy_poll_us > 0 && ::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &p.busy_poll_us, sizeof(p.busy_poll_us)) != 0)
+        ++failed;
+#endif
+    return failed;
+}
+
+// Corks (on=true) before a flush and uncorks after it; uncorking pushes any partial segment out immediately.
+inline void set_cork(int fd, bool on)
+{
+#ifdef TCP_CORK
+    int v = on ? 1 : 0;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_CORK, &v, sizeof(v));
+#else
+    (void)fd;
+    (void)on;
+#endif
+}
+
+} // namespace t2d::net
@@ -0,0 +1,466 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/net/uring_listener.hpp"
+
+#include "common/logger.hpp"
+
+#if T2D_HAS_IO_URING
+#include "common/metrics.hpp"
+#include "server/matchmaking/session_manager.hpp"
+#include "server/net/connection.hpp"
+#include "server/net/send_chain.hpp"
+
+#include <arpa/inet.h>
+#include <liburing.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#endif
+
+namespace t2d::net {
+
+#if T2D_HAS_IO_URING
+
+namespace {
+
+constexpr unsigned kRingEntries = 4096;
+constexpr unsigned kBufRingEntries = 1024; // power of two (buffer ring requirement)
+constexpr unsigned kBufSize = 4096;
+constexpr uint16_t kBufGroup = 1;
+constexpr size_t kSendSegmentBytes = 64 * 1024; // one linked SQE per segment of a connection's flush batch
+
+enum class Op : uint8_t
+{
+    Accept = 1,
+    Recv = 2,
+    Send = 3,
+    Timeout = 4
+};
+
+// user_data: op (8 bits) | slot generation (24 bits) | slot index (32 bits). The generation guards against a CQE of
+// a previous occupant (slots are only recycled once no request references them, so this is belt and braces).
+inline uint64_t pack(Op op, uint32_t slot, uint32_t gen)
+{
+    return (static_cast<uint64_t>(op) << 56) | (static_cast<uint64_t>(gen & 0xFFFFFFu) << 32) | slot;
+}
+
+inline Op op_of(uint64_t ud)
+{
+    return static_cast<Op>(ud >> 56);
+}
+
+inline uint32_t gen_of(uint64_t ud)
+{
+    return static_cast<uint32_t>(ud >> 32) & 0xFFFFFFu;
+}
+
+inline uint32_t slot_of(uint64_t ud)
+{
+    return static_cast<uint32_t>(ud);
+}
+
+struct UringConn
+{
+    int fd{-1};
+    uint32_t gen{0};
+    std::unique_ptr<Connection> conn;
+    SendChain chain; // bytes owned by submitted sends until their CQEs arrive
+    std::string pending; // outbound bytes waiting for the in-flight chain to finish
+    bool recv_armed{false};
+    bool closing{false};
+    bool dirty{false}; // listed in State::dirty
+};
+
+} // namespace
+
+struct UringListener::State
+{
+    io_uring ring{};
+    bool ring_ready{false};
+    io_uring_buf_ring *buf_ring{nullptr};
+    std::vector<char> bufs; // kBufRingEntries * kBufSize provided recv buffers
+    int listen_fd{-1};
+    RateLimits limits;
+    SocketProfile socket;
+    __kernel_timespec flush_period{};
+    std::deque<UringConn> conns; // stable addresses: in-flight sends point into chain (may be SSO storage)
+    std::vector<uint32_t> free_slots;
+    std::vector<uint32_t> dirty; // slots with pending bytes and no send chain in flight
+    bool flush_due{false};
+
+    ~State()
+    {
+        for (auto &c : conns) {
+            if (c.fd >= 0)
+                ::close(c.fd);
+        }
+        if (listen_fd >= 0)
+            ::close(listen_fd);
+        if (buf_ring)
+            io_uring_free_buf_ring(&ring, buf_ring, kBufRingEntries, kBufGroup);
+        if (ring_ready)
+            io_uring_queue_exit(&ring);
+    }
+
+    io_uring_sqe *sqe()
+    {
+        io_uring_sqe *s = io_uring_get_sqe(&ring);
+        if (!s) {
+            // SQ full: push what we have to the kernel and retry (rare; the ring is sized for a full flush).
+            io_uring_submit(&ring);
+            t2d::metrics::runtime().net_uring_submits.fetch_add(1, std::memory_order_relaxed);
+            s = io_uring_get_sqe(&ring);
+        }
+        return s;
+    }
+
+    void arm_accept()
+    {
+        auto *s = sqe();
+        io_uring_prep_multishot_accept(s, listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        io_uring_sqe_set_data64(s, pack(Op::Accept, 0, 0));
+    }
+
+    void arm_timeout()
+    {
+        auto *s = sqe();
+        io_uring_prep_timeout(s, &flush_period, 0, 0);
+        io_uring_sqe_set_data64(s, pack(Op::Timeout, 0, 0));
+    }
+
+    void arm_recv(uint32_t slot)
+    {
+        auto &c = conns[slot];
+        auto *s = sqe();
+        io_uring_prep_recv_multishot(s, c.fd, nullptr, 0, 0);
+        s->flags |= IOSQE_BUFFER_SELECT;
+        s->buf_group = kBufGroup;
+        io_uring_sqe_set_data64(s, pack(Op::Recv, slot, c.gen));
+        c.recv_armed = true;
+    }
+
+    void recycle_buffer(uint16_t bid)
+    {
+        io_uring_buf_ring_add(
+            buf_ring, bufs.data() + size_t(bid) * kBufSize, kBufSize, bid, io_uring_buf_ring_mask(kBufRingEntries), 0);
+        io_uring_buf_ring_advance(buf_ring, 1);
+    }
+
+    void mark_dirty(uint32_t slot)
+    {
+        auto &c = conns[slot];
+        if (!c.dirty && !c.pending.empty()) {
+            c.dirty = true;
+            dirty.push_back(slot);
+        }
+    }
+
+    // Submits the pending bytes of one connection as a chain of linked sends (ordered on the socket; MSG_WAITALL so
+    // the kernel retries partial writes, though a short completion is still possible and resumed in on_send).
+    void submit_send(uint32_t slot)
+    {
+        auto &c = conns[slot];
+        if (c.closing || !c.chain.idle() || c.pending.empty())
+            return;
+        c.chain.start(c.pending);
+        submit_chain(slot);
+    }
+
+    // Submits the unsent bytes of the connection's chain (a new chain, or the rest after a short send).
+    void submit_chain(uint32_t slot)
+    {
+        auto &c = conns[slot];
+        uint32_t n = c.chain.submit(kSendSegmentBytes, [&](const char *data, size_t len, bool linked) {
+            auto *s = sqe();
+            io_uring_prep_send(s, c.fd, data, len, MSG_WAITALL | MSG_NOSIGNAL);
+            if (linked)
+                s->flags |= IOSQE_IO_LINK;
+            io_uring_sqe_set_data64(s, pack(Op::Send, slot, c.gen));
+        });
+        t2d::metrics::runtime().net_uring_send_sqes.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void close_conn(uint32_t slot)
+    {
+        auto &c = conns[slot];
+        if (c.closing)
+            return;
+        c.closing = true;
+        t2d::mm::instance().disconnect_session(c.conn->session());
+        // Terminates the multishot recv and fails queued sends; the fd is closed once their CQEs are in.
+        ::shutdown(c.fd, SHUT_RDWR);
+        maybe_release(slot);
+    }
+
+    void maybe_release(uint32_t slot)
+    {
+        auto &c = conns[slot];
+        if (!c.closing || c.recv_armed || !c.chain.idle())
+            return;
+        ::close(c.fd);
+        c.fd = -1;
+        c.conn.reset();
+        c.chain.reset();
+        c.pending.clear();
+        c.closing = false;
+        ++c.gen;
+        free_slots.push_back(slot);
+    }
+
+    void on_accept(const io_uring_cqe *cqe)
+    {
+        if (!(cqe->flags & IORING_CQE_F_MORE))
+            arm_accept();
+        if (cqe->res < 0) {
+            t2d::log::warn("[uring] accept error: {}", std::strerror(-cqe->res));
+            return;
+        }
+        int fd = cqe->res;
+        if (int failed = apply_socket_profile(fd, socket); failed > 0)
+            t2d::log::debug("[uring] {} socket option(s) rejected by the kernel", failed);
+        uint32_t slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(conns.size());
+            conns.emplace_back();
+        }
+        auto &c = conns[slot];
+        c.fd = fd;
+        c.conn = std::make_unique<Connection>(t2d::mm::instance().add_connection(), limits);
+        t2d::log::info("[conn] New connection (io_uring slot={})", slot);
+        arm_recv(slot);
+    }
+
+    void on_recv(const io_uring_cqe *cqe, uint32_t slot)
+    {
+        auto &c = conns[slot];
+        bool has_buf = (cqe->flags & IORING_CQE_F_BUFFER) != 0;
+        uint16_t bid = static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        if (!(cqe->flags & IORING_CQE_F_MORE))
+            c.recv_armed = false;
+        if (c.closing) {
+            // Tail of a connection being torn down: give the buffer back, release once the recv is gone.
+            if (has_buf)
+                recycle_buffer(bid);
+            maybe_release(slot);
+            return;
+        }
+        if (cqe->res > 0 && has_buf) {
+            bool ok = c.conn->on_bytes(bufs.data() + size_t(bid) * kBufSize, cqe->res, c.pending);
+            recycle_buffer(bid);
+            if (!ok) {
+                close_conn(slot);
+                return;
+            }
+            mark_dirty(slot); // direct replies (AuthResponse, QueueStatus, HeartbeatResponse)
+        } else if (cqe->res == 0) {
+            t2d::log::info("[conn] Closed by peer");
+            close_conn(slot);
+            return;
+        } else if (cqe->res != -ENOBUFS) {
+            t2d::log::warn("[conn] recv error: {}", std::strerror(-cqe->res));
+            close_conn(slot);
+            return;
+        } else {
+            t2d::metrics::runtime().net_uring_recv_nobufs.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!c.recv_armed)
+            arm_recv(slot); // multishot ended (buffer ring ran dry or kernel limit): re-arm
+    }
+
+    void on_send(const io_uring_cqe *cqe, uint32_t slot)
+    {
+        auto &c = conns[slot];
+        const auto r = c.chain.complete(cqe->res);
+        if (r == SendChain::Completion::Failed && !c.closing) {
+            t2d::log::warn("[conn] send error: {}", cqe->res < 0 ? std::strerror(-cqe->res) : "no progress");
+            close_conn(slot);
+        }
+        if (!c.chain.idle())
+            return;
+        if (c.closing) {
+            maybe_release(slot);
+            return;
+        }
+        if (r == SendChain::Completion::Resume) {
+            // Short send: the rest of this chain goes out before any bytes queued meanwhile.
+            t2d::metrics::runtime().net_uring_short_sends.fetch_add(1, std::memory_order_relaxed);
+            submit_chain(slot);
+            return;
+        }
+        mark_dirty(slot); // bytes queued while the chain was in flight
+    }
+
+    // Drains every connection's queued ServerMessages (once per flush period) into its pending buffer.
+    void drain_all()
+    {
+        for (uint32_t i = 0; i < conns.size(); ++i) {
+            auto &c = conns[i];
+            if (c.fd < 0 || c.closing)
+                continue;
+            c.conn->drain_outbound(c.pending);
+            mark_dirty(i);
+        }
+    }
+
+    void submit_dirty()
+    {
+        for (uint32_t slot : dirty) {
+            conns[slot].dirty = false;
+            submit_send(slot);
+        }
+        dirty.clear();
+    }
+};
+
+bool io_uring_available()
+{
+    return true;
+}
+
+UringListener::UringListener() = default;
+UringListener::~UringListener() = default;
+
+bool UringListener::open(uint16_t port, uint32_t tick_rate, const RateLimits &limits, const SocketProfile &socket)
+{
+    auto st = std::make_unique<State>();
+    st->limits = limits;
+    st->socket = socket;
+    uint32_t ms = flush_interval_ms(tick_rate);
+    st->flush_period.tv_sec = ms / 1000;
+    st->flush_period.tv_nsec = static_cast<long long>(ms % 1000) * 1'000'000;
+    io_uring_params params{};
+    params.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    int rc = io_uring_queue_init_params(kRingEntries, &st->ring, &params);
+    if (rc == -EINVAL) {
+        params = {}; // pre-5.19 kernel: no SUBMIT_ALL / COOP_TASKRUN
+        rc = io_uring_queue_init_params(kRingEntries, &st->ring, &params);
+    }
+    if (rc < 0) {
+        t2d::log::warn("[uring] io_uring_queue_init failed: {}", std::strerror(-rc));
+        return false;
+    }
+    st->ring_ready = true;
+    int brc = 0;
+    st->buf_ring = io_uring_setup_buf_ring(&st->ring, kBufRingEntries, kBufGroup, 0, &brc);
+    if (!st->buf_ring) {
+        t2d::log::warn("[uring] provided buffer ring unavailable (kernel < 5.19?): {}", std::strerror(-brc));
+        return false;
+    }
+    st->bufs.resize(size_t(kBufRingEntries) * kBufSize);
+    for (unsigned i = 0; i < kBufRingEntries; ++i) {
+        io_uring_buf_ring_add(
+            st->buf_ring,
+            st->bufs.data() + size_t(i) * kBufSize,
+            kBufSize,
+            static_cast<unsigned short>(i),
+            io_uring_buf_ring_mask(kBufRingEntries),
+            static_cast<int>(i));
+    }
+    io_uring_buf_ring_advance(st->buf_ring, kBufRingEntries);
+
+    st->listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (st->listen_fd < 0) {
+        t2d::log::warn("[uring] socket failed: {}", std::strerror(errno));
+        return false;
+    }
+    int one = 1;
+    ::setsockopt(st->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (::bind(st->listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0
+        || ::listen(st->listen_fd, SOMAXCONN) < 0) {
+        t2d::log::warn("[uring] bind/listen on port {} failed: {}", port, std::strerror(errno));
+        return false;
+    }
+    m_state = std::move(st);
+    t2d::log::info("[listener] io_uring backend on port {} (flush every {} ms)", port, ms);
+    return true;
+}
+
+void UringListener::run(const std::atomic_bool &shutdown)
+{
+    if (!m_state)
+        return;
+    auto &st = *m_state;
+    auto &rt = t2d::metrics::runtime();
+    st.arm_accept();
+    st.arm_timeout();
+    while (!shutdown.load(std::memory_order_relaxed)) {
+        // One syscall submits every queued SQE (send chains of the last flush, re-arms) and waits for completions.
+        int rc = io_uring_submit_and_wait(&st.ring, 1);
+        rt.net_uring_submits.fetch_add(1, std::memory_order_relaxed);
+        if (rc < 0 && rc != -EINTR && rc != -EAGAIN && rc != -EBUSY) {
+            t2d::log::error("[uring] submit_and_wait failed: {}", std::strerror(-rc));
+            return;
+        }
+        io_uring_cqe *cqe = nullptr;
+        unsigned head = 0;
+        unsigned seen = 0;
+        io_uring_for_each_cqe(&st.ring, head, cqe)
+        {
+            ++seen;
+            uint64_t ud = io_uring_cqe_get_data64(cqe);
+            Op op = op_of(ud);
+            if (op == Op::Accept) {
+                st.on_accept(cqe);
+                continue;
+            }
+            if (op == Op::Timeout) {
+                st.flush_due = true;
+                st.arm_timeout();
+                continue;
+            }
+            uint32_t slot = slot_of(ud);
+            if (slot >= st.conns.size() || st.conns[slot].gen != gen_of(ud) || st.conns[slot].fd < 0)
+                continue;
+            if (op == Op::Recv)
+                st.on_recv(cqe, slot);
+            else if (op == Op::Send)
+                st.on_send(cqe, slot);
+        }
+        io_uring_cq_advance(&st.ring, seen);
+        rt.net_uring_cqes.fetch_add(seen, std::memory_order_relaxed);
+        if (st.flush_due) {
+            st.flush_due = false;
+            st.drain_all();
+        }
+        st.submit_dirty();
+    }
+    t2d::log::info("[uring] listener stopped");
+}
+
+#else // !T2D_HAS_IO_URING
+
+struct UringListener::State
+{};
+
+bool io_uring_available()
+{
+    return false;
+}
+
+UringListener::UringListener() = default;
+UringListener::~UringListener() = default;
+
+bool UringListener::open(uint16_t, uint32_t, const RateLimits &, const SocketProfile &)
+{
+    t2d::log::warn("[uring] net_backend io_uring requested but built without liburing (T2D_ENABLE_IO_URING=OFF)");
+    return false;
+}
+
+void UringListener::run(const std::atomic_bool &) {}
+
+#endif
+
+} // namespace t2d::net
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0
+// uring_listener.hpp - Optional io_uring network backend (build with -DT2D_ENABLE_IO_URING=ON, needs liburing).
+// One ring on a dedicated thread owns accept, recv and send for every client connection: multishot accept,
+// multishot recv into a provided buffer ring and, once per flush period, one batched submit carrying the linked
+// send chains of all connections. Protocol handling is the shared Connection (connection.hpp).
+#pragma once
+#include "server/net/rate_limit.hpp"
+#include "server/net/socket_profile.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace t2d::net {
+
+// True when the binary was built with liburing (T2D_HAS_IO_URING).
+bool io_uring_available();
+
+class UringListener
+{
+public:
+    UringListener();
+    ~UringListener();
+    UringListener(const UringListener &) = delete;
+    UringListener &operator=(const UringListener &) = delete;
+
+    // Creates the ring, the provided buffer ring and the listening socket. Returns false (after logging why) when
+    // io_uring is not compiled in or the kernel refuses it; the caller then falls back to run_listener.
+    // socket is applied to every accepted connection (cork_flush is unused: each flush is already one send chain).
+    bool open(uint16_t port, uint32_t tick_rate, const RateLimits &limits, const SocketProfile &socket);
+
+    // Event loop; returns once shutdown is set (checked every flush period). Call on a dedicated thread.
+    void run(const std::atomic_bool &shutdown);
+
+private:
+    struct State;
+    std::unique_ptr<State> m_state;
+};
+
+} // namespace t2d::net
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/runtime/huge_pages.hpp"
+
+#include "common/logger.hpp"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace t2d::runtime {
+
+namespace {
+
+// Precedes every block handed out (also the malloc'd ones, so deallocate never has to guess).
+struct BlockHeader
+{
+    uint32_t kind; // size class index, kSystem or kMapped
+    uint32_t lead; // block start -> payload
+    uint64_t bytes; // block / mapping length
+};
+static_assert(sizeof(BlockHeader) == 16);
+
+constexpr uint32_t kSystem = 0xFFFFFFFEu;
+constexpr uint32_t kMapped = 0xFFFFFFFFu;
+constexpr size_t kMaxPooledAlign = 64; // class blocks start on 64 B boundaries
+
+size_t round_up(size_t v, size_t to)
+{
+    return (v + to - 1) / to * to;
+}
+
+BlockHeader *header_of(void *payload)
+{
+    return static_cast<BlockHeader *>(payload) - 1;
+}
+
+void *finish(char *start, size_t lead, uint32_t kind, uint64_t bytes)
+{
+    auto *payload = start + lead;
+    *header_of(payload) = BlockHeader{kind, static_cast<uint32_t>(lead), bytes};
+    return payload;
+}
+
+bool thp_enabled()
+{
+    std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string line;
+    return std::getline(in, line) && line.find("[never]") == std::string::npos;
+}
+
+HugePageBacking weaker(HugePageBacking a, HugePageBacking b)
+{
+    return static_cast<int>(a) < static_cast<int>(b) ? a : b;
+}
+
+} // namespace
+
+bool parse_huge_page_mode(const std::string &text, HugePageMode &out)
+{
+    if (text == "off")
+        out = HugePageMode::Off;
+    else if (text == "thp")
+        out = HugePageMode::Transparent;
+    else if (text == "hugetlb")
+        out = HugePageMode::HugeTlb;
+    else
+        return false;
+    return true;
+}
+
+const char *mode_name(HugePageMode mode)
+{
+    switch (mode) {
+        case HugePageMode::Off:
+            return "off";
+        case HugePageMode::Transparent:
+            return "thp";
+        case HugePageMode::HugeTlb:
+            return "hugetlb";
+    }
+    return "?";
+}
+
+const char *backing_name(HugePageBacking backing)
+{
+    switch (backing) {
+        case HugePageBacking::Normal:
+            return "normal";
+        case HugePageBacking::Transparent:
+            return "thp";
+        case HugePageBacking::HugeTlb:
+            return "hugetlb";
+    }
+    return "?";
+}
+
+HugeRegion map_huge_region(size_t bytes, HugePageMode mode, bool prefault)
+{
+    HugeRegion r;
+    if (mode == HugePageMode::Off || bytes == 0)
+        return r;
+    const size_t len = round_up(bytes, kHugePageSize);
+    if (mode == HugePageMode::HugeTlb) {
+        // Fails with ENOMEM when the reserved pool is short: no overcommit, no SIGBUS later.
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (prefault ? MAP_POPULATE : 0);
+        void *p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (p != MAP_FAILED) {
+            r.base = p;
+            r.bytes = len;
+            r.backing = HugePageBacking::HugeTlb;
+            return r;
+        }
+    }
+    // THP only promotes 2 MiB aligned ranges: over-map by one huge page and trim both ends.
+    const size_t span = len + kHugePageSize;
+    void *raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+        return r;
+    const auto raw_addr = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t start = round_up(raw_addr, kHugePageSize);
+    const size_t head = start - raw_addr;
+    const size_t tail = span - head - len;
+    if (head)
+        ::munmap(raw, head);
+    if (tail)
+        ::munmap(reinterpret_cast<void *>(start + len), tail);
+    r.base = reinterpret_cast<void *>(start);
+    r.bytes = len;
+    const bool advised = ::madvise(r.base, len, MADV_HUGEPAGE) == 0;
+    r.backing = advised && thp_enabled() ? HugePageBacking::Transparent : HugePageBacking::Normal;
+    if (prefault) {
+        auto *p = static_cast<volatile char *>(r.base);
+        for (size_t off = 0; off < len; off += kHugePageSize)
+            p[off] = 0;
+    }
+    return r;
+}
+
+void unmap_huge_region(HugeRegion &region)
+{
+    if (region.base)
+        ::munmap(region.base, region.bytes);
+    region = HugeRegion{};
+}
+
+HugePageHeap &HugePageHeap::instance()
+{
+    static HugePageHeap heap;
+    return heap;
+}
+
+bool HugePageHeap::configure(HugePageMode mode, size_t region_bytes, bool prefault)
+{
+    std::lock_guard lk(m_mutex);
+    if (m_used)
+        return false;
+    m_mode.store(mode, std::memory_order_relaxed);
+    m_region_bytes = round_up(std::max(region_bytes, kHugePageSize), kHugePageSize);
+    m_prefault = prefault;
+    m_stats.mode = mode;
+    m_stats.backing = mode == HugePageMode::HugeTlb ? HugePageBacking::HugeTlb
+        : mode == HugePageMode::Transparent         ? HugePageBacking::Transparent
+                                                    : HugePageBacking::Normal;
+    return true;
+}
+
+// Bump-allocates a class block; maps the next region when the current one is exhausted (its tail is abandoned).
+void *HugePageHeap::carve(size_t block_bytes)
+{
+    if (m_cursor == nullptr || static_cast<size_t>(m_limit - m_cursor) < block_bytes) {
+        HugeRegion r = map_huge_region(m_region_bytes, m_mode.load(), m_prefault);
+        if (!r.base)
+            return nullptr;
+        if (r.backing != m_stats.backing && m_stats.regions == 0)
+            t2d::log::warn(
+                "[hugepages] {} requested, regions backed by {} (check vm.nr_hugepages / transparent_hugepage)",
+                mode_name(m_mode.load()),
+                backing_name(r.backing));
+        m_stats.backing = weaker(m_stats.backing, r.backing);
+        m_stats.reserved_bytes += r.bytes;
+        ++m_stats.regions;
+        m_regions.push_back(r);
+        m_cursor = static_cast<char *>(r.base);
+        m_limit = m_cursor + r.bytes;
+    }
+    void *block = m_cursor;
+    m_cursor += block_bytes;
+    return block;
+}
+
+void *HugePageHeap::allocate(size_t bytes, size_t align)
+{
+    align = std::max(align, alignof(BlockHeader));
+    const size_t lead = round_up(sizeof(BlockHeader), align);
+    const size_t need = lead + std::max<size_t>(bytes, 1);
+    if (enabled()) {
+        std::lock_guard lk(m_mutex);
+        m_used = true;
+        if (align <= kMaxPooledAlign && need <= (size_t{1} << kMaxClassShift)) {
+            const size_t shift = std::max<size_t>(std::bit_width(need - 1), kMinClassShift);
+            const auto cls = static_cast<uint32_t>(shift - kMinClassShift);
+            const size_t block_bytes = size_t{1} << shift;
+            void *block = m_free[cls];
+            if (block)
+                m_free[cls] = *static_cast<void **>(block);
+            else
+                block = carve(block_bytes);
+            if (block) {
+                m_stats.in_use_bytes += block_bytes;
+                return finish(static_cast<char *>(block), lead, cls, block_bytes);
+            }
+        } else if (align <= kMaxPooledAlign) {
+            HugeRegion r = map_huge_region(need, m_mode.load(), false);
+            if (r.base) {
+                m_stats.backing = weaker(m_stats.backing, r.backing);
+                m_stats.reserved_bytes += r.bytes;
+                m_stats.in_use_bytes += r.bytes;
+                return finish(static_cast<char *>(r.base), lead, kMapped, r.bytes);
+            }
+        }
+        ++m_stats.system_allocations;
+    }
+    void *raw = std::aligned_alloc(align, round_up(need, align));
+    if (!raw)
+        throw std::bad_alloc();
+    return finish(static_cast<char *>(raw), lead, kSystem, need);
+}
+
+void HugePageHeap::deallocate(void *p) noexcept
+{
+    if (!p)
+        return;
+    const BlockHeader h = *header_of(p);
+    char *start = static_cast<char *>(p) - h.lead;
+    if (h.kind == kSystem) {
+        std::free(start);
+        return;
+    }
+    std::lock_guard lk(m_mutex);
+    m_stats.in_use_bytes -= h.bytes;
+    if (h.kind == kMapped) {
+        m_stats.reserved_bytes -= h.bytes;
+        ::munmap(start, h.bytes);
+        return;
+    }
+    *reinterpret_cast<void **>(start) = m_free[h.kind];
+    m_free[h.kind] = start;
+}
+
+HugePageStats HugePageHeap::stats() const
+{
+    std::lock_guard lk(m_mutex);
+    return m_stats;
+}
+
+uint64_t resident_huge_page_bytes()
+{
+    std::ifstream in("/proc/self/smaps_rollup");
+    std::string line;
+    uint64_t kb = 0;
+    while (std::getline(in, line)) {
+        for (const char *key : {"AnonHugePages:", "Private_Hugetlb:", "Shared_Hugetlb:"}) {
+            const size_t n = std::strlen(key);
+            if (line.compare(0, n, key) == 0)
+                kb += std::strtoull(line.c_str() + n, nullptr, 10);
+        }
+    }
+    return kb * 1024;
+}
+
+} // namespace t2d::runtime
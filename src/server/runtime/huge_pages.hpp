@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+// huge_pages.hpp - 2 MiB page backing for the per-tick hot memory: Box2D world storage (installed as Box2D's allocator)
+// and the match entity arrays (HotVector). A busy server steps hundreds of small worlds per second; on 4 KiB pages
+// their bodies, contacts and islands span thousands of TLB entries.
+//
+// Backing is chosen once at startup and degrades step by step:
+//   hugetlb - MAP_HUGETLB from the reserved pool (vm.nr_hugepages); falls back to thp when the pool is short
+//   thp     - 2 MiB aligned anonymous mapping + madvise(MADV_HUGEPAGE); needs transparent_hugepage != never
+//   off     - plain operator new / malloc (default)
+// Regions are carved by a size-class heap; blocks are never returned to the kernel while the process runs (matches
+// come and go, their freed blocks serve the next one).
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace t2d::runtime {
+
+enum class HugePageMode
+{
+    Off,
+    Transparent,
+    HugeTlb
+};
+
+// What a region actually got from the kernel.
+enum class HugePageBacking
+{
+    Normal, // 4 KiB pages (madvise refused / THP disabled) or plain malloc
+    Transparent, // THP eligible (khugepaged / fault path may still hand out small pages under fragmentation)
+    HugeTlb // reserved huge pages
+};
+
+constexpr size_t kHugePageSize = 2u << 20;
+
+// "off" | "thp" | "hugetlb". Returns false (mode untouched) for anything else.
+bool parse_huge_page_mode(const std::string &text, HugePageMode &out);
+const char *mode_name(HugePageMode mode);
+const char *backing_name(HugePageBacking backing);
+
+struct HugeRegion
+{
+    void *base{nullptr};
+    size_t bytes{0};
+    HugePageBacking backing{HugePageBacking::Normal};
+};
+
+// Maps bytes (rounded up to kHugePageSize) following the mode's fallback chain. prefault touches every huge page so
+// the first tick using the memory does not pay the fault (and zeroing) of a 2 MiB page. base is null on failure.
+HugeRegion map_huge_region(size_t bytes, HugePageMode mode, bool prefault);
+void unmap_huge_region(HugeRegion &region);
+
+struct HugePageStats
+{
+    HugePageMode mode{HugePageMode::Off};
+    HugePageBacking backing{HugePageBacking::Normal}; // weakest backing among the regions mapped so far
+    uint64_t regions{0};
+    uint64_t reserved_bytes{0}; // mapped for the heap (regions + dedicated large blocks)
+    uint64_t in_use_bytes{0}; // handed out (block sizes, including headers)
+    uint64_t system_allocations{0}; // served by malloc while enabled: alignment > 64 or mapping failed
+};
+
+// Process-wide heap over huge page regions. Thread-safe (one mutex: allocations on the tick path are rare once
+// the vectors reached their steady capacity and Box2D's own block/stack allocators are warm).
+class HugePageHeap
+{
+public:
+    static HugePageHeap &instance();
+
+    // Takes effect only before the first allocation; later calls are ignored and return false. region_bytes is the
+    // growth step (rounded up to kHugePageSize).
+    bool configure(HugePageMode mode, size_t region_bytes, bool prefault = true);
+
+    bool enabled() const { return m_mode.load(std::memory_order_relaxed) != HugePageMode::Off; }
+
+    // align <= 64 is served from the regions; anything larger (and everything while disabled) from the system
+    // allocator. Never returns null (throws std::bad_alloc like operator new).
+    void *allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+    void deallocate(void *p) noexcept;
+
+    HugePageStats stats() const;
+
+    static constexpr size_t kMinClassShift = 6; // 64 B
+    static constexpr size_t kMaxClassShift = 20; // 1 MiB; larger blocks get a dedicated mapping
+    static constexpr size_t kClasses = kMaxClassShift - kMinClassShift + 1;
+
+private:
+    HugePageHeap() = default;
+
+    void *carve(size_t block_bytes);
+
+    mutable std::mutex m_mutex;
+    std::atomic<HugePageMode> m_mode{HugePageMode::Off}; // written under m_mutex before first use
+    size_t m_region_bytes{32u << 20};
+    bool m_prefault{true};
+    bool m_used{false};
+    std::vector<HugeRegion> m_regions;
+    char *m_cursor{nullptr};
+    char *m_limit{nullptr};
+    void *m_free[kClasses]{};
+    HugePageStats m_stats;
+};
+
+// Standard allocator over the process heap: std::vector<T, HugePageAllocator<T>> keeps its element storage on huge
+// pages when the heap is enabled and behaves like std::allocator otherwise.
+template <class T> struct HugePageAllocator
+{
+    using value_type = T;
+
+    HugePageAllocator() noexcept = default;
+    template <class U> HugePageAllocator(const HugePageAllocator<U> &) noexcept { }
+
+    T *allocate(size_t n)
+    {
+        if (n > static_cast<size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast<T *>(HugePageHeap::instance().allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, size_t) noexcept { HugePageHeap::instance().deallocate(p); }
+
+    template <class U> bool operator==(const HugePageAllocator<U> &) const noexcept { return true; }
+};
+
+// Per-tick entity arrays of a match.
+template <class T> using HotVector = std::vector<T, HugePageAllocator<T>>;
+
+// Bytes of this process currently on huge pages (AnonHugePages + Private_Hugetlb from /proc/self/smaps_rollup);
+// 0 when unavailable.
+uint64_t resident_huge_page_bytes();
+
+} // namespace t2d::runtime
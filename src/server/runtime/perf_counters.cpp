@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/runtime/perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+namespace t2d::runtime {
+
+namespace {
+
+void describe(PerfEvent event, perf_event_attr &attr)
+{
+    switch (event) {
+        case PerfEvent::Cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            return;
+        case PerfEvent::Instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            return;
+        case PerfEvent::DtlbLoadMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            return;
+        case PerfEvent::DtlbStoreMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_WRITE << 8)
+                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            return;
+        case PerfEvent::LlcMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            return;
+        case PerfEvent::BranchMisses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            return;
+    }
+}
+
+} // namespace
+
+const char *event_name(PerfEvent event)
+{
+    switch (event) {
+        case PerfEvent::Cycles:
+            return "cycles";
+        case PerfEvent::Instructions:
+            return "instructions";
+        case PerfEvent::DtlbLoadMisses:
+            return "dtlb_load_misses";
+        case PerfEvent::DtlbStoreMisses:
+            return "dtlb_store_misses";
+        case PerfEvent::LlcMisses:
+            return "llc_misses";
+        case PerfEvent::BranchMisses:
+            return "branch_misses";
+    }
+    return "?";
+}
+
+PerfCounterGroup::~PerfCounterGroup()
+{
+    close();
+}
+
+size_t PerfCounterGroup::open(std::span<const PerfEvent> events)
+{
+    close();
+    m_fds.assign(events.size(), -1);
+    for (size_t i = 0; i < events.size() && i < kMaxEvents; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        describe(events[i], attr);
+        attr.disabled = m_leader < 0 ? 1 : 0; // members follow the leader
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0));
+        if (fd < 0) {
+            if (m_errno == 0)
+                m_errno = errno;
+            continue;
+        }
+        if (m_leader < 0)
+            m_leader = fd;
+        m_fds[i] = fd;
+        ++m_opened;
+    }
+    return m_opened;
+}
+
+void PerfCounterGroup::close()
+{
+    for (int fd : m_fds) {
+        if (fd >= 0)
+            ::close(fd);
+    }
+    m_fds.clear();
+    m_leader = -1;
+    m_opened = 0;
+    m_errno = 0;
+}
+
+void PerfCounterGroup::start()
+{
+    if (m_leader < 0)
+        return;
+    ::ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounterGroup::stop()
+{
+    if (m_leader >= 0)
+        ::ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+bool PerfCounterGroup::read(std::vector<uint64_t> &values, std::vector<bool> &available) const
+{
+    values.assign(m_fds.size(), 0);
+    available.assign(m_fds.size(), false);
+    if (m_leader < 0)
+        return false;
+    // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then one value per member in open order.
+    std::array<uint64_t, 3 + kMaxEvents> buf{};
+    const ssize_t n = ::read(m_leader, buf.data(), (3 + m_opened) * sizeof(uint64_t));
+    if (n < static_cast<ssize_t>(3 * sizeof(uint64_t)) || buf[2] == 0)
+        return false; // never scheduled on the PMU (group too large for the available counters)
+    const double scale = static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+    size_t member = 0;
+    for (size_t i = 0; i < m_fds.size() && member < buf[0]; ++i) {
+        if (m_fds[i] < 0)
+            continue;
+        values[i] = static_cast<uint64_t>(static_cast<double>(buf[3 + member]) * scale);
+        available[i] = true;
+        ++member;
+    }
+    return true;
+}
+
+bool PerfCounterGroup::read_raw(std::span<uint64_t> values) const
+{
+    std::fill(values.begin(), values.end(), 0);
+    if (m_leader < 0)
+        return false;
+    std::array<uint64_t, 3 + kMaxEvents> buf{};
+    const ssize_t n = ::read(m_leader, buf.data(), (3 + m_opened) * sizeof(uint64_t));
+    if (n < static_cast<ssize_t>(3 * sizeof(uint64_t)) || buf[2] == 0)
+        return false;
+    size_t member = 0;
+    for (size_t i = 0; i < m_fds.size() && i < values.size() && member < buf[0]; ++i) {
+        if (m_fds[i] < 0)
+            continue;
+        values[i] = buf[3 + member];
+        ++member;
+    }
+    return true;
+}
+
+} // namespace t2d::runtime
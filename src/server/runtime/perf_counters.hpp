@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0
+// perf_counters.hpp - hardware counters of the calling thread via perf_event_open (Linux), opened as one group so
+// all events cover exactly the same instructions. Counts user space only, which works with the default
+// perf_event_paranoid=2. Containers and VMs often expose no PMU: open() then reports zero events and callers fall
+// back to wall time.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace t2d::runtime {
+
+enum class PerfEvent
+{
+    Cycles,
+    Instructions,
+    DtlbLoadMisses,
+    DtlbStoreMisses,
+    LlcMisses, // last level cache misses (the generic cache-misses event)
+    BranchMisses
+};
+
+const char *event_name(PerfEvent event);
+
+class PerfCounterGroup
+{
+public:
+    static constexpr size_t kMaxEvents = 8;
+
+    PerfCounterGroup() = default;
+    ~PerfCounterGroup();
+    PerfCounterGroup(const PerfCounterGroup &) = delete;
+    PerfCounterGroup &operator=(const PerfCounterGroup &) = delete;
+
+    // Opens the events for the calling thread (disabled). Events the kernel refuses are skipped, as are events past
+    // kMaxEvents; returns how many were opened. The first failure's errno is kept in last_error().
+    size_t open(std::span<const PerfEvent> events);
+    void close();
+
+    size_t opened() const { return m_opened; }
+    bool available(size_t i) const { return i < m_fds.size() && m_fds[i] >= 0; }
+    int last_error() const { return m_errno; }
+
+    void start(); // reset + enable
+    void stop();
+
+    // Values index-aligned with the events passed to open(), scaled up when the kernel multiplexed the group;
+    // unavailable events read 0 and have available[i] == false. Returns false when nothing could be read.
+    bool read(std::vector<uint64_t> &values, std::vector<bool> &available) const;
+    // Running totals without multiplex scaling and without allocating, for reading a group that stays enabled at
+    // many points (deltas between two reads are what matters; the group is scheduled on the PMU as a whole, so all
+    // members pause together). values must hold one slot per requested event; unavailable events read 0.
+    bool read_raw(std::span<uint64_t> values) const;
+
+private:
+    int m_leader{-1};
+    std::vector<int> m_fds; // per requested event, -1 = unavailable
+    size_t m_opened{0};
+    int m_errno{0};
+};
+
+} // namespace t2d::runtime
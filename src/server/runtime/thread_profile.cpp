@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "server/runtime/thread_profile.hpp"
+
+#include "common/logger.hpp"
+
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace t2d::runtime {
+
+bool parse_cpu_list(const std::string &list, cpu_set_t &out)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::stringstream ss(list);
+    std::string part;
+    bool any = false;
+    while (std::getline(ss, part, ',')) {
+        part.erase(std::remove_if(part.begin(), part.end(), [](char c) { return c == ' ' || c == '\t'; }), part.end());
+        if (part.empty())
+            continue;
+        unsigned long lo = 0, hi = 0;
+        char *end = nullptr;
+        errno = 0;
+        lo = std::strtoul(part.c_str(), &end, 10);
+        if (end == part.c_str() || errno != 0)
+            return false;
+        hi = lo;
+        if (*end == '-') {
+            const char *rest = end + 1;
+            hi = std::strtoul(rest, &end, 10);
+            if (end == rest || errno != 0)
+                return false;
+        }
+        if (*end != '\0' || hi < lo || hi >= CPU_SETSIZE)
+            return false;
+        for (unsigned long c = lo; c <= hi; ++c)
+            CPU_SET(c, &set);
+        any = true;
+    }
+    if (!any)
+        return false;
+    out = set;
+    return true;
+}
+
+const char *role_name(ThreadRole role)
+{
+    switch (role) {
+        case ThreadRole::Simulation:
+            return "simulation";
+        case ThreadRole::Network:
+            return "network";
+        case ThreadRole::Logger:
+            return "logger";
+        case ThreadRole::Metrics:
+            return "metrics";
+    }
+    return "?";
+}
+
+static const std::string &cpu_list(ThreadRole role, const ThreadProfile &p)
+{
+    switch (role) {
+        case ThreadRole::Simulation:
+            return p.sim_cpus;
+        case ThreadRole::Network:
+            return p.net_cpus;
+        case ThreadRole::Logger:
+            return p.logger_cpus;
+        case ThreadRole::Metrics:
+            break;
+    }
+    return p.metrics_cpus;
+}
+
+// One warning per role: pool threads all fail the same way (missing capability, offline CPU).
+static void report_failures(ThreadRole role, const std::string &name, const std::string &why)
+{
+    static std::array<std::atomic_bool, 4> warned{};
+    if (!warned[static_cast<size_t>(role)].exchange(true))
+        t2d::log::warn("[thread] {} ({}): {}", name, role_name(role), why);
+}
+
+static void note(std::string &why, const char *what, int err)
+{
+    if (!why.empty())
+        why += "; ";
+    why += what;
+    why += ": ";
+    why += std::strerror(err);
+}
+
+// NUMA node of a CPU from sysfs (the cpuN directory holds a nodeK link); -1 when unknown / not NUMA.
+static int cpu_node(int cpu)
+{
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/sys/devices/system/cpu/cpu" + std::to_string(cpu), ec);
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        const std::string n = it->path().filename().string();
+        if (n.size() <= 4 || n.compare(0, 4, "node") != 0)
+            continue;
+        if (std::all_of(n.begin() + 4, n.end(), [](unsigned char c) { return std::isdigit(c) != 0; }))
+            return std::stoi(n.substr(4));
+    }
+    return -1;
+}
+
+// Thread memory policy: prefer the node of the first CPU in the set (first-touch still applies when it is full).
+static int prefer_local_node(const cpu_set_t &set)
+{
+    int node = -1;
+    for (int c = 0; c < CPU_SETSIZE && node < 0; ++c) {
+        if (CPU_ISSET(c, &set))
+            node = cpu_node(c);
+    }
+    if (node < 0)
+        return 0; // single-node host: nothing to do
+    constexpr int kBits = 8 * sizeof(unsigned long);
+    std::array<unsigned long, 16> mask{};
+    if (node >= static_cast<int>(mask.size()) * kBits)
+        return EINVAL;
+    mask[static_cast<size_t>(node / kBits)] |= 1UL << (node % kBits);
+    if (::syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), mask.size() * kBits) != 0)
+        return errno;
+    return 0;
+}
+
+static void set_name(pthread_t handle, const std::string &name)
+{
+    ::pthread_setname_np(handle, name.substr(0, 15).c_str());
+}
+
+static int set_fifo(pthread_t handle, int priority, std::string &why)
+{
+    sched_param sp{};
+    sp.sched_priority = std::clamp(priority, 1, 99);
+    int rc = ::pthread_setschedparam(handle, SCHED_FIFO, &sp);
+    if (rc != 0) {
+        note(why, "SCHED_FIFO", rc);
+        return 1;
+    }
+    return 0;
+}
+
+int apply_current_thread(ThreadRole role, const ThreadProfile &profile, const std::string &name)
+{
+    const pthread_t self = ::pthread_self();
+    set_name(self, name);
+    int failed = 0;
+    std::string why;
+    cpu_set_t set;
+    const auto &cpus = cpu_list(role, profile);
+    const bool have_set = !cpus.empty() && parse_cpu_list(cpus, set);
+    if (!cpus.empty() && !have_set) {
+        ++failed;
+        note(why, "cpu list", EINVAL);
+    } else if (have_set) {
+        int rc = ::pthread_setaffinity_np(self, sizeof(set), &set);
+        if (rc != 0) {
+            ++failed;
+            note(why, "affinity", rc);
+        }
+    }
+    if (role == ThreadRole::Simulation) {
+        if (profile.sim_fifo_priority > 0) {
+            failed += set_fifo(self, profile.sim_fifo_priority, why);
+        } else if (profile.sim_nice != 0) {
+            const auto tid = static_cast<id_t>(::syscall(SYS_gettid));
+            if (::setpriority(PRIO_PROCESS, tid, profile.sim_nice) != 0) {
+                ++failed;
+                note(why, "nice", errno);
+            }
+        }
+        if (profile.sim_numa_local && have_set) {
+            int rc = prefer_local_node(set);
+            if (rc != 0) {
+                ++failed;
+                note(why, "numa policy", rc);
+            }
+        }
+    }
+    if (failed)
+        report_failures(role, name, why);
+    return failed;
+}
+
+int apply_thread(std::thread &thread, ThreadRole role, const ThreadProfile &profile, const std::string &name)
+{
+    if (!thread.joinable())
+        return 0;
+    const pthread_t handle = thread.native_handle();
+    set_name(handle, name);
+    int failed = 0;
+    std::string why;
+    const auto &cpus = cpu_list(role, profile);
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        int rc = parse_cpu_list(cpus, set) ? ::pthread_setaffinity_np(handle, sizeof(set), &set) : EINVAL;
+        if (rc != 0) {
+            ++failed;
+            note(why, "affinity", rc);
+        }
+    }
+    if (role == ThreadRole::Simulation && profile.sim_fifo_priority > 0)
+        failed += set_fifo(handle, profile.sim_fifo_priority, why);
+    if (failed)
+        report_failures(role, name, why);
+    return failed;
+}
+
+std::vector<ThreadStats> collect_thread_stats()
+{
+    std::vector<ThreadStats> out;
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/proc/self/task", ec);
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        ThreadStats st;
+        const auto dir = it->path();
+        st.tid = std::atoi(dir.filename().c_str());
+        if (st.tid <= 0)
+            continue;
+        std::ifstream comm(dir / "comm");
+        std::getline(comm, st.name);
+        std::ifstream status(dir / "status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 24, "voluntary_ctxt_switches:") == 0)
+                st.voluntary_switches = std::strtoull(line.c_str() + 24, nullptr, 10);
+            else if (line.compare(0, 27, "nonvoluntary_ctxt_switches:") == 0)
+                st.nonvoluntary_switches = std::strtoull(line.c_str() + 27, nullptr, 10);
+        }
+        // stat: "tid (comm) state ..." - processor is field 39, i.e. the 37th after the closing parenthesis.
+        std::ifstream stat(dir / "stat");
+        std::string s((std::istreambuf_iterator<char>(stat)), std::istreambuf_iterator<char>());
+        auto rp = s.rfind(')');
+        if (rp != std::string::npos) {
+            std::istringstream fields(s.substr(rp + 2));
+            std::string f;
+            for (int i = 0; i < 37 && fields >> f; ++i) {
+                if (i == 36)
+                    st.last_cpu = std::atoi(f.c_str());
+            }
+        }
+        out.push_back(std::move(st));
+    }
+    std::sort(out.begin(), out.end(), [](const ThreadStats &a, const ThreadStats &b) { return a.tid < b.tid; });
+    return out;
+}
+
+} // namespace t2d::runtime
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+// thread_profile.hpp - CPU placement and scheduling class for the server's threads, plus per-thread scheduler
+// statistics (context switches) read from /proc so the effect of isolation can be measured.
+//
+// Roles map onto the threads the server actually runs:
+//   Simulation - libcoro worker pool: match ticks, matchmaker and the epoll listener's coroutines
+//   Network    - libcoro I/O thread (epoll wait / timers) and the io_uring listener thread
+//   Logger     - asynchronous log writer
+//   Metrics    - main thread (periodic runtime report; resource sampling happens on the pool)
+#pragma once
+#include <sched.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace t2d::runtime {
+
+enum class ThreadRole
+{
+    Simulation,
+    Network,
+    Logger,
+    Metrics
+};
+
+struct ThreadProfile
+{
+    // CPU lists per role ("2-3,6"; empty = inherit the process affinity).
+    std::string sim_cpus;
+    std::string net_cpus;
+    std::string logger_cpus;
+    std::string metrics_cpus;
+    int sim_fifo_priority{0}; // 1..99 = SCHED_FIFO for simulation threads (CAP_SYS_NICE / RLIMIT_RTPRIO), 0 = off
+    int sim_nice{0}; // nice value for simulation threads when not FIFO (negative needs CAP_SYS_NICE), 0 = unchanged
+    bool sim_numa_local{false}; // prefer allocations from the NUMA node(s) of sim_cpus on simulation threads
+
+    bool any() const
+    {
+        return !sim_cpus.empty() || !net_cpus.empty() || !logger_cpus.empty() || !metrics_cpus.empty()
+            || sim_fifo_priority > 0 || sim_nice != 0 || sim_numa_local;
+    }
+};
+
+// Parses a Linux CPU list ("0-3,8,10-11"). Returns false (set untouched) on syntax errors or ids >= CPU_SETSIZE.
+bool parse_cpu_list(const std::string &list, cpu_set_t &out);
+
+const char *role_name(ThreadRole role);
+
+// Applies the role's settings to the calling thread and names it (name truncated to 15 characters). Failures are
+// logged once per role and leave the thread running with what the kernel accepted. Returns the number of failed
+// settings.
+int apply_current_thread(ThreadRole role, const ThreadProfile &profile, const std::string &name);
+
+// Same for a thread that cannot run code for us (e.g. the logger's writer): name, affinity and SCHED_FIFO only
+// (nice and memory policy are per-task settings the thread has to make itself).
+int apply_thread(std::thread &thread, ThreadRole role, const ThreadProfile &profile, const std::string &name);
+
+struct ThreadStats
+{
+    int tid{0};
+    std::string name; // /proc comm
+    uint64_t voluntary_switches{0}; // blocked / slept
+    uint64_t nonvoluntary_switches{0}; // preempted while runnable: scheduler noise
+    int last_cpu{-1};
+};
+
+// Every thread of this process (Linux /proc/self/task; empty elsewhere).
+std::vector<ThreadStats> collect_thread_stats();
+
+} // namespace t2d::runtime
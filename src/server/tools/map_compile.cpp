@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// t2d_map_compile - converts a YAML map description into the binary map image loaded by the server (map_path).
+// Usage: t2d_map_compile <input.yaml> <output.t2dmap>
+// Input keys: tile_size (float), tiles (rows top-to-bottom, '#' = wall, anything else = floor),
+// spawns / crates / ammo (lists of [x, y, angle_deg | half_extent | radius]).
+#include "server/game/map_format.hpp"
+
+#include <yaml-cpp/yaml.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        std::cerr << "usage: t2d_map_compile <input.yaml> <output.t2dmap>\n";
+        return 2;
+    }
+    t2d::map::MapSource src;
+    try {
+        YAML::Node root = YAML::LoadFile(argv[1]);
+        if (root["tile_size"])
+            src.tile_size = root["tile_size"].as<float>();
+        std::vector<std::string> rows;
+        for (const auto &r : root["tiles"])
+            rows.push_back(r.as<std::string>());
+        if (rows.empty() || rows.size() > 0xFFFF || rows.front().empty() || rows.front().size() > 0xFFFF) {
+            std::cerr << "tiles: expected a non-empty list of equal-length rows\n";
+            return 1;
+        }
+        src.tiles_x = static_cast<uint16_t>(rows.front().size());
+        src.tiles_y = static_cast<uint16_t>(rows.size());
+        src.tiles.resize(static_cast<size_t>(src.tiles_x) * src.tiles_y);
+        for (size_t r = 0; r < rows.size(); ++r) {
+            if (rows[r].size() != src.tiles_x) {
+                std::cerr << "tiles: row " << r << " has length " << rows[r].size() << " expected " << src.tiles_x
+                          << "\n";
+                return 1;
+            }
+            // YAML lists rows top-to-bottom; the binary grid stores row 0 at the bottom.
+            size_t ty = rows.size() - 1 - r;
+            for (size_t tx = 0; tx < rows[r].size(); ++tx)
+                src.tiles[ty * src.tiles_x + tx] = rows[r][tx] == '#' ? t2d::map::TILE_WALL : t2d::map::TILE_FLOOR;
+        }
+        for (const auto &n : root["spawns"])
+            src.spawns.push_back({n[0].as<float>(), n[1].as<float>(), n.size() > 2 ? n[2].as<float>() : 0.f});
+        for (const auto &n : root["crates"])
+            src.crates.push_back({n[0].as<float>(), n[1].as<float>(), n.size() > 2 ? n[2].as<float>() : 1.2f});
+        for (const auto &n : root["ammo"])
+            src.ammo.push_back({n[0].as<float>(), n[1].as<float>(), n.size() > 2 ? n[2].as<float>() : 0.9f});
+    } catch (const std::exception &ex) {
+        std::cerr << "failed to read " << argv[1] << ": " << ex.what() << "\n";
+        return 1;
+    }
+    std::string image = t2d::map::compile_map(src);
+    if (image.empty()) {
+        std::cerr << "compile failed (malformed tile grid)\n";
+        return 1;
+    }
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    if (!out) {
+        std::cerr << "failed to write " << argv[2] << "\n";
+        return 1;
+    }
+    t2d::map::MapView v;
+    t2d::map::parse_map(image.data(), image.size(), v);
+    std::cout << "wrote " << argv[2] << " bytes=" << image.size() << " tiles=" << src.tiles_x << "x" << src.tiles_y
+              << " chains=" << v.chains.size() << " points=" << v.points.size() << " spawns=" << v.spawns.size()
+              << " crates=" << v.crates.size() << " ammo=" << v.ammo.size() << "\n";
+    return 0;
+}
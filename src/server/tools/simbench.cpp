@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: Apache-2.0
+// t2d_simbench - steps many small physics worlds round-robin (the shape of a busy server: one worker ticking
+// hundreds of matches) and compares 4 KiB pages against the huge page heap.
+// Usage: t2d_simbench [mode=thp] [worlds=96] [tanks=16] [ticks=600]   (worlds <= 128, Box2D's world limit)
+// mode is the huge page mode for the second pass (thp | hugetlb). Both passes build the same worlds from the same
+// seed; Box2D storage and the per-world entity mirror (a HotVector, like MatchContext's arrays) move to the heap in
+// the second pass. Reports wall time, IPC and dTLB load / store misses per world step from perf_event_open; counters
+// print as n/a where the kernel exposes no PMU (most containers, some VMs).
+#include "server/game/physics.hpp"
+#include "server/runtime/huge_pages.hpp"
+#include "server/runtime/perf_counters.hpp"
+
+#include <box2d/box2d.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using t2d::runtime::HugePageMode;
+using t2d::runtime::PerfEvent;
+
+namespace {
+
+constexpr float kDt = 1.f / 30.f;
+constexpr size_t kMaxWorlds = 128; // B2_MAX_WORLDS
+constexpr std::array<PerfEvent, 4> kEvents{
+    PerfEvent::Cycles, PerfEvent::Instructions, PerfEvent::DtlbLoadMisses, PerfEvent::DtlbStoreMisses};
+
+// What the snapshot pass reads back per tank every tick.
+struct EntityMirror
+{
+    uint32_t id;
+    float x;
+    float y;
+    float angle;
+};
+
+struct BenchWorld
+{
+    std::unique_ptr<t2d::phys::World> world;
+    t2d::runtime::HotVector<t2d::phys::TankWithTurret> tanks;
+    t2d::runtime::HotVector<EntityMirror> mirror;
+};
+
+struct PassResult
+{
+    double steps{0};
+    double ns_per_step{0};
+    bool counters{false};
+    std::vector<uint64_t> values; // totals over the measured ticks
+    std::vector<bool> available;
+
+    bool has(size_t i) const { return counters && available[i]; }
+    double per_step(size_t i) const { return static_cast<double>(values[i]) / steps; }
+};
+
+std::vector<BenchWorld> build(size_t worlds, size_t tanks)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> pos(-40.f, 40.f);
+    std::vector<BenchWorld> out(worlds);
+    for (auto &bw : out) {
+        bw.world = std::make_unique<t2d::phys::World>(b2Vec2{0.f, 0.f});
+        for (size_t i = 0; i < tanks; ++i)
+            bw.tanks.push_back(
+                t2d::phys::create_tank_with_turret(*bw.world, pos(rng), pos(rng), static_cast<uint32_t>(i + 1)));
+        for (size_t i = 0; i < tanks * 2; ++i)
+            t2d::phys::create_crate(*bw.world, pos(rng), pos(rng), 1.f);
+        bw.mirror.resize(tanks);
+    }
+    return out;
+}
+
+// One match tick: drive (steer back towards the centre so worlds keep colliding), step, mirror positions.
+void tick(BenchWorld &bw, uint32_t t)
+{
+    for (size_t i = 0; i < bw.tanks.size(); ++i) {
+        auto &tank = bw.tanks[i];
+        const b2Vec2 p = t2d::phys::get_body_position(tank.hull);
+        t2d::phys::TankDriveInput in;
+        in.drive_forward = 1.f;
+        in.turn = (p.x * p.x + p.y * p.y > 45.f * 45.f) ? 1.f : std::sin(0.05f * static_cast<float>(t + i * 7));
+        t2d::phys::apply_tracked_drive(in, tank, kDt);
+        t2d::phys::update_turret_aim({std::atan2(-p.y, -p.x)}, tank);
+    }
+    t2d::phys::step(*bw.world, kDt);
+    for (size_t i = 0; i < bw.tanks.size(); ++i) {
+        const b2Transform xf = b2Body_GetTransform(bw.tanks[i].hull);
+        bw.mirror[i] = {bw.tanks[i].entity_id, xf.p.x, xf.p.y, b2Rot_GetAngle(xf.q)};
+    }
+}
+
+PassResult run_pass(size_t worlds, size_t tanks, uint32_t ticks)
+{
+    auto set = build(worlds, tanks);
+    for (uint32_t t = 0; t < 30; ++t) { // warm-up: contact pairs, solver stacks and islands reach steady size
+        for (auto &bw : set)
+            tick(bw, t);
+    }
+    t2d::runtime::PerfCounterGroup counters;
+    counters.open(kEvents);
+    PassResult res;
+    counters.start();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < ticks; ++t) {
+        for (auto &bw : set)
+            tick(bw, 30 + t);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    counters.stop();
+    res.counters = counters.read(res.values, res.available);
+    res.steps = static_cast<double>(worlds) * ticks;
+    res.ns_per_step = std::chrono::duration<double, std::nano>(t1 - t0).count() / res.steps;
+    for (auto &bw : set)
+        b2DestroyWorld(bw.world->id);
+    return res;
+}
+
+std::string cell(const PassResult &r, size_t i, const char *fmt = "%.1f")
+{
+    if (!r.has(i))
+        return "n/a";
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), fmt, r.per_step(i));
+    return buf;
+}
+
+void print(const char *label, const char *backing, const PassResult &r)
+{
+    std::string ipc = "n/a";
+    if (r.has(0) && r.has(1) && r.values[0] > 0) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%.2f", static_cast<double>(r.values[1]) / static_cast<double>(r.values[0]));
+        ipc = buf;
+    }
+    std::printf(
+        "%-8s %-8s %10.0f %12s %6s %16s %16s\n",
+        label,
+        backing,
+        r.ns_per_step,
+        cell(r, 0, "%.0f").c_str(),
+        ipc.c_str(),
+        cell(r, 2).c_str(),
+        cell(r, 3).c_str());
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    HugePageMode mode = HugePageMode::Transparent;
+    const std::string mode_arg = argc > 1 ? argv[1] : "thp";
+    const size_t worlds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 96;
+    const size_t tanks = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 16;
+    const auto ticks = static_cast<uint32_t>(argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 600);
+    if (!t2d::runtime::parse_huge_page_mode(mode_arg, mode) || mode == HugePageMode::Off || worlds == 0
+        || worlds > kMaxWorlds || tanks == 0 || ticks == 0) {
+        std::cerr << "usage: t2d_simbench [mode=thp|hugetlb] [worlds=96 (max 128)] [tanks=16] [ticks=600]\n";
+        return 2;
+    }
+
+    std::printf(
+        "%zu worlds x %zu tanks (+%zu crates), %u ticks, round-robin on one thread; per world step:\n",
+        worlds,
+        tanks,
+        tanks * 2,
+        ticks);
+    std::printf(
+        "%-8s %-8s %10s %12s %6s %16s %16s\n",
+        "pass",
+        "backing",
+        "ns",
+        "cycles",
+        "ipc",
+        "dtlb_load_miss",
+        "dtlb_store_miss");
+
+    const PassResult base = run_pass(worlds, tanks, ticks);
+    print("4k", "normal", base);
+
+    auto &heap = t2d::runtime::HugePageHeap::instance();
+    heap.configure(mode, 64u << 20);
+    t2d::phys::use_huge_page_heap();
+    const PassResult huge = run_pass(worlds, tanks, ticks);
+    const auto st = heap.stats();
+    print(t2d::runtime::mode_name(mode), t2d::runtime::backing_name(st.backing), huge);
+
+    std::printf(
+        "heap: %llu region(s), %llu MiB reserved, %llu MiB resident on huge pages\n",
+        static_cast<unsigned long long>(st.regions),
+        static_cast<unsigned long long>(st.reserved_bytes >> 20),
+        static_cast<unsigned long long>(t2d::runtime::resident_huge_page_bytes() >> 20));
+    if (base.has(2) && huge.has(2) && base.values[2] > 0) {
+        std::printf("dTLB load misses: %.1f%% of the 4k pass\n", 100.0 * huge.per_step(2) / base.per_step(2));
+    } else {
+        std::printf("dTLB counters unavailable (perf_event_open refused or no PMU); compare wall time only\n");
+    }
+    return 0;
+}
@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: Apache-2.0
+// t2d_tls_bench - loopback throughput of the server egress path: plain TCP, userspace TLS (SSL_write) and kernel TLS
+// (send() on a socket whose record layer was handed to the kernel after the OpenSSL handshake).
+// Usage: t2d_tls_bench [mib=256] [chunk_bytes=16384]
+// chunk_bytes mimics one per-tick flush. Reports wall throughput and the sender thread's CPU time per MiB; the
+// receiver always decrypts in userspace so only the sender side differs between the TLS modes.
+#include "server/net/ktls.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <openssl/ssl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using t2d::net::TlsConfig;
+using t2d::net::TlsContext;
+using t2d::net::TlsStatus;
+using t2d::net::TlsStream;
+
+enum class Mode
+{
+    Plain,
+    Userspace,
+    Kernel
+};
+
+static const char *mode_name(Mode m)
+{
+    switch (m) {
+        case Mode::Plain:
+            return "plain";
+        case Mode::Userspace:
+            return "userspace-tls";
+        case Mode::Kernel:
+            return "ktls";
+    }
+    return "?";
+}
+
+static double thread_cpu_seconds()
+{
+    rusage ru{};
+    ::getrusage(RUSAGE_THREAD, &ru);
+    return static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec)
+        + static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+static void wait_fd(int fd, TlsStatus st)
+{
+    pollfd p{fd, static_cast<short>(st == TlsStatus::WantWrite ? POLLOUT : POLLIN), 0};
+    ::poll(&p, 1, 1000);
+}
+
+struct SendResult
+{
+    bool ok{false};
+    bool offloaded{true}; // kernel mode only: false when the kernel refused the TX offload
+    double cpu_s{0};
+};
+
+// Sender (server role): handshake when TLS, then push total bytes in chunk-sized writes.
+static SendResult send_side(int fd, Mode mode, const TlsContext *ctx, size_t total, size_t chunk)
+{
+    SendResult res;
+    std::string buf(chunk, 'x');
+    std::unique_ptr<TlsStream> tls;
+    if (mode != Mode::Plain) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        tls = std::make_unique<TlsStream>(*ctx, fd);
+        TlsStatus st;
+        while ((st = tls->handshake()) == TlsStatus::WantRead || st == TlsStatus::WantWrite)
+            wait_fd(fd, st);
+        if (st != TlsStatus::Ok)
+            return res;
+        if (mode == Mode::Kernel && !tls->ktls_send()) {
+            res.offloaded = false;
+            return res;
+        }
+    }
+    const bool userspace = mode == Mode::Userspace;
+    const double cpu0 = thread_cpu_seconds();
+    size_t sent = 0;
+    while (sent < total) {
+        size_t off = 0;
+        while (off < chunk) {
+            if (userspace) {
+                size_t n = 0;
+                TlsStatus st = tls->write(buf.data() + off, chunk - off, n);
+                if (st == TlsStatus::Ok)
+                    off += n;
+                else if (st == TlsStatus::WantRead || st == TlsStatus::WantWrite)
+                    wait_fd(fd, st);
+                else
+                    return res;
+            } else {
+                ssize_t w = ::send(fd, buf.data() + off, chunk - off, MSG_NOSIGNAL);
+                if (w > 0)
+                    off += static_cast<size_t>(w);
+                else if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    wait_fd(fd, TlsStatus::WantWrite);
+                else
+                    return res;
+            }
+        }
+        sent += chunk;
+    }
+    res.cpu_s = thread_cpu_seconds() - cpu0;
+    res.ok = true;
+    return res;
+}
+
+static void run_mode(Mode mode, const TlsContext *ctx, size_t total, size_t chunk)
+{
+    int lfd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t alen = sizeof(addr);
+    if (lfd < 0 || ::bind(lfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(lfd, 1) != 0
+        || ::getsockname(lfd, reinterpret_cast<sockaddr *>(&addr), &alen) != 0) {
+        std::cerr << "listen failed\n";
+        std::exit(1);
+    }
+    SendResult res;
+    std::thread sender([&] {
+        int fd = ::accept(lfd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        res = send_side(fd, mode, ctx, total, chunk);
+        ::close(fd);
+    });
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "connect failed\n";
+        std::exit(1);
+    }
+    SSL_CTX *cctx = nullptr;
+    SSL *ssl = nullptr;
+    if (mode != Mode::Plain) {
+        cctx = SSL_CTX_new(TLS_client_method());
+        ssl = SSL_new(cctx);
+        SSL_set_fd(ssl, fd);
+        if (SSL_connect(ssl) != 1) {
+            std::cerr << mode_name(mode) << ": handshake failed\n";
+            std::exit(1);
+        }
+    }
+    std::string rbuf(256 * 1024, '\0');
+    size_t got = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    while (got < total) {
+        size_t n = 0;
+        if (ssl) {
+            if (SSL_read_ex(ssl, rbuf.data(), rbuf.size(), &n) != 1)
+                break;
+        } else {
+            ssize_t r = ::recv(fd, rbuf.data(), rbuf.size(), 0);
+            if (r <= 0)
+                break;
+            n = static_cast<size_t>(r);
+        }
+        got += n;
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    SSL_free(ssl);
+    SSL_CTX_free(cctx);
+    ::close(fd);
+    sender.join();
+    ::close(lfd);
+
+    if (!res.offloaded) {
+        std::printf("%-14s unavailable (kernel refused TLS offload: tls module / cipher)\n", mode_name(mode));
+        return;
+    }
+    if (!res.ok || got < total) {
+        std::printf("%-14s failed after %zu bytes\n", mode_name(mode), got);
+        return;
+    }
+    const double mib = static_cast<double>(total) / (1024.0 * 1024.0);
+    std::printf("%-14s %9.1f MiB/s  sender cpu %7.3f ms/MiB\n", mode_name(mode), mib / wall, res.cpu_s * 1e3 / mib);
+}
+
+int main(int argc, char **argv)
+{
+    const size_t mib = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+    const size_t chunk = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 16384;
+    if (mib == 0 || chunk == 0) {
+        std::cerr << "usage: t2d_tls_bench [mib=256] [chunk_bytes=16384]\n";
+        return 2;
+    }
+    const size_t total = (mib * 1024 * 1024 / chunk) * chunk;
+
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string tag = std::to_string(::getpid());
+    const std::string cert = (dir / ("t2d_tls_bench_" + tag + ".crt")).string();
+    const std::string key = (dir / ("t2d_tls_bench_" + tag + ".key")).string();
+    if (!t2d::net::write_self_signed_cert(cert, key)) {
+        std::cerr << "cannot write self-signed certificate to " << dir << "\n";
+        return 1;
+    }
+    TlsConfig cfg;
+    cfg.cert_path = cert;
+    cfg.key_path = key;
+    auto kernel_ctx = TlsContext::create(cfg);
+    cfg.offer_ktls = false;
+    auto user_ctx = TlsContext::create(cfg);
+    std::remove(cert.c_str());
+    std::remove(key.c_str());
+    if (!kernel_ctx || !user_ctx)
+        return 1;
+
+    std::printf("%zu MiB in %zu-byte writes over loopback\n", total / (1024 * 1024), chunk);
+    run_mode(Mode::Plain, nullptr, total, chunk);
+    run_mode(Mode::Userspace, user_ctx.get(), total, chunk);
+    run_mode(Mode::Kernel, kernel_ctx.get(), total, chunk);
+    return 0;
+}
@@ -76,6 +76,12 @@ static coro::task<void> flow(std::shared_ptr<coro::io_scheduler> sched, uint16_t
                 gotMatch = true;
             else if (sm.has_damage() || sm.has_destroyed())
                 gotDamage = true;
+            else if (sm.has_tick_events() && sm.tick_events().damage_size() + sm.tick_events().destroyed_size() > 0)
+                gotDamage = true;
+            else if (sm.has_snapshot() && sm.snapshot().events().damage_size() > 0)
+                gotDamage = true;
+            else if (sm.has_delta_snapshot() && sm.delta_snapshot().events().damage_size() > 0)
+                gotDamage = true;
         }
     }
     assert(gotMatch && gotDamage);
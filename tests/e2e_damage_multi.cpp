@@ -80,6 +80,18 @@ static coro::task<void> flow(std::shared_ptr<coro::io_scheduler> sched, uint16_t
             } else if (sm.has_destroyed()) {
                 destroyed = true;
             }
+            const t2d::TickEvents *ev = nullptr;
+            if (sm.has_tick_events())
+                ev = &sm.tick_events();
+            else if (sm.has_snapshot())
+                ev = &sm.snapshot().events();
+            else if (sm.has_delta_snapshot())
+                ev = &sm.delta_snapshot().events();
+            if (ev) {
+                damageEvents += ev->damage_size();
+                if (ev->destroyed_size() > 0)
+                    destroyed = true;
+            }
         }
     }
     assert(gotMatch);
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: Apache-2.0
+// Headless match: the only human closes the connection after MatchStart; the match (default policy end) must notice
+// on its next tick through the closed connection, not the heartbeat timeout, and exit without the end grace period.
+#include "common/framing.hpp"
+#include "common/metrics.hpp"
+#include "game.pb.h"
+#include "server/matchmaking/matchmaker.hpp"
+#include "server/matchmaking/session_manager.hpp"
+#include "server/net/listener.hpp"
+
+#include <coro/coro.hpp>
+#include <coro/default_executor.hpp>
+#include <coro/io_scheduler.hpp>
+#include <coro/net/tcp/client.hpp>
+
+#include <cassert>
+#include <iostream>
+
+using namespace std::chrono_literals;
+
+static coro::task<bool> send_msg(coro::net::tcp::client &cli, const t2d::ClientMessage &msg)
+{
+    std::string payload;
+    msg.SerializeToString(&payload);
+    auto frame = t2d::netutil::build_frame(payload);
+    std::span<const char> rest(frame.data(), frame.size());
+    while (!rest.empty()) {
+        co_await cli.poll(coro::poll_op::write);
+        auto [s, r] = cli.send(rest);
+        if (s == coro::net::send_status::ok || s == coro::net::send_status::would_block)
+            rest = r;
+        else
+            co_return false;
+    }
+    co_return true;
+}
+
+// Connects, queues and reads until MatchStart; the client (and its socket) goes away when this returns.
+static coro::task<bool> play_until_match_start(std::shared_ptr<coro::io_scheduler> sched, uint16_t port)
+{
+    co_await sched->yield_for(100ms);
+    coro::net::tcp::client cli{sched, {.address = coro::net::ip_address::from_string("127.0.0.1"), .port = port}};
+    auto st = co_await cli.connect(2s);
+    assert(st == coro::net::connect_status::connected);
+    (void)st;
+    t2d::ClientMessage auth;
+    auth.mutable_auth_request()->set_oauth_token("x");
+    auth.mutable_auth_request()->set_client_version("t");
+    if (!co_await send_msg(cli, auth))
+        co_return false;
+    t2d::ClientMessage q;
+    q.mutable_queue_join();
+    if (!co_await send_msg(cli, q))
+        co_return false;
+    t2d::netutil::FrameParseState fps;
+    auto deadline = std::chrono::steady_clock::now() + 8s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        co_await cli.poll(coro::poll_op::read, 100ms);
+        std::string chunk(1024, '\0');
+        auto [rs, span] = cli.recv(chunk);
+        if (rs == coro::net::recv_status::would_block)
+            continue;
+        if (rs != coro::net::recv_status::ok)
+            break;
+        fps.buffer.insert(fps.buffer.end(), span.begin(), span.end());
+        std::string pl;
+        while (t2d::netutil::try_extract(fps, pl)) {
+            t2d::ServerMessage sm;
+            if (sm.ParseFromArray(pl.data(), (int)pl.size()) && sm.has_match_start()) {
+                std::cout << "[e2e] got MatchStart, closing connection" << std::endl;
+                co_return true;
+            }
+        }
+    }
+    co_return false;
+}
+
+static coro::task<void> client_flow(std::shared_ptr<coro::io_scheduler> sched, uint16_t port)
+{
+    bool started = co_await play_until_match_start(sched, port);
+    assert(started);
+    (void)started;
+    auto &rt = t2d::metrics::runtime();
+    assert(rt.active_matches.load() == 1);
+    // Well inside the 30 s heartbeat timeout: only the connection close can have ended the match.
+    auto deadline = std::chrono::steady_clock::now() + 3s;
+    while (std::chrono::steady_clock::now() < deadline
+           && (rt.active_matches.load() != 0 || rt.matches_headless.load() == 0))
+        co_await sched->yield_for(20ms);
+    assert(rt.matches_headless.load() == 1);
+    assert(rt.active_matches.load() == 0);
+    std::cout << "e2e_headless_match OK" << std::endl;
+    co_return;
+}
+
+int main()
+{
+    auto sched = coro::default_executor::io_executor();
+    uint16_t port = 41080;
+    t2d::mm::MatchConfig mc{2, 1, 30}; // one human, one bot after the 1 s fill timeout
+    mc.disable_bot_fire = true; // the human must not die before the connection closes
+    sched->spawn(t2d::net::run_listener(sched, port, 60));
+    sched->spawn(t2d::mm::run_matchmaker(sched, mc));
+    coro::sync_wait(client_flow(sched, port));
+    return 0;
+}
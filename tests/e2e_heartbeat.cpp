@@ -1,4 +1,5 @@
 // SPDX-License-Identifier: Apache-2.0
+#include "common/clock_sync.hpp"
 #include "common/framing.hpp"
 #include "game.pb.h"
 #include "server/matchmaking/matchmaker.hpp"
@@ -12,6 +13,7 @@
 #include <coro/net/tcp/client.hpp>
 
 #include <cassert>
+#include <cstdlib>
 #include <iostream>
 
 using namespace std::chrono_literals;
@@ -45,6 +47,8 @@ static coro::task<void> flow(std::shared_ptr<coro::io_scheduler> sched, uint16_t
     t2d::ClientMessage hb;
     hb.mutable_heartbeat()->set_session_id("sess_t");
     hb.mutable_heartbeat()->set_time_ms(client_ms);
+    const uint64_t t1 = t2d::netutil::steady_us();
+    hb.mutable_heartbeat()->set_client_send_us(t1);
     hb.SerializeToString(&payload);
     f = t2d::netutil::build_frame(payload);
     rest = {f.data(), f.size()};
@@ -79,7 +83,17 @@ static coro::task<void> flow(std::shared_ptr<coro::io_scheduler> sched, uint16_t
                 gotAuth = true;
             else if (sm.has_heartbeat_resp()) {
                 gotHB = true;
-                assert(sm.heartbeat_resp().client_time_ms() == client_ms);
+                const auto &r = sm.heartbeat_resp();
+                assert(r.client_time_ms() == client_ms);
+                assert(r.client_send_us() == t1);
+                // Four-timestamp exchange; server and client share this host's steady clock, so the estimated
+                // offset must stay within half the round trip.
+                t2d::netutil::ClockSync sync;
+                bool accepted = sync.add_sample(
+                    r.client_send_us(), r.server_recv_us(), r.server_send_us(), t2d::netutil::steady_us());
+                assert(accepted && r.server_recv_us() <= r.server_send_us());
+                assert(sync.rtt_us() >= 0 && std::abs(sync.offset_us()) <= sync.rtt_us() / 2 + 1);
+                (void)accepted;
             }
         }
     }
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+// e2e_keyframe_request.cpp - client asks for an on-demand keyframe and receives a full snapshot long before the
+// (deliberately stretched) periodic keyframe interval would deliver one.
+#include "common/framing.hpp"
+#include "game.pb.h"
+#include "server/matchmaking/matchmaker.hpp"
+#include "server/matchmaking/session_manager.hpp"
+#include "server/net/listener.hpp"
+#include "test_match_config_loader.hpp"
+
+#include <coro/coro.hpp>
+#include <coro/default_executor.hpp>
+#include <coro/io_scheduler.hpp>
+#include <coro/net/tcp/client.hpp>
+
+#include <cassert>
+#include <iostream>
+using namespace std::chrono_literals;
+
+static coro::task<void> flow(std::shared_ptr<coro::io_scheduler> sched, uint16_t port)
+{
+    co_await sched->yield_for(50ms);
+    coro::net::tcp::client cli{sched, {.address = coro::net::ip_address::from_string("127.0.0.1"), .port = port}};
+    auto st = co_await cli.connect(2s);
+    assert(st == coro::net::connect_status::connected);
+    t2d::ClientMessage auth;
+    auth.mutable_auth_request()->set_oauth_token("x");
+    auth.mutable_auth_request()->set_client_version("t");
+    std::string payload;
+    auth.SerializeToString(&payload);
+    auto fr = t2d::netutil::build_frame(payload);
+    std::span<const char> rest(fr.data(), fr.size());
+    while (!rest.empty()) {
+        co_await cli.poll(coro::poll_op::write);
+        auto [ss, r] = cli.send(rest);
+        if (ss == coro::net::send_status::ok || ss == coro::net::send_status::would_block)
+            rest = r;
+        else
+            co_return;
+    }
+    t2d::ClientMessage q;
+    q.mutable_queue_join();
+    q.SerializeToString(&payload);
+    fr = t2d::netutil::build_frame(payload);
+    rest = {fr.data(), fr.size()};
+    while (!rest.empty()) {
+        co_await cli.poll(coro::poll_op::write);
+        auto [ss, r] = cli.send(rest);
+        if (ss == coro::net::send_status::ok || ss == coro::net::send_status::would_block)
+            rest = r;
+        else
+            co_return;
+    }
+    t2d::netutil::FrameParseState fps;
+    bool gotMatch = false;
+    bool gotBaseline = false;
+    bool requested = false;
+    bool gotKeyframe = false;
+    uint32_t requestTick = 0;
+    auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (std::chrono::steady_clock::now() < deadline && !gotKeyframe) {
+        co_await cli.poll(coro::poll_op::read, 150ms);
+        std::string tmp(4096, '\0');
+        auto [rs, span] = cli.recv(tmp);
+        if (rs == coro::net::recv_status::would_block)
+            continue;
+        if (rs == coro::net::recv_status::closed)
+            break;
+        if (rs != coro::net::recv_status::ok)
+            break;
+        fps.buffer.insert(fps.buffer.end(), span.begin(), span.end());
+        std::string pl;
+        while (t2d::netutil::try_extract(fps, pl)) {
+            t2d::ServerMessage sm;
+            sm.ParseFromArray(pl.data(), (int)pl.size());
+            if (sm.has_match_start()) {
+                gotMatch = true;
+            } else if (sm.has_snapshot()) {
+                if (sm.snapshot().server_tick() == 0)
+                    gotBaseline = true;
+                else if (requested && sm.snapshot().server_tick() >= requestTick)
+                    gotKeyframe = true;
+            } else if (sm.has_delta_snapshot() && gotBaseline && !requested) {
+                // Every delta still builds on the baseline; pretend we lost it and ask for a keyframe.
+                assert(sm.delta_snapshot().base_tick() == 0);
+                requestTick = sm.delta_snapshot().server_tick();
+                t2d::ClientMessage kr;
+                kr.mutable_keyframe_request()->set_last_full_tick(0);
+                kr.mutable_keyframe_request()->set_last_server_tick(requestTick);
+                kr.SerializeToString(&payload);
+                fr = t2d::netutil::build_frame(payload);
+                rest = {fr.data(), fr.size()};
+                while (!rest.empty()) {
+                    co_await cli.poll(coro::poll_op::write);
+                    auto [ss, r] = cli.send(rest);
+                    if (ss == coro::net::send_status::ok || ss == coro::net::send_status::would_block)
+                        rest = r;
+                    else
+                        co_return;
+                }
+                requested = true;
+            }
+        }
+    }
+    assert(gotMatch && gotBaseline && requested && gotKeyframe);
+    std::cout << "e2e_keyframe_request OK" << std::endl;
+    co_return;
+}
+
+int main(int argc, char **argv)
+{
+    auto sched = coro::default_executor::io_executor();
+    uint16_t port = 41070;
+    t2d::mm::MatchConfig mc{1, 180, 30};
+    // Periodic keyframes every 100 s: any full snapshot after the baseline must be the on-demand one.
+    mc.full_snapshot_interval_ticks = 3000;
+    if (argc > 1) {
+        t2d::test::apply_match_config_overrides(mc, argv[1]);
+    }
+    const uint32_t tickRate = 60;
+    sched->spawn(t2d::net::run_listener(sched, port, tickRate));
+    sched->spawn(t2d::mm::run_matchmaker(sched, mc));
+    coro::sync_wait(flow(sched, port));
+    return 0;
+}
@@ -79,6 +79,11 @@ static coro::task<void> flow(std::shared_ptr<coro::io_scheduler> sched, uint16_t
                 gotKillFeed = sm.kill_feed().events_size() > 0;
             else if (sm.has_destroyed())
                 gotDestroyed = true; // auxiliary sanity
+            // Destroy events arrive batched per tick (standalone or piggybacked on the tick's snapshot).
+            if ((sm.has_tick_events() && sm.tick_events().destroyed_size() > 0)
+                || (sm.has_snapshot() && sm.snapshot().events().destroyed_size() > 0)
+                || (sm.has_delta_snapshot() && sm.delta_snapshot().events().destroyed_size() > 0))
+                gotDestroyed = true;
         }
     }
     assert(gotMatch);
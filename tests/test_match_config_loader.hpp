@@ -59,6 +59,18 @@ inline void apply_match_config_overrides(t2d::mm::MatchConfig &cfg, const std::s
             cfg.map_height = root["map_height"].as<float>();
         if (root["force_line_spawn"])
             cfg.force_line_spawn = root["force_line_spawn"].as<bool>();
+        if (root["map_path"])
+            cfg.map_path = root["map_path"].as<std::string>();
+        if (root["snapshot_budget_bytes"])
+            cfg.snapshot_budget_bytes = root["snapshot_budget_bytes"].as<uint32_t>();
+        if (root["snapshot_priority_ref_distance"])
+            cfg.snapshot_priority_ref_distance = root["snapshot_priority_ref_distance"].as<float>();
+        if (root["keyframe_stagger"])
+            cfg.keyframe_stagger = root["keyframe_stagger"].as<bool>();
+        if (root["projectile_spawn_only"])
+            cfg.projectile_spawn_only = root["projectile_spawn_only"].as<bool>();
+        if (root["headless_match_policy"])
+            cfg.headless_policy = root["headless_match_policy"].as<std::string>();
     } catch (const std::exception &) {
         // Swallow errors: tests fall back to embedded defaults if file missing or invalid.
     }
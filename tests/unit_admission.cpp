@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+// Admission control: the cost model recovers per-human / per-bot tick costs from finished matches (and keeps the
+// prior where the data says nothing), verdicts for match cap / capacity / governor overload (top level only), one
+// denial count per held group, the idle-process exception, load from measured ticks and queue wait estimates.
+#include "server/game/overload_governor.hpp"
+#include "server/matchmaking/admission.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using t2d::mm::AdmissionConfig;
+using t2d::mm::AdmissionController;
+using t2d::mm::AdmissionVerdict;
+using t2d::mm::MatchCostModel;
+using namespace std::chrono_literals;
+
+static bool near(double a, double b, double tol)
+{
+    return std::fabs(a - b) <= tol;
+}
+
+// Runs one admitted match for `seconds` at `tick_us` per tick and finishes it.
+static void play(
+    AdmissionController &ctl,
+    uint32_t humans,
+    uint32_t bots,
+    double tick_us,
+    double seconds,
+    std::chrono::steady_clock::time_point &now)
+{
+    auto load = ctl.admit(humans, bots, 30, now);
+    for (int t = 0; t < static_cast<int>(seconds * 30); ++t)
+        load->record_tick(static_cast<uint64_t>(tick_us * 1000));
+    now += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    ctl.finish(load, now);
+}
+
+int main()
+{
+    // Model: true cost 80 + 20 * humans + 70 * bots, compositions of a 4 player match.
+    {
+        MatchCostModel model({100.0, 30.0, 50.0});
+        assert(near(model.predict(1, 3), 100 + 30 + 150, 1e-9)); // prior only
+        for (int i = 0; i < 40; ++i) {
+            const uint32_t humans = 1 + static_cast<uint32_t>(i % 4);
+            model.observe(humans, 4 - humans, 80.0 + 20.0 * humans + 70.0 * (4 - humans));
+        }
+        const auto c = model.coefficients();
+        assert(near(c.per_bot_us - c.per_human_us, 50.0, 2.0)); // the difference is what varies in the data
+        assert(near(model.predict(1, 3), 310.0, 5.0) && near(model.predict(4, 0), 160.0, 5.0));
+        // Bigger matches than ever seen extrapolate with the learned slopes.
+        assert(model.predict(8, 0) > model.predict(4, 0));
+        assert(model.samples() == 40);
+        (void)c;
+    }
+    // One composition only: its prediction follows the data, the unconstrained directions stay finite.
+    {
+        MatchCostModel model({100.0, 30.0, 50.0});
+        for (int i = 0; i < 20; ++i)
+            model.observe(1, 3, 900.0);
+        assert(near(model.predict(1, 3), 900.0, 20.0));
+        const auto c = model.coefficients();
+        assert(std::isfinite(c.base_us) && std::isfinite(c.per_human_us) && std::isfinite(c.per_bot_us));
+        (void)c;
+    }
+
+    auto now = std::chrono::steady_clock::time_point{} + 100s;
+    AdmissionController ctl;
+    AdmissionConfig cfg;
+    cfg.max_parallel_matches = 3;
+    cfg.capacity_cores = 0.05; // 50 ms of simulation per second before target utilization
+    cfg.target_utilization_pct = 100;
+    ctl.configure(cfg);
+
+    // Idle process admits even a match predicted above capacity.
+    auto d = ctl.evaluate(1, 3, 30);
+    assert(d.admitted() && near(d.predicted_tick_us, 280.0, 1e-9));
+    auto a = ctl.admit(1, 3, 30, now);
+    // Not measured yet: the prediction counts (280 us * 30 Hz = 8.4 ms/s).
+    assert(near(ctl.stats().load_cores, 0.0084, 1e-9));
+
+    // Measured cost replaces the prediction after one second of ticks: 1.5 ms * 30 = 45 ms/s.
+    for (int t = 0; t < 30; ++t)
+        a->record_tick(1'500'000);
+    d = ctl.evaluate(1, 3, 30);
+    assert(d.verdict == AdmissionVerdict::Capacity && near(d.load_cores, 0.045, 1e-9));
+    // Every matchmaker poll re-evaluates the held group; the hold is counted once.
+    for (int i = 0; i < 5; ++i)
+        assert(ctl.evaluate(1, 3, 30).verdict == AdmissionVerdict::Capacity);
+    assert(ctl.stats().denied_capacity == 1);
+
+    // Match cap comes first.
+    cfg.capacity_cores = 0; // load check off
+    cfg.max_parallel_matches = 2;
+    ctl.configure(cfg);
+    auto b = ctl.admit(4, 0, 30, now + 10s);
+    assert(ctl.evaluate(4, 0, 30).verdict == AdmissionVerdict::MatchCap);
+
+    // Wait estimates from the expected match length (prior 60 s): at t+20 s the matches started at t and t+10 s have
+    // 40 and 50 s left; the third group waits for the first slot to come round again.
+    const auto later = now + 20s;
+    assert(ctl.estimated_wait_seconds(0, later) == 40);
+    assert(ctl.estimated_wait_seconds(1, later) == 50);
+    assert(ctl.estimated_wait_seconds(2, later) == 100);
+
+    // A mildly degrading governor leaves the decision to the load check; its top level blocks new matches.
+    cfg.max_parallel_matches = 0;
+    ctl.configure(cfg);
+    t2d::game::GovernorConfig gcfg;
+    gcfg.enabled = true;
+    gcfg.max_level = 2;
+    auto &gov = t2d::game::governor();
+    gov.configure(gcfg, now);
+    for (int i = 0; i < 60; ++i)
+        gov.record_tick(9'000'000, now);
+    gov.evaluate(now + 1s);
+    assert(gov.level() == 1);
+    assert(ctl.evaluate(1, 3, 30).admitted());
+    for (int i = 0; i < 60; ++i)
+        gov.record_tick(9'000'000, now + 1s);
+    gov.evaluate(now + 2s);
+    assert(gov.level() == 2 && gov.max_level() == 2);
+    assert(ctl.evaluate(1, 3, 30).verdict == AdmissionVerdict::Overload);
+    assert(ctl.evaluate(1, 3, 30).verdict == AdmissionVerdict::Overload);
+    gcfg.enabled = false;
+    gov.configure(gcfg, now);
+    assert(ctl.evaluate(1, 3, 30).admitted());
+
+    // Finishing trains the model and the match length; short matches are ignored.
+    ctl.finish(a, now + 30s);
+    ctl.finish(b, now + 10s + 100ms);
+    auto st = ctl.stats();
+    assert(st.running == 0 && st.model_samples == 1 && near(st.mean_match_seconds, 45.0, 1e-9));
+    assert(ctl.estimated_wait_seconds(0, now) == 0);
+    auto t = now + 1min;
+    for (int i = 0; i < 30; ++i)
+        play(ctl, 1, 3, 900.0, 20.0, t);
+    st = ctl.stats();
+    assert(st.model_samples == 31 && near(st.mean_match_seconds, 20.0, 1.0));
+    assert(near(ctl.evaluate(1, 3, 30).predicted_tick_us, 900.0, 40.0));
+    ctl.finish(nullptr, t); // unadmitted match (disabled controller, tests)
+    assert(st.admitted == 2 + 30 && st.denied_cap == 1 && st.denied_capacity == 1 && st.denied_overload == 1);
+
+    // Disabled controller admits everything.
+    cfg.enabled = false;
+    cfg.max_parallel_matches = 1;
+    ctl.configure(cfg);
+    auto c = ctl.admit(1, 1, 30, t);
+    assert(ctl.evaluate(1, 1, 30).admitted());
+    ctl.finish(c, t);
+    (void)d;
+    (void)later;
+    (void)st;
+    std::cout << "unit_admission OK" << std::endl;
+    return 0;
+}
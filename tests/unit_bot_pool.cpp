@@ -0,0 +1,89 @@
+// Bot pool soak: hundreds of bot-filled matches of varying size must not grow the session registry, the pool stays
+// bounded by the peak number of bots in use at once and every match after the peak reuses the same session objects.
+#include "server/matchmaking/session_manager.hpp"
+
+#include "common/metrics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <set>
+
+namespace {
+
+constexpr size_t kHumans = 8;
+constexpr size_t kMaxBotsPerMatch = 4;
+constexpr size_t kPeakBots = 2 * kMaxBotsPerMatch; // two full matches overlap every 5th round
+constexpr int kRounds = 200;
+
+} // namespace
+
+int main()
+{
+    auto &mgr = t2d::mm::instance();
+    std::vector<std::shared_ptr<t2d::mm::Session>> humans;
+    for (size_t i = 0; i < kHumans; ++i) {
+        auto s = mgr.add_connection();
+        mgr.authenticate(s, "human_" + std::to_string(i));
+        humans.push_back(s);
+    }
+
+    std::set<const t2d::mm::Session *> bot_objects;
+    std::set<std::string> bot_ids;
+    std::vector<size_t> disconnected;
+    size_t peak = 0;
+    // Matchmaker: one human plus a bot fill, all taken off the queue when the match starts.
+    const auto start_match = [&](size_t human, size_t bots) {
+        mgr.enqueue(humans[human]);
+        auto players = mgr.create_bots(bots);
+        players.insert(players.begin(), humans[human]);
+        mgr.pop_from_queue(players);
+        for (size_t i = 1; i < players.size(); ++i) {
+            bot_objects.insert(players[i].get());
+            bot_ids.insert(players[i]->session_id);
+        }
+        mgr.find_disconnected(players, disconnected);
+        assert(disconnected.empty());
+        return players;
+    };
+    for (int r = 0; r < kRounds; ++r) {
+        const size_t bots = 1 + static_cast<size_t>(r) % kMaxBotsPerMatch;
+        auto first = start_match(static_cast<size_t>(r) % kHumans, bots);
+        size_t in_use = bots;
+        std::vector<std::shared_ptr<t2d::mm::Session>> second;
+        if (r % 5 == 4) {
+            second = start_match((static_cast<size_t>(r) + 1) % kHumans, kMaxBotsPerMatch);
+            in_use += kMaxBotsPerMatch;
+        }
+        peak = std::max(peak, in_use);
+        // Sessions are allocated only when the pool is empty: live + pooled never exceeds the peak in use.
+        assert(mgr.live_bot_count() == in_use);
+        assert(mgr.live_bot_count() + mgr.pooled_bot_count() == peak);
+        assert(bot_objects.size() == peak && bot_ids.size() == peak);
+
+        mgr.release_bots(first);
+        mgr.release_bots(second);
+        assert(mgr.live_bot_count() == 0 && mgr.pooled_bot_count() == peak);
+        assert(mgr.snapshot_all_sessions().size() == kHumans); // registry holds humans only
+    }
+    // The peak number of session objects served every match, reset between them.
+    assert(peak == kPeakBots && bot_objects.size() == kPeakBots && mgr.pooled_bot_count() == kPeakBots);
+    auto reused = mgr.create_bots(1);
+    assert(bot_objects.count(reused[0].get()) == 1);
+    assert(reused[0]->is_bot && reused[0]->authenticated && reused[0]->in_queue);
+    assert(reused[0]->tank_entity_id == 0 && reused[0]->match_ctx.expired() && reused[0]->outbound.empty());
+    assert(t2d::metrics::runtime().bots_live.load() == 1
+           && t2d::metrics::runtime().bots_pooled.load() == kPeakBots - 1);
+    mgr.release_bots(reused);
+
+    // A human dropped by the heartbeat monitor shows up at its index in the match; bots never do.
+    std::vector<std::shared_ptr<t2d::mm::Session>> match{mgr.create_bots(1)[0], humans[3]};
+    mgr.disconnect_session(humans[3]);
+    mgr.find_disconnected(match, disconnected);
+    assert(disconnected.size() == 1 && disconnected[0] == 1);
+    mgr.release_bots(match);
+    assert(mgr.snapshot_all_sessions().size() == kHumans - 1);
+
+    std::cout << "unit_bot_pool OK" << std::endl;
+    return 0;
+}
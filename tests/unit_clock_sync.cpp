@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// NTP-style heartbeat clock sync: offset / RTT from the four timestamps, min-RTT filtering over the window and
+// rejection of impossible orderings.
+#include "common/clock_sync.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using t2d::netutil::ClockSync;
+
+static constexpr int64_t kServerAhead = 5'000'000; // server clock - client clock
+
+// One exchange: client sends at t1 (client clock), legs take up / down microseconds, server holds it proc us.
+static bool exchange(ClockSync &cs, uint64_t t1, uint64_t up, uint64_t proc, uint64_t down)
+{
+    uint64_t t2 = t1 + up + kServerAhead;
+    uint64_t t3 = t2 + proc;
+    uint64_t t4 = t1 + up + proc + down;
+    return cs.add_sample(t1, t2, t3, t4);
+}
+
+int main()
+{
+    ClockSync cs;
+    assert(!cs.valid() && cs.report_rtt_us() == 0);
+
+    // Symmetric legs: exact offset, RTT excludes server processing.
+    bool ok = exchange(cs, 1'000'000, 10'000, 500, 10'000);
+    assert(ok && cs.valid());
+    assert(cs.rtt_us() == 20'000);
+    assert(cs.offset_us() == kServerAhead);
+    assert(cs.report_rtt_us() == 20'000);
+    assert(cs.to_local_us(static_cast<uint64_t>(kServerAhead) + 42) == 42);
+    assert(cs.to_server_us(42) == static_cast<uint64_t>(kServerAhead) + 42);
+
+    // Queued uplink (+60ms one way): offset would be off by 30ms; the filter keeps the low-RTT sample.
+    ok = exchange(cs, 2'000'000, 70'000, 500, 10'000);
+    assert(ok);
+    assert(cs.rtt_us() == 20'000 && cs.offset_us() == kServerAhead);
+    assert(cs.jitter_us() > 0);
+
+    // Impossible orderings are rejected and do not disturb the estimate.
+    assert(!cs.add_sample(0, 1, 2, 3)); // missing t1 (older server / client)
+    assert(!cs.add_sample(100, 200, 150, 300)); // server send before receive
+    assert(!cs.add_sample(300, 400, 500, 200)); // received before sent
+    assert(!cs.add_sample(100, 1'000, 2'000, 600)); // processing longer than the round trip
+    assert(cs.rejected() == 4 && cs.samples() == 2);
+    assert(cs.offset_us() == kServerAhead);
+
+    // The best sample ages out after kWindow newer ones; the estimate follows the window.
+    for (size_t i = 0; i < ClockSync::kWindow; ++i) {
+        ok = exchange(cs, 3'000'000 + i * 1'000'000, 15'000, 200, 25'000);
+        assert(ok);
+    }
+    assert(cs.rtt_us() == 40'000);
+    assert(std::llabs(cs.offset_us() - (kServerAhead - 5'000)) <= 1); // asymmetric legs: half the difference
+    assert(cs.samples() == 2 + ClockSync::kWindow);
+
+    // Loopback with a sub-microsecond RTT still reports a completed exchange.
+    ClockSync local;
+    ok = local.add_sample(10, 10, 10, 10);
+    assert(ok && local.rtt_us() == 0 && local.report_rtt_us() == 1);
+
+    cs.reset();
+    assert(!cs.valid() && cs.samples() == 0 && cs.rejected() == 0);
+    (void)ok;
+    std::cout << "unit_clock_sync OK" << std::endl;
+    return 0;
+}
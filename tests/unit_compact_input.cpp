@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// Unit test: compact input frames roundtrip (quantized axes, flags, varint tick), reject malformed payloads and stay
+// several times smaller than the protobuf InputCommand they replace.
+#include "common/compact_input.hpp"
+#include "game.pb.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using t2d::netutil::CompactInput;
+using t2d::netutil::decode_compact_input;
+using t2d::netutil::encode_compact_input;
+using t2d::netutil::FrameDecoder;
+using t2d::netutil::FrameStatus;
+using t2d::netutil::FrameType;
+
+// Strips the frame header the way the listener does and decodes the body.
+static bool decode_payload(const std::string &payload, CompactInput &out)
+{
+    FrameDecoder dec;
+    FrameType type{};
+    const char *body = nullptr;
+    size_t len = 0;
+    if (dec.decode(payload.data(), payload.size(), type, body, len) != FrameStatus::Ready)
+        return false;
+    return type == FrameType::InputCompact && decode_compact_input(body, len, out);
+}
+
+int main()
+{
+    std::string buf;
+    CompactInput in;
+    in.client_tick = 300; // two varint bytes
+    in.move_dir = 1.f;
+    in.turn_dir = -0.5f;
+    in.turret_turn = 0.25f;
+    in.fire = true;
+    encode_compact_input(in, buf);
+    assert(buf.size() == 9); // 3 header + flags + 3 axes + 2 varint
+    assert(t2d::netutil::is_headered_payload(buf.data(), buf.size()));
+    CompactInput out;
+    assert(decode_payload(buf, out));
+    assert(out.client_tick == 300 && out.fire && !out.brake);
+    assert(out.move_dir == 1.f);
+    assert(std::fabs(out.turn_dir + 0.5f) <= 1.f / 127.f);
+    assert(std::fabs(out.turret_turn - 0.25f) <= 1.f / 127.f);
+
+    // Extremes: clamped axes, max tick (5-byte varint), both flags.
+    in = {};
+    in.client_tick = 0xFFFFFFFFu;
+    in.move_dir = -3.f;
+    in.turn_dir = 7.f;
+    in.turret_turn = NAN;
+    in.brake = true;
+    encode_compact_input(in, buf);
+    assert(buf.size() == 3 + t2d::netutil::COMPACT_INPUT_MAX_BYTES);
+    assert(decode_payload(buf, out));
+    assert(out.client_tick == 0xFFFFFFFFu && out.brake && !out.fire);
+    assert(out.move_dir == -1.f && out.turn_dir == 1.f && out.turret_turn == 0.f);
+
+    // Malformed: truncated varint, trailing bytes, wrong frame type, too short.
+    std::string bad = buf.substr(0, buf.size() - 1);
+    assert(!decode_payload(bad, out));
+    in.client_tick = 5;
+    encode_compact_input(in, buf);
+    bad = buf + '\x01';
+    assert(!decode_payload(bad, out));
+    bad = buf;
+    bad[2] = static_cast<char>(FrameType::Heartbeat);
+    assert(!decode_payload(bad, out));
+    assert(!decode_payload(buf.substr(0, 7), out));
+
+    // A protobuf ClientMessage never starts with the 0x00 frame marker.
+    t2d::ClientMessage cm;
+    auto *ic = cm.mutable_input();
+    ic->set_session_id("anon-session-0001");
+    ic->set_client_tick(300);
+    ic->set_move_dir(1.f);
+    ic->set_turn_dir(-0.5f);
+    ic->set_turret_turn(0.25f);
+    ic->set_fire(true);
+    std::string pb;
+    cm.SerializeToString(&pb);
+    assert(!t2d::netutil::is_headered_payload(pb.data(), pb.size()));
+    assert(pb.size() >= 4 * 8);
+
+    std::cout << "unit_compact_input OK" << std::endl;
+    return 0;
+}
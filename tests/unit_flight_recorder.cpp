@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+// Flight recorder: the ring keeps the last history_ms of ticks oldest first, only ticks over the threshold produce a
+// dump, dumps obey the process-wide interval and count limits, and the written file carries the match id, config
+// and every recorded tick.
+#include "common/metrics.hpp"
+#include "server/game/flight_recorder.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+using t2d::game::FlightRecorder;
+using t2d::game::FlightRecorderConfig;
+using t2d::game::TickPhase;
+
+namespace {
+
+void record(FlightRecorder &fr, uint64_t tick, uint32_t total_us)
+{
+    auto &r = fr.next();
+    r.tick = tick;
+    r.total_ns = total_us * 1000;
+    r.phase_ns[static_cast<size_t>(TickPhase::Physics)] = total_us * 600;
+    r.tanks_alive = 4;
+}
+
+} // namespace
+
+int main()
+{
+    using namespace std::chrono_literals;
+    const auto dir = std::filesystem::temp_directory_path() / ("t2d_flight_" + std::to_string(::getpid()));
+    FlightRecorderConfig cfg;
+    cfg.threshold_us = 10000;
+    cfg.history_ms = 1000; // 30 ticks at 30 Hz
+    cfg.min_interval_ms = 5000;
+    cfg.max_dumps = 2;
+    cfg.dir = dir.string();
+    t2d::game::configure_flight_recorder(cfg);
+
+    FlightRecorder fr("m_42", 30, "{\"tick_rate\":30}");
+    assert(fr.enabled() && fr.capacity() == 30);
+
+    // Wraps: 40 ticks recorded, the last 30 kept oldest first.
+    const auto t0 = std::chrono::steady_clock::time_point{} + 1h;
+    for (uint64_t t = 1; t <= 40; ++t) {
+        record(fr, t, 2000);
+        assert(!fr.finish_tick(t0 + t * 33ms)); // under the threshold
+    }
+    auto hist = fr.history();
+    assert(hist.size() == 30 && hist.front().tick == 11 && hist.back().tick == 40);
+    (void)hist;
+
+    // Slow tick: dump with the whole history, the config and the trigger.
+    record(fr, 41, 25000);
+    auto dump = fr.finish_tick(t0 + 41 * 33ms);
+    assert(dump && dump->path.find("flight_m_42_41.json") != std::string::npos);
+    assert(dump->json.find("\"match_id\":\"m_42\"") != std::string::npos);
+    assert(dump->json.find("\"trigger_tick\":41") != std::string::npos);
+    assert(dump->json.find("\"config\":{\"tick_rate\":30}") != std::string::npos);
+    assert(dump->json.find("\"tick\":12,") != std::string::npos);
+    assert(dump->json.find("\"tick\":11,") == std::string::npos);
+    assert(dump->json.find("\"physics_ns\":15000000") != std::string::npos);
+    assert(t2d::game::write_flight_dump(*dump));
+    {
+        std::ifstream f(dump->path);
+        std::stringstream ss;
+        ss << f.rdbuf();
+        assert(ss.str() == dump->json);
+    }
+
+    // Rate limits: another breach inside min_interval_ms is counted but not dumped; after it, one more dump, then the
+    // per-run cap holds.
+    const uint64_t breaches = t2d::metrics::runtime().flight_recorder_breaches.load();
+    record(fr, 42, 30000);
+    assert(!fr.finish_tick(t0 + 42 * 33ms));
+    assert(t2d::metrics::runtime().flight_recorder_breaches.load() == breaches + 1);
+    record(fr, 43, 30000);
+    assert(fr.finish_tick(t0 + 43 * 33ms + 6s));
+    record(fr, 44, 30000);
+    assert(!fr.finish_tick(t0 + 44 * 33ms + 20s));
+    (void)breaches;
+
+    // Disabled: one scratch slot, never dumps.
+    cfg.enabled = false;
+    t2d::game::configure_flight_recorder(cfg);
+    FlightRecorder off("m_43", 30, "{}");
+    assert(!off.enabled() && off.capacity() == 1);
+    record(off, 1, 50000);
+    assert(!off.finish_tick(t0));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "unit_flight_recorder OK" << std::endl;
+    return 0;
+}
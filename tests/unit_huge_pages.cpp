@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// Huge page heap: region mapping with fallback, size-class reuse, alignment, blocks from before configure(),
+// HotVector storage and the perf counter group used by t2d_simbench (which may have no PMU to talk to).
+#include "server/runtime/huge_pages.hpp"
+#include "server/runtime/perf_counters.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+using t2d::runtime::HugePageBacking;
+using t2d::runtime::HugePageHeap;
+using t2d::runtime::HugePageMode;
+using t2d::runtime::kHugePageSize;
+
+static bool aligned(const void *p, size_t to)
+{
+    return reinterpret_cast<uintptr_t>(p) % to == 0;
+}
+
+int main()
+{
+    HugePageMode mode = HugePageMode::Off;
+    bool ok = t2d::runtime::parse_huge_page_mode("hugetlb", mode);
+    assert(ok && mode == HugePageMode::HugeTlb);
+    assert(!t2d::runtime::parse_huge_page_mode("2m", mode) && mode == HugePageMode::HugeTlb);
+
+    // Regions: 2 MiB aligned and rounded whatever backing the kernel granted; hugetlb degrades when the pool is empty.
+    auto region = t2d::runtime::map_huge_region(3u << 20, HugePageMode::Transparent, true);
+    assert(region.base && aligned(region.base, kHugePageSize) && region.bytes == 2 * kHugePageSize);
+    std::memset(region.base, 0xAB, region.bytes);
+    t2d::runtime::unmap_huge_region(region);
+    assert(!region.base);
+    region = t2d::runtime::map_huge_region(1, HugePageMode::HugeTlb, false);
+    assert(region.base && region.bytes == kHugePageSize);
+    t2d::runtime::unmap_huge_region(region);
+    assert(!t2d::runtime::map_huge_region(1, HugePageMode::Off, false).base);
+
+    // Disabled heap behaves like the system allocator; such blocks stay valid after the heap is switched on.
+    auto &heap = HugePageHeap::instance();
+    assert(!heap.enabled());
+    void *early = heap.allocate(100);
+    std::memset(early, 1, 100);
+    {
+        t2d::runtime::HotVector<int> v(1000, 7);
+        assert(std::accumulate(v.begin(), v.end(), 0) == 7000);
+    }
+    assert(heap.stats().regions == 0);
+
+    ok = heap.configure(HugePageMode::Transparent, 1u << 20); // rounded up to one huge page
+    assert(ok && heap.enabled());
+    heap.deallocate(early);
+
+    // Same size class comes back LIFO; every payload honours its alignment.
+    void *a = heap.allocate(200, 32);
+    assert(aligned(a, 32));
+    heap.deallocate(a);
+    void *b = heap.allocate(180, 32);
+    assert(b == a);
+    std::array<size_t, 4> aligns{8, 16, 32, 64};
+    for (size_t al : aligns) {
+        void *p = heap.allocate(1000, al);
+        assert(aligned(p, al));
+        std::memset(p, 0, 1000);
+        heap.deallocate(p);
+    }
+    auto st = heap.stats();
+    assert(st.regions == 1 && st.reserved_bytes == kHugePageSize && st.system_allocations == 0);
+
+    // Over-aligned requests go to the system allocator; blocks above 1 MiB get their own mapping.
+    void *wide = heap.allocate(64, 128);
+    assert(aligned(wide, 128) && heap.stats().system_allocations == 1);
+    void *large = heap.allocate(3u << 20);
+    assert(aligned(large, 16));
+    std::memset(large, 0, 3u << 20);
+    assert(heap.stats().reserved_bytes == kHugePageSize + 4 * (1u << 20));
+    heap.deallocate(large);
+    heap.deallocate(wide);
+    assert(heap.stats().reserved_bytes == kHugePageSize);
+
+    // Vector growth past one region maps the next one.
+    {
+        t2d::runtime::HotVector<uint64_t> v;
+        for (uint64_t i = 0; i < 200'000; ++i)
+            v.push_back(i);
+        assert(v[199'999] == 199'999);
+        assert(heap.stats().regions >= 2);
+    }
+    heap.deallocate(b);
+    st = heap.stats();
+    assert(st.in_use_bytes == 0);
+    assert(st.backing == HugePageBacking::Transparent || st.backing == HugePageBacking::Normal);
+    assert(!heap.configure(HugePageMode::HugeTlb, 1u << 20)); // too late: blocks were handed out
+    (void)t2d::runtime::resident_huge_page_bytes();
+
+    // Counter group: whatever the PMU allows, reads stay index-aligned with the request.
+    t2d::runtime::PerfCounterGroup counters;
+    std::array<t2d::runtime::PerfEvent, 2> events{
+        t2d::runtime::PerfEvent::Instructions, t2d::runtime::PerfEvent::DtlbLoadMisses};
+    size_t opened = counters.open(events);
+    counters.start();
+    volatile uint64_t sink = 0;
+    for (int i = 0; i < 100'000; ++i)
+        sink = sink + static_cast<uint64_t>(i);
+    counters.stop();
+    std::vector<uint64_t> values;
+    std::vector<bool> available;
+    bool read = counters.read(values, available);
+    assert(values.size() == 2 && available.size() == 2);
+    assert(opened > 0 || (!read && counters.last_error() != 0));
+    assert(!read || !available[0] || values[0] > 0);
+    (void)ok;
+    (void)st;
+    (void)opened;
+    (void)read;
+    std::cout << "unit_huge_pages OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+// Client input-to-effect tracker: acknowledgement matching, de-duplication and histogram percentiles.
+#include "common/input_latency.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+
+using t2d::netutil::InputLatencyTracker;
+using namespace std::chrono_literals;
+
+int main()
+{
+    InputLatencyTracker t;
+    const auto t0 = InputLatencyTracker::clock::now();
+    for (uint32_t tick = 1; tick <= 10; ++tick)
+        t.on_input_sent(tick, t0 + std::chrono::milliseconds(tick * 10));
+
+    assert(t.on_snapshot(0, t0 + 1s) == -1); // nothing applied yet
+    // Tick 3 sent at +30ms, acknowledged at +75ms.
+    assert(t.on_snapshot(3, t0 + 75ms) == 45000);
+    assert(t.on_snapshot(3, t0 + 90ms) == -1); // same stamp on the next snapshot
+    assert(t.on_snapshot(2, t0 + 95ms) == -1); // older than the last acknowledged tick
+    // Skipped ticks (4, 5) are never measured; 6 is.
+    assert(t.on_snapshot(6, t0 + 100ms) == 40000);
+    assert(t.count() == 2);
+    assert(t.max_us() == 45000);
+    assert(t.mean_us() == 42500);
+
+    // Tick overwritten in the ring (window wrap) is not matched.
+    t.on_input_sent(10 + InputLatencyTracker::kWindow, t0 + 2s);
+    assert(t.on_snapshot(10, t0 + 2s) == -1);
+
+    InputLatencyTracker h;
+    for (int i = 0; i < 90; ++i)
+        h.record(3000); // bucket <4ms
+    for (int i = 0; i < 10; ++i)
+        h.record(50000); // bucket <64ms
+    assert(h.percentile_us(0.5) == 4000);
+    assert(h.percentile_us(0.9) == 4000);
+    assert(h.percentile_us(0.99) == 50000); // clamped to the observed max
+    h.record(5'000'000); // overflow bucket
+    assert(h.percentile_us(1.0) == 5'000'000);
+    std::cout << h.summary() << std::endl;
+    h.reset_stats();
+    assert(h.count() == 0 && h.percentile_us(0.5) == 0);
+
+    std::cout << "unit_input_latency OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: Apache-2.0
+// Loopback test for the TLS transport (T2D_ENABLE_TLS builds): a self-signed certificate, a server-side TlsStream on
+// a non-blocking socket and a plain OpenSSL client. Data must round-trip whether the record layer ended up in the
+// kernel (kTLS: plain send / recv on the fd) or in userspace (SSL_read / SSL_write fallback).
+#include "server/net/ktls.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <openssl/ssl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using t2d::net::TlsConfig;
+using t2d::net::TlsContext;
+using t2d::net::TlsStatus;
+using t2d::net::TlsStream;
+
+static constexpr size_t kPayload = 64 * 1024; // several records each way
+
+static void wait_fd(int fd, TlsStatus st)
+{
+    pollfd p{fd, static_cast<short>(st == TlsStatus::WantWrite ? POLLOUT : POLLIN), 0};
+    ::poll(&p, 1, 1000);
+}
+
+// Server side of one round trip: receive kPayload bytes, send them back. Returns false on any failure.
+static bool serve(int fd, TlsStream &tls, bool &ktls_tx, bool &ktls_rx)
+{
+    TlsStatus st;
+    while ((st = tls.handshake()) == TlsStatus::WantRead || st == TlsStatus::WantWrite)
+        wait_fd(fd, st);
+    if (st != TlsStatus::Ok)
+        return false;
+    ktls_tx = tls.ktls_send();
+    ktls_rx = tls.ktls_recv();
+    std::string buf(kPayload, '\0');
+    size_t got = 0;
+    while (got < kPayload) {
+        if (ktls_rx) {
+            ssize_t r = ::recv(fd, buf.data() + got, kPayload - got, 0);
+            if (r > 0)
+                got += static_cast<size_t>(r);
+            else if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                wait_fd(fd, TlsStatus::WantRead);
+            else
+                return false;
+        } else {
+            size_t n = 0;
+            st = tls.read(buf.data() + got, kPayload - got, n);
+            if (st == TlsStatus::Ok)
+                got += n;
+            else if (st == TlsStatus::WantRead || st == TlsStatus::WantWrite)
+                wait_fd(fd, st);
+            else
+                return false;
+        }
+    }
+    size_t sent = 0;
+    while (sent < kPayload) {
+        if (ktls_tx) {
+            ssize_t w = ::send(fd, buf.data() + sent, kPayload - sent, MSG_NOSIGNAL);
+            if (w > 0)
+                sent += static_cast<size_t>(w);
+            else if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                wait_fd(fd, TlsStatus::WantWrite);
+            else
+                return false;
+        } else {
+            size_t n = 0;
+            st = tls.write(buf.data() + sent, kPayload - sent, n);
+            if (st == TlsStatus::Ok)
+                sent += n;
+            else if (st == TlsStatus::WantRead || st == TlsStatus::WantWrite)
+                wait_fd(fd, st);
+            else
+                return false;
+        }
+    }
+    return true;
+}
+
+// One connection against a context; the client verifies the certificate against itself (self-signed CA).
+static void round_trip(const TlsContext &ctx, const std::string &cert, bool expect_userspace)
+{
+    int lfd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(lfd >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int rc = ::bind(lfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    assert(rc == 0);
+    rc = ::listen(lfd, 1);
+    assert(rc == 0);
+    socklen_t alen = sizeof(addr);
+    rc = ::getsockname(lfd, reinterpret_cast<sockaddr *>(&addr), &alen);
+    assert(rc == 0);
+
+    bool server_ok = false;
+    bool ktls_tx = false;
+    bool ktls_rx = false;
+    std::thread server([&] {
+        int fd = ::accept(lfd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        {
+            TlsStream tls(ctx, fd);
+            server_ok = serve(fd, tls, ktls_tx, ktls_rx);
+        }
+        ::close(fd);
+    });
+
+    SSL_CTX *cctx = SSL_CTX_new(TLS_client_method());
+    assert(cctx);
+    SSL_CTX_set_verify(cctx, SSL_VERIFY_PEER, nullptr);
+    rc = SSL_CTX_load_verify_locations(cctx, cert.c_str(), nullptr);
+    assert(rc == 1);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    rc = ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    assert(rc == 0);
+    SSL *ssl = SSL_new(cctx);
+    SSL_set_fd(ssl, fd);
+    SSL_set1_host(ssl, "localhost");
+    rc = SSL_connect(ssl);
+    assert(rc == 1);
+    std::string msg(kPayload, '\0');
+    for (size_t i = 0; i < kPayload; ++i)
+        msg[i] = static_cast<char>('a' + i % 26);
+    size_t n = 0;
+    rc = SSL_write_ex(ssl, msg.data(), msg.size(), &n);
+    assert(rc == 1 && n == msg.size());
+    std::string echo(kPayload, '\0');
+    size_t got = 0;
+    while (got < kPayload && SSL_read_ex(ssl, echo.data() + got, kPayload - got, &n) == 1)
+        got += n;
+    assert(got == kPayload && echo == msg);
+    SSL_free(ssl);
+    SSL_CTX_free(cctx);
+    ::close(fd);
+    server.join();
+    ::close(lfd);
+    assert(server_ok);
+    assert(!expect_userspace || (!ktls_tx && !ktls_rx));
+    std::cout << "round trip " << (expect_userspace ? "userspace" : "offer_ktls") << ": ktls tx=" << ktls_tx
+              << " rx=" << ktls_rx << std::endl;
+    (void)rc;
+    (void)got;
+}
+
+int main()
+{
+    assert(t2d::net::tls_available());
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string tag = std::to_string(::getpid());
+    const std::string cert = (dir / ("t2d_unit_ktls_" + tag + ".crt")).string();
+    const std::string key = (dir / ("t2d_unit_ktls_" + tag + ".key")).string();
+    bool wrote = t2d::net::write_self_signed_cert(cert, key);
+    assert(wrote);
+    (void)wrote;
+
+    TlsConfig bad;
+    bad.cert_path = cert + ".missing";
+    bad.key_path = key;
+    assert(!TlsContext::create(bad));
+
+    TlsConfig cfg;
+    cfg.cert_path = cert;
+    cfg.key_path = key;
+    auto ktls_ctx = TlsContext::create(cfg);
+    assert(ktls_ctx);
+    // Kernel offload depends on the host (tls module, cipher support); both outcomes must carry the data.
+    round_trip(*ktls_ctx, cert, false);
+
+    cfg.offer_ktls = false;
+    auto user_ctx = TlsContext::create(cfg);
+    assert(user_ctx);
+    round_trip(*user_ctx, cert, true);
+
+    std::remove(cert.c_str());
+    std::remove(key.c_str());
+    std::cout << "unit_ktls OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// Unit test: compile a small tile map, write it to disk, load it through the mmap cache and verify merged chain
+// loops, nav clearance, placements and rejection of corrupted images.
+#include "server/game/map_format.hpp"
+
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main()
+{
+    // 6x4 grid, row 0 = bottom. A 2x1 wall block sits in the middle of the second row.
+    //   ......
+    //   ......
+    //   ..##..
+    //   ......
+    t2d::map::MapSource src;
+    src.tile_size = 2.f;
+    src.tiles_x = 6;
+    src.tiles_y = 4;
+    src.tiles.assign(24, t2d::map::TILE_FLOOR);
+    src.tiles[1 * 6 + 2] = t2d::map::TILE_WALL;
+    src.tiles[1 * 6 + 3] = t2d::map::TILE_WALL;
+    src.spawns = {{-4.f, 2.f, 0.f}, {4.f, 2.f, 180.f}};
+    src.crates = {{0.f, 3.f, 1.2f}};
+    src.ammo = {{-5.f, -3.f, 0.9f}};
+    std::string image = t2d::map::compile_map(src);
+    assert(!image.empty());
+    assert(image.size() % 4 == 0);
+
+    char path[] = "/tmp/t2d_map_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    {
+        std::ofstream f(path, std::ios::binary);
+        f.write(image.data(), static_cast<std::streamsize>(image.size()));
+    }
+
+    auto a = t2d::map::load_shared_map(path);
+    auto b = t2d::map::load_shared_map(path);
+    assert(a && b);
+    assert(a.get() == b.get()); // one mapping shared by every holder
+    const auto &v = a->view();
+    assert(v.width() == 12.f && v.height() == 8.f);
+    // Outer boundary merges into one rectangle, the wall block into another: 2 loops x 4 corners.
+    assert(v.chains.size() == 2);
+    for (const auto &c : v.chains) {
+        assert(c.point_count == 4);
+        assert(c.flags & 1u);
+    }
+    // Boundary loop is clockwise (walkable on the right), obstacle loop counter-clockwise.
+    int cw = 0, ccw = 0;
+    for (const auto &c : v.chains) {
+        auto pts = v.chain_points(c);
+        float area2 = 0.f;
+        for (size_t i = 0; i < pts.size(); ++i) {
+            const auto &p = pts[i];
+            const auto &q = pts[(i + 1) % pts.size()];
+            area2 += p.x * q.y - q.x * p.y;
+        }
+        if (area2 < 0.f)
+            ++cw;
+        else
+            ++ccw;
+    }
+    assert(cw == 1 && ccw == 1);
+    assert(v.spawns.size() == 2 && v.spawns[1].angle_deg == 180.f);
+    assert(v.crates.size() == 1 && v.crates[0].half_extent == 1.2f);
+    assert(v.ammo.size() == 1 && v.ammo[0].radius == 0.9f);
+    // Nav clearance: wall tile = 0, tiles touching the wall or border = 1, outside the map = 0.
+    assert(v.clearance_at(-1.f, -1.f) == 0); // tile (2,1)
+    assert(v.clearance_at(-1.f, 1.f) == 1); // tile (2,2) directly above the wall
+    assert(v.clearance_at(-5.f, -3.f) == 1); // border tile
+    assert(v.clearance_at(100.f, 0.f) == 0);
+
+    // Corruption: truncated image and bad magic are rejected without touching section data.
+    t2d::map::MapView tmp;
+    std::string err;
+    assert(!t2d::map::parse_map(image.data(), image.size() - 4, tmp, &err));
+    std::string bad = image;
+    bad[0] = 'X';
+    assert(!t2d::map::parse_map(bad.data(), bad.size(), tmp, &err));
+    assert(!t2d::map::load_shared_map("/nonexistent/t2d_map.bin"));
+    // Malformed source -> empty image
+    t2d::map::MapSource broken = src;
+    broken.tiles.pop_back();
+    assert(t2d::map::compile_map(broken).empty());
+
+    std::remove(path);
+    std::cout << "unit_map_format OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: Apache-2.0
+// Outbound lanes: reliable messages drain ahead of queued state, a full snapshot replaces queued state, consecutive
+// deltas of one base fold into one (upsert / removal / ref_tick semantics), events riding on replaced state survive
+// as standalone TickEvents in their original order, and queue latency is reported per lane. Fan-out messages are
+// encoded once and shared; the per-recipient last_input_tick stamp parses back into the snapshot.
+#include "common/frame_header.hpp"
+#include "common/metrics.hpp"
+#include "server/matchmaking/outbound_lanes.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using t2d::mm::OutboundLane;
+using t2d::mm::OutboundLanes;
+
+namespace {
+
+t2d::ServerMessage full(uint32_t tick)
+{
+    t2d::ServerMessage m;
+    m.mutable_snapshot()->set_server_tick(tick);
+    return m;
+}
+
+t2d::ServerMessage delta(uint32_t tick, uint32_t base)
+{
+    t2d::ServerMessage m;
+    m.mutable_delta_snapshot()->set_server_tick(tick);
+    m.mutable_delta_snapshot()->set_base_tick(base);
+    return m;
+}
+
+void add_damage(t2d::TickEvents *ev, uint32_t tick, uint32_t victim)
+{
+    ev->set_server_tick(tick);
+    ev->add_damage()->set_victim_id(victim);
+}
+
+} // namespace
+
+int main()
+{
+    using namespace std::chrono_literals;
+    const auto t0 = OutboundLanes::Clock::time_point{} + 1s;
+    auto &rt = t2d::metrics::runtime();
+
+    // Control drains first regardless of push order; latency per lane from each message's own queue time.
+    {
+        OutboundLanes lanes;
+        lanes.push(full(0), t0);
+        t2d::ServerMessage start;
+        start.mutable_match_start()->set_match_id("m");
+        lanes.push(start, t0 + 1ms);
+        t2d::ServerMessage end;
+        end.mutable_match_end()->set_server_tick(5);
+        lanes.push(end, t0 + 2ms);
+        assert(lanes.size(OutboundLane::Control) == 2 && lanes.size(OutboundLane::State) == 1);
+        assert(lanes.queued_relaxed() == 3);
+        std::vector<t2d::mm::OutboundMessage> out;
+        std::vector<std::pair<OutboundLane, uint64_t>> lat;
+        lanes.drain(out, t0 + 10ms, [&](OutboundLane l, uint64_t us) { lat.emplace_back(l, us); });
+        assert(out.size() == 3 && out[0].msg.has_match_start() && out[1].msg.has_match_end());
+        assert(out[2].msg.has_snapshot());
+        assert(lat.size() == 3 && lat[0].first == OutboundLane::Control && lat[0].second == 9000);
+        assert(lat[2].first == OutboundLane::State && lat[2].second == 10000);
+        assert(lanes.empty() && lanes.queued_relaxed() == 0);
+    }
+
+    // Merged and replaced state hand their events to the control lane, in order among the other control messages.
+    {
+        OutboundLanes lanes;
+        auto d1 = delta(10, 0);
+        add_damage(d1.mutable_delta_snapshot()->mutable_events(), 10, 7);
+        lanes.push(d1, t0);
+        t2d::ServerMessage kf;
+        kf.mutable_kill_feed()->add_events()->set_victim_id(7);
+        lanes.push(kf, t0 + 1ms);
+        const uint64_t superseded = rt.outbound_state_superseded.load();
+        const uint64_t rescued = rt.outbound_events_rescued.load();
+        auto d2 = delta(11, 0);
+        add_damage(d2.mutable_delta_snapshot()->mutable_events(), 11, 8);
+        lanes.push(d2, t0 + 2ms); // folded into d1
+        lanes.push(full(12), t0 + 3ms);
+        assert(lanes.size(OutboundLane::State) == 1 && lanes.queued_relaxed() == lanes.size());
+        assert(rt.outbound_state_superseded.load() == superseded + 2);
+        assert(rt.outbound_events_rescued.load() == rescued + 2);
+        std::vector<t2d::mm::OutboundMessage> out;
+        lanes.drain(out, t0 + 4ms, [](OutboundLane, uint64_t) {});
+        assert(out.size() == 4);
+        assert(out[0].msg.has_tick_events() && out[0].msg.tick_events().server_tick() == 10);
+        assert(out[1].msg.has_kill_feed());
+        assert(out[2].msg.has_tick_events() && out[2].msg.tick_events().server_tick() == 11);
+        assert(out[3].msg.has_snapshot() && out[3].msg.snapshot().server_tick() == 12);
+        (void)superseded;
+        (void)rescued;
+    }
+
+    // Deltas of one base fold: newer entity state wins, removals accumulate, tick fields come from the newer delta.
+    {
+        OutboundLanes lanes;
+        auto a = delta(20, 12);
+        auto *ad = a.mutable_delta_snapshot();
+        auto *t1 = ad->add_tanks();
+        t1->set_entity_id(1);
+        t1->set_x(1.f);
+        auto *t2 = ad->add_tanks();
+        t2->set_entity_id(2);
+        t2->set_hp(50);
+        auto *p = ad->add_projectiles();
+        p->set_projectile_id(9); // ref_tick 0: sampled at tick 20
+        ad->add_removed_projectiles(4);
+        auto b = delta(21, 12);
+        auto *bd = b.mutable_delta_snapshot();
+        bd->set_server_time_us(777);
+        auto *t1b = bd->add_tanks();
+        t1b->set_entity_id(1);
+        t1b->set_x(2.f);
+        bd->add_removed_tanks(2);
+        bd->add_removed_projectiles(4);
+        auto *box = bd->add_ammo_boxes();
+        box->set_box_id(3);
+        lanes.push(a, t0);
+        auto &merged = lanes.push(b, t0 + 1ms);
+        assert(lanes.size(OutboundLane::State) == 1 && merged.has_delta_snapshot());
+        const auto &m = merged.delta_snapshot();
+        assert(m.server_tick() == 21 && m.base_tick() == 12 && m.server_time_us() == 777);
+        assert(m.tanks_size() == 1 && m.tanks(0).entity_id() == 1 && m.tanks(0).x() == 2.f);
+        assert(m.removed_tanks_size() == 1 && m.removed_tanks(0) == 2);
+        assert(m.removed_projectiles_size() == 1);
+        assert(m.projectiles_size() == 1 && m.projectiles(0).ref_tick() == 20);
+        assert(m.ammo_boxes_size() == 1 && !m.has_events());
+        // A delta against another base (keyframe in between) is queued as is.
+        lanes.push(delta(22, 21), t0 + 2ms);
+        assert(lanes.size(OutboundLane::State) == 2);
+        (void)m;
+    }
+
+    // merge_delta refuses different bases and leaves the queued delta untouched.
+    {
+        auto a = delta(5, 1);
+        a.mutable_delta_snapshot()->add_removed_tanks(3);
+        auto b = delta(6, 2);
+        b.mutable_delta_snapshot()->add_removed_tanks(4);
+        const bool merged = t2d::mm::merge_delta(*a.mutable_delta_snapshot(), b.delta_snapshot());
+        assert(!merged && a.delta_snapshot().server_tick() == 5 && a.delta_snapshot().removed_tanks_size() == 1);
+        (void)merged;
+    }
+
+    // Shared encoding: one serialization for every lane, superseded like owned state, events copied out on rescue.
+    {
+        const uint64_t encodes = rt.fanout_encodes.load();
+        auto d = delta(30, 25);
+        add_damage(d.mutable_delta_snapshot()->mutable_events(), 30, 4);
+        auto shared = t2d::mm::encode_shared(d);
+        assert(shared && rt.fanout_encodes.load() == encodes + 1);
+        OutboundLanes a;
+        OutboundLanes b;
+        a.push(shared, t0).last_input_tick = 9;
+        b.push(shared, t0);
+        a.push(delta(31, 25), t0 + 1ms); // never folded into a shared entry
+        assert(a.size(OutboundLane::State) == 2);
+        a.push(t2d::mm::encode_shared(full(32)), t0 + 2ms);
+        std::vector<t2d::mm::OutboundMessage> out;
+        a.drain(out, t0 + 3ms, [](OutboundLane, uint64_t) {});
+        assert(out.size() == 2 && out[0].msg.has_tick_events() && out[0].msg.tick_events().server_tick() == 30);
+        assert(out[1].shared && out[1].message().snapshot().server_tick() == 32);
+        assert(shared->msg.delta_snapshot().has_events()); // the shared copy is untouched
+        out.clear();
+        b.drain(out, t0 + 3ms, [](OutboundLane, uint64_t) {});
+        assert(out.size() == 1 && out[0].shared == shared && out[0].last_input_tick == 0);
+        (void)encodes;
+    }
+
+    // The stamp suffix merges into the shared body when parsed (full and delta snapshots, multi-byte varint).
+    {
+        for (const auto &msg : {full(40), delta(41, 40)}) {
+            auto enc = t2d::mm::encode_shared(msg);
+            std::string wire = enc->body;
+            t2d::mm::append_last_input_tick(msg, 300000, wire);
+            t2d::ServerMessage parsed;
+            const bool ok = parsed.ParseFromString(wire);
+            assert(ok);
+            const uint32_t stamped = msg.has_snapshot() ? parsed.snapshot().last_input_tick()
+                                                        : parsed.delta_snapshot().last_input_tick();
+            const uint32_t tick =
+                msg.has_snapshot() ? parsed.snapshot().server_tick() : parsed.delta_snapshot().base_tick();
+            assert(stamped == 300000 && tick == 40);
+            (void)tick;
+            (void)stamped;
+            (void)ok;
+        }
+    }
+
+    // Typed wire form: the shared frame is a leading fragment (RLE for large snapshots), the stamp its final fragment.
+    {
+        auto big = full(50);
+        for (uint32_t i = 1; i <= 200; ++i)
+            big.mutable_snapshot()->add_tanks()->set_entity_id(i);
+        auto enc = t2d::mm::encode_shared(big);
+        assert(static_cast<uint8_t>(enc->typed[5]) & t2d::netutil::FRAME_FLAG_MORE);
+        std::string tail;
+        t2d::netutil::append_frame_header(t2d::netutil::FrameHeader{t2d::netutil::FrameType::ServerMessage}, tail);
+        t2d::mm::append_last_input_tick(big, 12, tail);
+        t2d::netutil::FrameDecoder dec;
+        t2d::netutil::FrameType type{};
+        const char *body = nullptr;
+        size_t body_len = 0;
+        auto st = dec.decode(enc->typed.data() + 4, enc->typed.size() - 4, type, body, body_len);
+        assert(st == t2d::netutil::FrameStatus::Partial);
+        st = dec.decode(tail.data(), tail.size(), type, body, body_len);
+        assert(st == t2d::netutil::FrameStatus::Ready && type == t2d::netutil::FrameType::ServerMessage);
+        t2d::ServerMessage parsed;
+        const bool ok = parsed.ParseFromArray(body, static_cast<int>(body_len));
+        assert(ok && parsed.snapshot().tanks_size() == 200 && parsed.snapshot().last_input_tick() == 12);
+        (void)st;
+        (void)ok;
+    }
+    std::cout << "unit_outbound_lanes OK" << std::endl;
+    return 0;
+}
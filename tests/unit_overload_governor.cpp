@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+// Overload governor: escalation one level per hot window up to max_level, hysteresis (band holds, recovery needs
+// consecutive calm windows), sparse windows ignored, time-at-level accounting and the cumulative degradation table.
+#include "server/game/overload_governor.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+
+using t2d::game::GovernorConfig;
+using t2d::game::OverloadGovernor;
+using namespace std::chrono_literals;
+
+namespace {
+
+using clock_t_ = std::chrono::steady_clock;
+
+// One window of `ticks` ticks costing `tick_us` each, closed through record_tick at the window end.
+uint32_t run_window(OverloadGovernor &gov, clock_t_::time_point &now, uint64_t tick_us, int ticks = 60)
+{
+    for (int i = 0; i < ticks - 1; ++i)
+        gov.record_tick(tick_us * 1000, now);
+    now += 1000ms;
+    gov.record_tick(tick_us * 1000, now);
+    return gov.level();
+}
+
+} // namespace
+
+int main()
+{
+    GovernorConfig cfg;
+    cfg.enabled = true; // budget 5 ms, escalate > 80% (4 ms), recover < 50% (2.5 ms), 3 calm windows
+    auto now = clock_t_::time_point{} + 10s;
+    OverloadGovernor gov;
+    gov.configure(cfg, now);
+    assert(gov.level() == 0);
+
+    // Calm and sparse windows keep level 0.
+    assert(run_window(gov, now, 1000) == 0);
+    assert(run_window(gov, now, 9000, 5) == 0);
+
+    // Sustained pressure: one level per window, capped at max_level.
+    for (uint32_t expect = 1; expect <= 4; ++expect)
+        assert(run_window(gov, now, 4500) == expect);
+    assert(run_window(gov, now, 12000) == 4);
+    assert(gov.stats(now).last_p95_us >= 9000); // overflow bucket reads as 2x budget
+    assert(gov.current().crate_pos_eps > 0.04f && gov.current().ai_stride == 3);
+
+    // A few slow ticks below the 95th percentile do not count.
+    {
+        for (int i = 0; i < 97; ++i)
+            gov.record_tick(3'000'000, now);
+        for (int i = 0; i < 3; ++i)
+            gov.record_tick(20'000'000, now);
+        now += 1s;
+        assert(gov.evaluate(now) == 4); // p95 ~3 ms: inside the band, holds
+    }
+
+    // Recovery: calm windows counted only when consecutive; a band window resets the count.
+    assert(run_window(gov, now, 1000) == 4);
+    assert(run_window(gov, now, 1000) == 4);
+    assert(run_window(gov, now, 3000) == 4);
+    assert(run_window(gov, now, 1000) == 4);
+    assert(run_window(gov, now, 1000) == 4);
+    assert(run_window(gov, now, 1000) == 3);
+    for (int i = 0; i < 9; ++i)
+        run_window(gov, now, 1000);
+    assert(gov.level() == 0);
+
+    auto st = gov.stats(now);
+    assert(st.escalations == 4 && st.recoveries == 4);
+    // Level 4 from its escalation through 7 more windows before the first recovery; levels 1..3 one window each on
+    // the way up and three each on the way down.
+    assert(st.time_at_level_ms[4] == 8000);
+    assert(st.time_at_level_ms[1] == 4000 && st.time_at_level_ms[3] == 4000);
+    now += 2500ms;
+    assert(gov.stats(now).time_at_level_ms[0] == st.time_at_level_ms[0] + 2500); // running stretch included
+    (void)st;
+
+    // Profiles are cumulative.
+    for (uint32_t lv = 1; lv < OverloadGovernor::kLevels; ++lv) {
+        const auto &prev = OverloadGovernor::degradation(lv - 1);
+        const auto &cur = OverloadGovernor::degradation(lv);
+        assert(cur.snapshot_interval_mult >= prev.snapshot_interval_mult && cur.ai_stride >= prev.ai_stride);
+        assert(cur.interest_distance_scale <= prev.interest_distance_scale);
+        assert(cur.crate_pos_eps >= prev.crate_pos_eps);
+        (void)prev;
+        (void)cur;
+    }
+
+    // max_level caps the ladder; disabled governors ignore samples.
+    cfg.max_level = 1;
+    gov.configure(cfg, now);
+    for (int i = 0; i < 3; ++i)
+        run_window(gov, now, 9000);
+    assert(gov.level() == 1);
+    cfg.enabled = false;
+    gov.configure(cfg, now);
+    run_window(gov, now, 9000);
+    assert(gov.level() == 0 && !gov.enabled());
+
+    std::cout << "unit_overload_governor OK" << std::endl;
+    return 0;
+}
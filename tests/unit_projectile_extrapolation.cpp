@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+// Unit test: ballistic samples reproduce the server's fixed-step integration exactly enough that no re-sample is
+// needed in free flight, while a bounce (velocity change) or a blocked hit (position stall) triggers one.
+#include "common/projectile_extrapolation.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using t2d::proj::Ballistic;
+using t2d::proj::diverged;
+using t2d::proj::extrapolate;
+
+int main()
+{
+    const float dt = 1.f / 60.f;
+    const float pos_tol = 0.05f;
+    const float vel_tol = 0.05f;
+    // Free flight: integrate like the physics step (x += v * dt per tick) for the full 5 s lifetime.
+    Ballistic b{1.f, -2.f, 12.f, 5.f, 100};
+    float x = b.x;
+    float y = b.y;
+    for (uint32_t tick = 101; tick <= 400; ++tick) {
+        x += b.vx * dt;
+        y += b.vy * dt;
+        assert(!diverged(b, tick, dt, x, y, b.vx, b.vy, pos_tol, vel_tol));
+    }
+    float ex = 0.f;
+    float ey = 0.f;
+    extrapolate(b, 400, dt, ex, ey);
+    assert(std::fabs(ex - x) < 1e-3f && std::fabs(ey - y) < 1e-3f);
+    // Ticks before the sample clamp to the sample itself.
+    extrapolate(b, 50, dt, ex, ey);
+    assert(ex == b.x && ey == b.y);
+
+    // Ricochet: velocity reflected on tick 201 -> re-sample required.
+    assert(diverged(b, 201, dt, x, y, -b.vx, b.vy, pos_tol, vel_tol));
+    // Blocked (non-penetrating) hit that only stalls the position also shows up.
+    extrapolate(b, 201, dt, ex, ey);
+    assert(diverged(b, 202, dt, ex, ey, b.vx, b.vy, pos_tol, vel_tol));
+
+    // After re-sampling, extrapolation continues from the new sample.
+    Ballistic r{ex, ey, -b.vx, b.vy, 201};
+    extrapolate(r, 231, dt, x, y);
+    assert(std::fabs(x - (ex - b.vx * 0.5f)) < 1e-4f && std::fabs(y - (ey + b.vy * 0.5f)) < 1e-4f);
+
+    std::cout << "unit_projectile_extrapolation OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: Apache-2.0
+// atan2-free orientation math: angles from (cos, sin) match std::atan2 within the replication thresholds over the
+// whole circle (octant edges, axes, non-unit vectors), relative angles need no wrap-around and the fire cone test
+// agrees with the angle test.
+#include "common/rot_angle.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+using namespace t2d::math;
+
+int main()
+{
+    // Whole circle in 0.01 degree steps: error well below the 0.01 degree delta threshold.
+    float max_err_deg = 0.f;
+    for (int i = -18000; i <= 18000; ++i) {
+        const double a = i * 0.01 * M_PI / 180.0;
+        const float c = static_cast<float>(std::cos(a));
+        const float s = static_cast<float>(std::sin(a));
+        const float exact = static_cast<float>(std::atan2(s, c) * 180.0 / M_PI);
+        float err = std::fabs(vec_deg(c, s) - exact);
+        err = std::min(err, 360.f - err); // +-180 are the same orientation
+        max_err_deg = std::max(max_err_deg, err);
+        // Non-unit vectors (target directions) give the same angle.
+        assert(std::fabs(vec_rad(7.5f * c, 7.5f * s) - vec_rad(c, s)) < 1e-5f);
+    }
+    assert(max_err_deg < 0.002f);
+    // Axes and range convention (-180, 180].
+    assert(vec_deg(1.f, 0.f) == 0.f && std::fabs(vec_deg(0.f, 1.f) - 90.f) < 1e-4f);
+    assert(std::fabs(vec_deg(-1.f, 0.f) - 180.f) < 1e-4f && std::fabs(vec_deg(0.f, -1.f) + 90.f) < 1e-4f);
+    assert(vec_rad(0.f, 0.f) == 0.f);
+
+    // Relative angle across the +-180 seam: 170 -> -170 degrees is +20, not -340.
+    {
+        const float a = 170.f * kPi / 180.f;
+        const float b = -170.f * kPi / 180.f;
+        const float d = rot_diff_rad(std::cos(a), std::sin(a), std::cos(b), std::sin(b)) * kRadToDeg;
+        assert(std::fabs(d - 20.f) < 0.01f);
+        (void)d;
+    }
+
+    // Fire cone: within 10 degrees of the heading, either side, any distance; never behind.
+    {
+        const float cos10 = 0.98480775f;
+        const float h = 30.f * kPi / 180.f;
+        const float c = std::cos(h);
+        const float s = std::sin(h);
+        for (int deg = -40; deg <= 40; ++deg) {
+            const float t = h + deg * kPi / 180.f;
+            const bool in = within_cone(c, s, 25.f * std::cos(t), 25.f * std::sin(t), cos10);
+            assert(in == (std::abs(deg) < 10) || std::abs(deg) == 10);
+            (void)in;
+        }
+        assert(!within_cone(c, s, -c, -s, cos10));
+    }
+
+    (void)max_err_deg;
+    std::cout << "unit_rot_angle OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+// Unit test: io_uring send chain bookkeeping. A chain is split into linked segments, every completion is checked
+// against its segment length, a short send resumes from the first unsent byte (the cancelled rest is sent again, in
+// order) and failures or sends that make no progress are reported once.
+#include "server/net/send_chain.hpp"
+
+#include <cassert>
+#include <cerrno>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using t2d::net::SendChain;
+using Completion = SendChain::Completion;
+
+namespace {
+
+struct Sqe
+{
+    const char *data;
+    size_t len;
+    bool linked;
+};
+
+std::vector<Sqe> submit(SendChain &chain, size_t segment)
+{
+    std::vector<Sqe> sqes;
+    chain.submit(segment, [&](const char *data, size_t len, bool linked) { sqes.push_back({data, len, linked}); });
+    return sqes;
+}
+
+} // namespace
+
+int main()
+{
+    std::string stream(250, '\0');
+    for (size_t i = 0; i < stream.size(); ++i)
+        stream[i] = static_cast<char>(i);
+
+    // Full writes: 250 bytes in 100-byte segments, linked except for the last one.
+    {
+        SendChain chain;
+        std::string pending = stream;
+        chain.start(pending);
+        assert(pending.empty());
+        auto sqes = submit(chain, 100);
+        assert(sqes.size() == 3);
+        assert(sqes[0].len == 100 && sqes[1].len == 100 && sqes[2].len == 50);
+        assert(sqes[0].linked && sqes[1].linked && !sqes[2].linked);
+        assert(!chain.idle());
+        assert(chain.complete(100) == Completion::InFlight);
+        assert(chain.complete(100) == Completion::InFlight);
+        assert(chain.complete(50) == Completion::Done);
+        assert(chain.idle() && chain.empty());
+    }
+
+    // Short send in the middle: the linked rest is cancelled, the chain resumes at the first unsent byte and the
+    // bytes written across both chains are the original stream.
+    {
+        SendChain chain;
+        std::string pending = stream;
+        chain.start(pending);
+        auto sqes = submit(chain, 100);
+        std::string wire(sqes[0].data, 100);
+        wire.append(sqes[1].data, 30); // the second segment only got 30 bytes out
+        assert(chain.complete(100) == Completion::InFlight);
+        assert(chain.complete(30) == Completion::InFlight);
+        assert(chain.complete(-ECANCELED) == Completion::Resume);
+        assert(chain.idle() && !chain.empty());
+
+        auto rest = submit(chain, 100);
+        assert(rest.size() == 2);
+        assert(rest[0].len == 100 && rest[0].linked && rest[1].len == 20 && !rest[1].linked);
+        for (const auto &s : rest)
+            wire.append(s.data, s.len);
+        assert(wire == stream);
+        assert(chain.complete(100) == Completion::InFlight);
+        assert(chain.complete(20) == Completion::Done);
+
+        // The chain's buffer is handed back to the next start(), keeping its capacity.
+        pending = "next";
+        chain.start(pending);
+        assert(pending.empty());
+        auto next = submit(chain, 100);
+        assert(next.size() == 1 && std::string(next[0].data, next[0].len) == "next");
+        assert(chain.complete(4) == Completion::Done);
+    }
+
+    // Short last segment of a single-segment chain.
+    {
+        SendChain chain;
+        std::string pending = stream.substr(0, 80);
+        chain.start(pending);
+        submit(chain, 100);
+        assert(chain.complete(79) == Completion::Resume);
+        auto rest = submit(chain, 100);
+        assert(rest.size() == 1 && rest[0].len == 1 && rest[0].data[0] == stream[79]);
+        assert(chain.complete(1) == Completion::Done);
+    }
+
+    // Errors and zero-byte sends fail once; the cancelled rest only drains the chain.
+    {
+        SendChain chain;
+        std::string pending = stream;
+        chain.start(pending);
+        submit(chain, 100);
+        assert(chain.complete(-EPIPE) == Completion::Failed);
+        assert(chain.complete(-ECANCELED) == Completion::InFlight);
+        assert(!chain.idle());
+        chain.complete(-ECANCELED);
+        assert(chain.idle());
+
+        std::string again = "x";
+        chain.start(again);
+        submit(chain, 100);
+        assert(chain.complete(0) == Completion::Failed);
+        assert(chain.idle());
+    }
+
+    // A send that went out behind a stopped one leaves a gap in the stream: failed, never resumed.
+    {
+        SendChain chain;
+        std::string pending = stream;
+        chain.start(pending);
+        submit(chain, 100);
+        assert(chain.complete(60) == Completion::InFlight);
+        assert(chain.complete(100) == Completion::Failed);
+        chain.complete(-ECANCELED);
+        assert(chain.idle());
+    }
+
+    // reset() drops the buffer of a released connection.
+    {
+        SendChain chain;
+        std::string pending = stream;
+        chain.start(pending);
+        submit(chain, 100);
+        chain.reset();
+        assert(chain.idle() && chain.empty());
+    }
+
+    std::cout << "unit_send_chain OK" << std::endl;
+    return 0;
+}
@@ -12,7 +12,7 @@
 // Simple client-side apply of delta semantics matching current server implementation:
 // - Base full snapshot provides complete tank/projectile sets (alive only)
 // - Delta lists changed/new tanks (alive only), a list of removed ids (tanks/projectiles),
-//   and currently (prototype) sends ALL active projectiles each delta.
+//   and spawned / re-sampled projectiles (ballistic samples; untouched ones are extrapolated client-side).
 // - Removed entities are applied before upserting changed ones.
 // NOTE: This logic lives only in the test until an actual client sync module exists.
 
@@ -60,8 +60,7 @@ static void apply_delta(t2d::StateSnapshot &base, const t2d::DeltaSnapshot &delt
             }
         }
     }
-    // Projectiles: server sends all active projectiles each delta (prototype); treat message list as authoritative set
-    // after removals
+    // Projectiles: delta lists spawned / re-sampled projectiles only; upsert by id after removals
     if (!delta.projectiles().empty()) {
         // Build map existing
         std::unordered_map<uint32_t, t2d::ProjectileState *> idx;
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+// Loopback test: the low-latency socket profile sets its options and removes the Nagle / delayed-ACK stall for a
+// tick that leaves as two small writes (events, then snapshot) followed by waiting for the peer. Prints the
+// send-to-receive round trip with and without the profile.
+#include "server/net/socket_profile.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using t2d::net::apply_socket_profile;
+using t2d::net::SocketProfile;
+
+static constexpr int kRounds = 30;
+static constexpr size_t kPart = 40; // bytes per write (small event / delta frame)
+
+static bool read_exact(int fd, char *buf, size_t n)
+{
+    size_t got = 0;
+    while (got < n) {
+        ssize_t r = ::recv(fd, buf + got, n - got, 0);
+        if (r <= 0)
+            return false;
+        got += static_cast<size_t>(r);
+    }
+    return true;
+}
+
+// Median round trip (microseconds) of write(kPart) + write(kPart) -> peer replies 1 byte once both arrived.
+static int64_t measure(bool with_profile)
+{
+    int lfd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(lfd >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0; // ephemeral
+    int rc = ::bind(lfd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    assert(rc == 0);
+    rc = ::listen(lfd, 1);
+    assert(rc == 0);
+    socklen_t alen = sizeof(addr);
+    rc = ::getsockname(lfd, reinterpret_cast<sockaddr *>(&addr), &alen);
+    assert(rc == 0);
+
+    std::thread peer([lfd] {
+        int fd = ::accept(lfd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        char buf[2 * kPart];
+        for (int i = 0; i < kRounds; ++i) {
+            if (!read_exact(fd, buf, sizeof(buf)))
+                break;
+            char ack = 'k';
+            ::send(fd, &ack, 1, 0);
+        }
+        ::close(fd);
+    });
+
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(fd >= 0);
+    rc = ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    assert(rc == 0);
+    if (with_profile) {
+        SocketProfile p;
+        p.sndbuf = 256 * 1024;
+        p.rcvbuf = 256 * 1024;
+        int failed = apply_socket_profile(fd, p);
+        assert(failed == 0);
+        (void)failed;
+        int v = 0;
+        socklen_t vl = sizeof(v);
+        ::getsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &v, &vl);
+        assert(v == 1);
+        vl = sizeof(v);
+        ::getsockopt(fd, SOL_SOCKET, SO_SNDBUF, &v, &vl);
+        assert(v >= 256 * 1024); // kernel doubles the requested size
+#ifdef TCP_NOTSENT_LOWAT
+        vl = sizeof(v);
+        ::getsockopt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &v, &vl);
+        assert(v == p.notsent_lowat);
+#endif
+    }
+    std::vector<int64_t> samples;
+    char part[kPart] = {};
+    for (int i = 0; i < kRounds; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        ::send(fd, part, sizeof(part), 0);
+        ::send(fd, part, sizeof(part), 0);
+        char ack = 0;
+        bool ok = read_exact(fd, &ack, 1);
+        assert(ok && ack == 'k');
+        (void)ok;
+        samples.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count());
+    }
+    ::close(fd);
+    peer.join();
+    ::close(lfd);
+    (void)rc;
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main()
+{
+    int64_t nagle_us = measure(false);
+    int64_t profile_us = measure(true);
+    std::cout << "loopback two-write round trip p50: default=" << nagle_us << "us profile=" << profile_us << "us"
+              << std::endl;
+    // Default sockets pay the delayed-ACK stall (~40ms on Linux) once quick-ack mode ends; the profile never should.
+    // Only assert the direction with generous slack so a loaded CI box cannot flake.
+    assert(profile_us <= nagle_us + 2000);
+    assert(profile_us < 20000);
+    std::cout << "unit_socket_profile OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// Thread profile: CPU list parsing, applying a role to a thread (name + affinity) and reading per-thread scheduler
+// statistics back from /proc.
+#include "server/runtime/thread_profile.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+
+using t2d::runtime::ThreadProfile;
+using t2d::runtime::ThreadRole;
+
+int main()
+{
+    cpu_set_t set;
+    bool ok = t2d::runtime::parse_cpu_list("0-2, 5,7-7", set);
+    assert(ok && CPU_COUNT(&set) == 5);
+    assert(CPU_ISSET(0, &set) && CPU_ISSET(2, &set) && CPU_ISSET(5, &set) && CPU_ISSET(7, &set));
+    assert(!CPU_ISSET(3, &set));
+    assert(!t2d::runtime::parse_cpu_list("", set));
+    assert(!t2d::runtime::parse_cpu_list("3-1", set));
+    assert(!t2d::runtime::parse_cpu_list("a", set));
+    assert(!t2d::runtime::parse_cpu_list("1,2x", set));
+    assert(!t2d::runtime::parse_cpu_list("99999", set));
+    assert(CPU_COUNT(&set) == 5); // failed parses leave the set untouched
+
+    // Pin a worker to the first CPU this process may use.
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    int rc = sched_getaffinity(0, sizeof(allowed), &allowed);
+    assert(rc == 0);
+    int first = 0;
+    while (!CPU_ISSET(first, &allowed))
+        ++first;
+    ThreadProfile profile;
+    profile.sim_cpus = std::to_string(first);
+    assert(profile.any() && !ThreadProfile{}.any());
+
+    int failed = -1;
+    bool pinned = false;
+    std::thread worker([&] {
+        failed = t2d::runtime::apply_current_thread(ThreadRole::Simulation, profile, "t2d-sim-test");
+        cpu_set_t now;
+        CPU_ZERO(&now);
+        pthread_getaffinity_np(pthread_self(), sizeof(now), &now);
+        pinned = CPU_COUNT(&now) == 1 && CPU_ISSET(first, &now);
+        bool seen = false;
+        for (const auto &st : t2d::runtime::collect_thread_stats()) {
+            if (st.name == "t2d-sim-test") {
+                seen = true;
+                assert(st.tid > 0 && st.last_cpu == first);
+            }
+        }
+        assert(seen);
+        (void)seen;
+    });
+    worker.join();
+    assert(failed == 0 && pinned);
+
+    // Invalid list: counted as a failure, thread keeps running unpinned.
+    profile.net_cpus = "x";
+    std::thread bad([&] { failed = t2d::runtime::apply_current_thread(ThreadRole::Network, profile, "t2d-io-test"); });
+    bad.join();
+    assert(failed == 1);
+
+    // Naming a thread from outside (logger writer path).
+    std::thread idle([] { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+    profile.logger_cpus.clear();
+    failed = t2d::runtime::apply_thread(idle, ThreadRole::Logger, profile, "t2d-log-test");
+    bool named = false;
+    for (const auto &st : t2d::runtime::collect_thread_stats())
+        named = named || st.name == "t2d-log-test";
+    idle.join();
+    assert(failed == 0 && named);
+
+    auto stats = t2d::runtime::collect_thread_stats();
+    assert(!stats.empty());
+    (void)ok;
+    (void)rc;
+    (void)named;
+    std::cout << "unit_thread_profile OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+// Tick phase sampling: wall time always reaches the per-phase totals; hardware events only when enabled and the
+// PMU is reachable (containers usually have none, which must degrade to wall time only, not fail).
+#include "common/metrics.hpp"
+#include "server/game/tick_perf.hpp"
+
+#include <cassert>
+#include <iostream>
+
+using t2d::game::TickPerfSampler;
+using t2d::game::TickPhase;
+
+namespace {
+
+uint64_t busy(int n)
+{
+    volatile uint64_t sink = 0;
+    for (int i = 0; i < n; ++i)
+        sink = sink + static_cast<uint64_t>(i) * 3;
+    return sink;
+}
+
+} // namespace
+
+int main()
+{
+    auto &rt = t2d::metrics::runtime();
+    const std::array<uint32_t, t2d::game::kTickPhases> phase_ns{100, 2000, 30, 400, 5};
+
+    // Disabled: wall time only.
+    t2d::game::configure_tick_perf(false);
+    TickPerfSampler off;
+    off.begin();
+    assert(!off.sampling());
+    off.mark(TickPhase::Input);
+    off.commit(phase_ns);
+    assert(rt.tick_phase_samples.load() == 1);
+    assert(rt.tick_phase_ns[static_cast<size_t>(TickPhase::Physics)].load() == 2000);
+    assert(rt.tick_phase_event_samples.load() == 0 && rt.tick_perf_threads.load() == 0);
+
+    // Enabled: the physics phase does all the work, so it gets the instructions when the counters open.
+    t2d::game::configure_tick_perf(true);
+    TickPerfSampler on;
+    for (int tick = 0; tick < 3; ++tick) {
+        on.begin();
+        on.mark(TickPhase::Input);
+        (void)busy(200'000);
+        on.mark(TickPhase::Physics);
+        on.mark(TickPhase::Contacts);
+        on.mark(TickPhase::Snapshot);
+        on.mark(TickPhase::Events);
+        on.commit(phase_ns);
+        assert(!on.sampling()); // reset for the next tick
+    }
+    assert(rt.tick_phase_samples.load() == 4);
+    assert(rt.tick_phase_ns[static_cast<size_t>(TickPhase::Input)].load() == 400);
+    const uint64_t mask = rt.tick_perf_event_mask.load();
+    if (rt.tick_perf_threads.load() == 0) {
+        assert(mask == 0 && rt.tick_phase_event_samples.load() == 0);
+    } else {
+        assert(rt.tick_perf_threads.load() == 1); // one group for this thread, reused across ticks
+        assert(rt.tick_phase_event_samples.load() <= 3);
+        if (rt.tick_phase_event_samples.load() > 0 && (mask & 2)) {
+            const uint64_t physics = rt.tick_phase_events[static_cast<size_t>(TickPhase::Physics)][1].load();
+            const uint64_t contacts = rt.tick_phase_events[static_cast<size_t>(TickPhase::Contacts)][1].load();
+            assert(physics > 200'000 && physics > contacts);
+            (void)physics;
+            (void)contacts;
+        }
+    }
+    (void)mask;
+    std::cout << "unit_tick_perf OK" << std::endl;
+    return 0;
+}